@@ -8,11 +8,6 @@
 
 int main(int ac, char* av[])
 {
-	//create a logger instance
-	Logger LoggerInst;
-	//log everything
-	LoggerInst.logLevel = L_DEBUG;
-
 	std::cout << R"(
    ______              ___       __            __           
   / ____/__    __     /   | ____/ /___ _____  / /____  _____
@@ -24,8 +19,14 @@ int main(int ac, char* av[])
 	string adapterAddress;
 	string registerAddress;
 	string mmuPath;
-	int workerCount = 4;
+	ServerSettings serverSettings;
+	string serverType = "threadpool";
+	string transport = "buffered";
+	string protocol = "compact";
 	int logLevel=2;
+	int metricsInterval = 0;
+	int serviceConnections = static_cast<int>(ServicePoolSettings::maxConnections);
+	int serviceThreads = ServiceCallExecutor::threadCount;
 
 
 	try {
@@ -35,13 +36,35 @@ int main(int ac, char* av[])
 			("address,a", po::value<string>(&adapterAddress)->required(), "The address of the adapters tcp server")
 			("raddress,r", po::value<string>(&registerAddress)->required(), "The address of the register which holds the central information.")
 			("mmupath,m", po::value<string>(&mmuPath)->required(), "The path of the mmu folder.")
-			("threads,t", po::value<int>(&workerCount), "The Number of worker threads for the server");
+			("server,s", po::value<string>(&serverType), "The server engine: threadpool (one worker thread per connection) or nonblocking (requires framed transport on the clients)")
+			("iothreads,i", po::value<int>(&serverSettings.ioThreadCount), "The number of IO threads of the nonblocking server, default: half of the hardware threads")
+			("transport", po::value<string>(&transport), "The thrift transport of the server: buffered, framed or header, the nonblocking server always uses framed")
+			("protocol", po::value<string>(&protocol), "The thrift protocol of the server: compact or binary")
+			("metrics", po::value<int>(&metricsInterval), "Logs the call statistics every given number of seconds, default: disabled (the statistics are always available via GetStatus)")
+			("stepthreads", po::value<int>(&serverSettings.stepThreadCount), "The number of threads which step the MMUs of independent avatars in parallel, default: the hardware threads")
+			("sessiontimeout", po::value<int>(&serverSettings.sessionTimeout), "Removes sessions which are unused for the given number of seconds and disposes their MMUs, default: disabled")
+			("serviceconnections", po::value<int>(&serviceConnections), "The maximum number of connections the MMUs share per service, default: 8")
+			("servicethreads", po::value<int>(&serviceThreads), "The number of threads which execute the asynchronous service calls of the MMUs, default: 4")
+			("collisionport", po::value<int>(&serverSettings.collisionPort), "Serves the local collision detection at the given port of the adapter address and registers it as collision detection service, default: disabled")
+			("threads,t", po::value<int>(&serverSettings.workerCount), "The Number of worker threads for the server")
 			("debug,d", po::value<int>(&logLevel), "The log level 0:SILENT, 1: ERROR, 2: INFO, 3: DEBUG");
 
 		po::variables_map vm;
 		po::store(po::parse_command_line(ac, av, desc), vm);
 		po::notify(vm);
 
+		if (!ServerSettings::ParseType(serverSettings.type, serverType))
+		{
+			cout << "Unknown server engine: " << serverType << endl;
+			return 0;
+		}
+
+		if (!TransportSettings::ParseTransport(serverSettings.transport.transport, transport) || !TransportSettings::ParseProtocol(serverSettings.transport.protocol, protocol))
+		{
+			cout << "Unknown transport or protocol: " << transport << ", " << protocol << endl;
+			return 0;
+		}
+
 		////does not work because of required 
 		//if (vm.count("help")) {
 		//	std::cout << desc << "\n";
@@ -54,7 +77,7 @@ int main(int ac, char* av[])
 		return 0;
 	}
 
-	/*switch (logLevel) {
+	switch (logLevel) {
 		case 0: Logger::logLevel = L_SILENT;
 			break;
 		case 1: Logger::logLevel = L_ERROR;
@@ -63,8 +86,11 @@ int main(int ac, char* av[])
 			break;
 		case 3: Logger::logLevel = L_DEBUG;
 			break;
-	}*/
+	}
 	
+	ServicePoolSettings::maxConnections = static_cast<size_t>(max(serviceConnections, 1));
+	ServiceCallExecutor::threadCount = max(serviceThreads, 1);
+
 	vector<string> adapterAddressSplit;
 	vector<string> registerAddressSplit;
 	boost::split(adapterAddressSplit, adapterAddress, boost::is_any_of(":"));
@@ -83,6 +109,7 @@ int main(int ac, char* av[])
 	cout << ("Adapter is reachable at: ") << adapterMIPAddress.Address << (":") << adapterMIPAddress.Port << std::endl;
 	cout << ("Register is reachable at: ") << registerMIPAddress.Address << (":") << registerMIPAddress.Port << std::endl;
 	cout << ("MMUs will be loaded from: ") << mmuPath << std::endl;
+	cout << ("Server engine: ") << serverType << (" with ") << serverSettings.workerCount << (" worker threads, ") << transport << (" transport, ") << protocol << (" protocol") << std::endl;
 	cout << ("_________________________________________________________________") << std::endl;
 
 	MAdapterDescription adapterDescription = MAdapterDescription{};
@@ -98,8 +125,11 @@ int main(int ac, char* av[])
 	
 	//start the adapter controller
 	CPPMMUInstantiator Instantiator = CPPMMUInstantiator{};
-	AdapterController adapterController{ adapterMIPAddress,registerMIPAddress,mmuPath, workerCount,Instantiator, vector<string>{"C++"}, adapterDescription};
+	AdapterController adapterController{ adapterMIPAddress,registerMIPAddress,mmuPath, serverSettings,Instantiator, vector<string>{"C++"}, adapterDescription};
+	RpcMetrics::StartDump(metricsInterval);
 	adapterController.Start();
+	RpcMetrics::StopDump();
+	Logger::flush();
 
 	return 0;
 }
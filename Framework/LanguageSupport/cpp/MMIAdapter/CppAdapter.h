@@ -10,11 +10,13 @@
 #include <iostream>
 #include "Adapter/SessionTools.h"
 #include "Access/ServiceAccess.h"
+#include "Access/ServiceCallExecutor.h"
 #include "Utils/Logger.h"
 #include "boost/exception/diagnostic_information.hpp"
 #include "gen-cpp/mmu_types.h"
 #include "Adapter/CPPMMUInstantiator.h"
 #include "Adapter/SessionData.h"
+#include "Adapter/RpcMetrics.h"
 
 using namespace MMIStandard;
 namespace po = boost::program_options;
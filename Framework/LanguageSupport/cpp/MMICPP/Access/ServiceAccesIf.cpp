@@ -3,8 +3,41 @@
 // Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
 
 #include "ServiceAccesIf.h"
+#include "ServiceCallExecutor.h"
 
 
 ServiceAccessIf::~ServiceAccessIf()
 {
 }
+
+future<MAvatarPostureValues> ServiceAccessIf::computeIKAsync(const MAvatarPostureValues & postureValues, const vector<MIKProperty>& properties)
+{
+	return ServiceCallExecutor::Call<MAvatarPostureValues>(this->getIkServicePool(), [postureValues, properties](MInverseKinematicsServiceClient &client, MAvatarPostureValues &_return)
+	{
+		client.ComputeIK(_return, postureValues, properties);
+	});
+}
+
+future<MIKServiceResult> ServiceAccessIf::calculateIKPostureAsync(const MAvatarPostureValues & postureValues, const vector<MConstraint>& constraints, const map<string, string>& properties)
+{
+	return ServiceCallExecutor::Call<MIKServiceResult>(this->getIkServicePool(), [postureValues, constraints, properties](MInverseKinematicsServiceClient &client, MIKServiceResult &_return)
+	{
+		client.CalculateIKPosture(_return, postureValues, constraints, properties);
+	});
+}
+
+future<MVector3> ServiceAccessIf::computePenetrationAsync(const MCollider & colliderA, const MTransform & transformA, const MCollider & colliderB, const MTransform & transformB)
+{
+	return ServiceCallExecutor::Call<MVector3>(this->getCollisionDetectionServicePool(), [colliderA, transformA, colliderB, transformB](MCollisionDetectionServiceClient &client, MVector3 &_return)
+	{
+		client.ComputePenetration(_return, colliderA, transformA, colliderB, transformB);
+	});
+}
+
+future<vector<MGeometryConstraint>> ServiceAccessIf::getGraspPosesAsync(const MAvatarPostureValues & posture, MJointType::type handType, const MSceneObject & sceneObject, bool repositionHand)
+{
+	return ServiceCallExecutor::Call<vector<MGeometryConstraint>>(this->getGraspPoseServicePool(), [posture, handType, sceneObject, repositionHand](MGraspPoseServiceClient &client, vector<MGeometryConstraint> &_return)
+	{
+		client.GetGraspPoses(_return, posture, handType, sceneObject, repositionHand);
+	});
+}
@@ -6,6 +6,8 @@
 #include "gen-cpp/scene_types.h"
 #include "gen-cpp/services_types.h"
 #include "ThriftClient/ThriftClient.h"
+#include "ServiceConnectionPool.h"
+#include <future>
 #include "gen-cpp/MInverseKinematicsService.h"
 #include "gen-cpp/MPathPlanningService.h"
 #include "gen-cpp/MGraspPoseService.h"
@@ -46,6 +48,33 @@ namespace MMIStandard {
 		virtual MCollisionDetectionServiceClient & getCollisionDetectionServicet() = 0;
 		virtual MGraspPoseServiceClient & getGraspPoseService() = 0;
 
+		//	The adapter wide pools of the services, the connections can be used by several MMUs concurrently
+		//	Resolving the pool does not wait for a connection, the connections are checked out with Acquire
+		virtual shared_ptr<ServiceConnectionPool<MInverseKinematicsServiceClient>> getIkServicePool() = 0;
+		virtual shared_ptr<ServiceConnectionPool<MPathPlanningServiceClient>> getPathPlanningServicePool() = 0;
+		virtual shared_ptr<ServiceConnectionPool<MRetargetingServiceClient>> getRetargetingServicePool() = 0;
+		virtual shared_ptr<ServiceConnectionPool<MBlendingServiceClient>> getBlendingServicePool() = 0;
+		virtual shared_ptr<ServiceConnectionPool<MCollisionDetectionServiceClient>> getCollisionDetectionServicePool() = 0;
+		virtual shared_ptr<ServiceConnectionPool<MGraspPoseServiceClient>> getGraspPoseServicePool() = 0;
+
+		//	Check out a connection of the adapter wide pool of the service, the connection is returned once the result is destroyed
+		//	Unlike the getters above, the connections can be used by several MMUs concurrently
+		virtual PooledServiceClient<MInverseKinematicsServiceClient> acquireIkService() = 0;
+		virtual PooledServiceClient<MPathPlanningServiceClient> acquirePathPlanningService() = 0;
+		virtual PooledServiceClient<MRetargetingServiceClient> acquireRetargetingService() = 0;
+		virtual PooledServiceClient<MBlendingServiceClient> acquireBlendingService() = 0;
+		virtual PooledServiceClient<MCollisionDetectionServiceClient> acquireCollisionDetectionService() = 0;
+		virtual PooledServiceClient<MGraspPoseServiceClient> acquireGraspPoseService() = 0;
+
+		//	Asynchronous calls of the services, the calls are executed with pooled connections by the service threads (see ServiceCallExecutor)
+		//	The connections are checked out by the service threads, so the MMU is not blocked while all connections of a pool are in use
+		//	The MMU can continue with its computation and collect the results with get, an exception of the call is thrown by get
+		//	Further calls can be executed with ServiceCallExecutor::Call and the pools above
+		future<MAvatarPostureValues> computeIKAsync(const MAvatarPostureValues &postureValues, const vector<MIKProperty> &properties);
+		future<MIKServiceResult> calculateIKPostureAsync(const MAvatarPostureValues &postureValues, const vector<MConstraint> &constraints, const map<string, string> &properties);
+		future<MVector3> computePenetrationAsync(const MCollider &colliderA, const MTransform &transformA, const MCollider &colliderB, const MTransform &transformB);
+		future<vector<MGeometryConstraint>> getGraspPosesAsync(const MAvatarPostureValues &posture, MJointType::type handType, const MSceneObject &sceneObject, bool repositionHand);
+
 		//	virtual destructor
 		virtual ~ServiceAccessIf();
 	};
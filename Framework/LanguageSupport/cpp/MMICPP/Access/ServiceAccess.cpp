@@ -10,177 +10,78 @@
 #include "gen-cpp/MInverseKinematicsService.h"
 #include "ThriftClient/ThriftClient.cpp"
 #include "Utils/Logger.h"
+#include "ServiceDirectory.h"
 
 ServiceAccess::ServiceAccess(const MIPAddress  &registerAddress, const string &sessionID) : sessionID{ sessionID } {
 	this->mmiRegisterAddress = &registerAddress;
 }
 
 
-MServiceDescription* ServiceAccess::getServiceDescription(const string &serviceName)
+MServiceDescription ServiceAccess::getServiceDescription(const string &serviceName, const string &errorName)
 {
-	unordered_map<string, MServiceDescription>::iterator it = this->serviceDescriptions.find(serviceName);
-	if (it == this->serviceDescriptions.end())
+	MServiceDescription serviceDescription;
+	if (!ServiceDirectory::GetServiceDescription(serviceDescription, *this->mmiRegisterAddress, this->sessionID, serviceName) || serviceDescription.Addresses.empty())
 	{
-		this->initialize();	
-	}
-
-	it = this->serviceDescriptions.find(serviceName);
-	if (it == this->serviceDescriptions.end())
-	{
-		return nullptr;
-	}
-	else
-	{
-		return &it->second;
+		throw std::runtime_error(errorName + "-Service not found");
 	}
+	return serviceDescription;
 }
 
 void ServiceAccess::initialize()
 {
-	Logger::printLog(L_INFO, "Trying to fetch the services from register: " +  this->mmiRegisterAddress->Address + ":" +  std::to_string(this->mmiRegisterAddress->Port) );
+	ServiceDirectory::Refresh(*this->mmiRegisterAddress, this->sessionID);
+}
 
-	try
-	{
-		ThriftClient<MMIRegisterServiceClient> client{ this->mmiRegisterAddress->Address,this->mmiRegisterAddress->Port};
-		client.Start();
-		vector<MServiceDescription> serviceDescriptions;
-		client.access->GetRegisteredServices(serviceDescriptions,this->sessionID);
-	
-		for (MServiceDescription &serviceDescription : serviceDescriptions)
-		{
-			Logger::printLog(L_INFO, "found: " +serviceDescription.Name + " at " + serviceDescription.Addresses[0].Address + ":" + std::to_string(serviceDescription.Addresses[0].Port));
-			unordered_map<string, MServiceDescription>::iterator it = this->serviceDescriptions.find(serviceDescription.Name);
-			if (it == this->serviceDescriptions.end())
-			{
-				this->serviceDescriptions[serviceDescription.Name] = serviceDescription;
-			}
-		}
-	}
-	catch (...)
+template<class T>
+ThriftClient<T>& ServiceAccess::getThriftClient(shared_ptr<ThriftClient<T>>& client, const string & serviceName, const string & errorName)
+{
+	lock_guard<mutex> guard(this->accessLock);
+	if (!client)
 	{
-		Logger::printLog(L_ERROR, "Problem fetching available services from the register.Wrong address ? Server down ? ");
+		MServiceDescription serviceDescription = this->getServiceDescription(serviceName, errorName);
+		client = make_shared<ThriftClient<T>>(serviceDescription.Addresses[0].Address, serviceDescription.Addresses[0].Port, TransportSettings::ReadProperties(serviceDescription.Properties));
 	}
+	client->Start();
+	return *client;
 }
 
- ThriftClient<MInverseKinematicsServiceClient>& ServiceAccess::getIkThriftClient()
+template<class T>
+shared_ptr<ServiceConnectionPool<T>> ServiceAccess::getServicePool(const string & serviceName, const string & errorName)
 {
-	MServiceDescription* serviceDescription = this->getServiceDescription("ikService");
-	
-		if (serviceDescription == nullptr)
-		{
-			throw std::runtime_error("IK-Service not found");
-		}
-		else
-		{
-			if (!this->ikService)
-			{
-				this->ikService = make_shared<ThriftClient<MInverseKinematicsServiceClient>>(serviceDescription->Addresses[0].Address, serviceDescription->Addresses[0].Port);
-			}
-			this->ikService->Start();
-			return *(this->ikService);
-		}
+	MServiceDescription serviceDescription = this->getServiceDescription(serviceName, errorName);
+	return ServiceConnectionPool<T>::Get(serviceDescription.Addresses[0].Address, serviceDescription.Addresses[0].Port, TransportSettings::ReadProperties(serviceDescription.Properties));
 }
 
-ThriftClient<MPathPlanningServiceClient>& ServiceAccess::getPathPlanningThriftClient()
+ThriftClient<MInverseKinematicsServiceClient>& ServiceAccess::getIkThriftClient()
 {
-	MServiceDescription* serviceDescription = this->getServiceDescription("pathPlanningService");
-
-	if (serviceDescription == nullptr)
-	{
-		//cerr << "Problem comuting IK" << endl;
-		throw std::runtime_error("pathPlanning-Service not found");
-	}
-	else
-	{
-		if (!this->ikService)
-		{
-			this->pathPlanningService = make_shared<ThriftClient<MPathPlanningServiceClient>>(serviceDescription->Addresses[0].Address, serviceDescription->Addresses[0].Port);	
-		}
-		this->pathPlanningService->Start();
-		return *(this->pathPlanningService);
-	}
+	return this->getThriftClient(this->ikService, "ikService", "IK");
 }
 
- ThriftClient<MRetargetingServiceClient>& ServiceAccess::getRetargetingThriftClient()
+ThriftClient<MPathPlanningServiceClient>& ServiceAccess::getPathPlanningThriftClient()
 {
-	MServiceDescription* serviceDescription = this->getServiceDescription("retargetingService");
+	return this->getThriftClient(this->pathPlanningService, "pathPlanningService", "pathPlanning");
+}
 
-	if (serviceDescription == nullptr)
-	{
-		//cerr << "Problem comuting IK" << endl;
-		throw std::runtime_error("retargeting-Service not found");
-	}
-	else
-	{
-		if (!this->ikService)
-		{
-			this->retargetingService = make_shared<ThriftClient<MRetargetingServiceClient>>(serviceDescription->Addresses[0].Address, serviceDescription->Addresses[0].Port);
-		}
-		this->retargetingService->Start();
-		return *(this->retargetingService);
-	}
+ThriftClient<MRetargetingServiceClient>& ServiceAccess::getRetargetingThriftClient()
+{
+	return this->getThriftClient(this->retargetingService, "retargetingService", "retargeting");
 }
 
- ThriftClient<MBlendingServiceClient>& ServiceAccess::getBlendingThriftClient()
+ThriftClient<MBlendingServiceClient>& ServiceAccess::getBlendingThriftClient()
 {
 	throw std::runtime_error("Function not implemented yet");
 
-	MServiceDescription* serviceDescription = this->getServiceDescription("blendingService");
-
-	if (serviceDescription == nullptr)
-	{
-		//cerr << "Problem comuting IK" << endl;
-		throw std::runtime_error("blending-Service not found");
-	}
-	else
-	{
-		if (!this->ikService)
-		{
-			this->blendingService = make_shared<ThriftClient<MBlendingServiceClient >>(serviceDescription->Addresses[0].Address, serviceDescription->Addresses[0].Port);		
-		}
-		this->blendingService->Start();
-		return *(this->blendingService);
-	}
+	return this->getThriftClient(this->blendingService, "blendingService", "blending");
 }
 
- ThriftClient<MCollisionDetectionServiceClient>& ServiceAccess::getCollisionDetectionThriftClient()
+ThriftClient<MCollisionDetectionServiceClient>& ServiceAccess::getCollisionDetectionThriftClient()
 {
-	MServiceDescription* serviceDescription = this->getServiceDescription("collisionDetectionService");
-
-	if (serviceDescription == nullptr)
-	{
-		//cerr << "Problem comuting IK" << endl;
-		throw std::runtime_error("collisionDetection-Service not found");
-	}
-	else
-	{
-		if (!this->ikService)
-		{
-			this->collisionDetectionService = make_shared<ThriftClient<MCollisionDetectionServiceClient>>(serviceDescription->Addresses[0].Address, serviceDescription->Addresses[0].Port);
-		}
-		this->collisionDetectionService->Start();
-		return *(this->collisionDetectionService);
-	}
+	return this->getThriftClient(this->collisionDetectionService, "collisionDetectionService", "collisionDetection");
 }
 
 ThriftClient<MGraspPoseServiceClient>& ServiceAccess::getGraspPoseThriftClient()
 {
-	MServiceDescription* serviceDescription = this->getServiceDescription("graspPoseService");
-
-	if (serviceDescription == nullptr)
-	{
-		//cerr << "Problem comuting IK" << endl;
-		throw std::runtime_error("graspPose-Service not found");
-	}
-	else
-	{
-		if (!this->ikService)
-		{
-			this->graspPoseService = make_shared<ThriftClient<MGraspPoseServiceClient>>(serviceDescription->Addresses[0].Address, serviceDescription->Addresses[0].Port);
-		}
-		this->graspPoseService->Start();
-		return *(this->graspPoseService);
-	}
+	return this->getThriftClient(this->graspPoseService, "graspPoseService", "graspPose");
 }
 
 MInverseKinematicsServiceClient & ServiceAccess::getIkService()
@@ -214,4 +115,62 @@ MGraspPoseServiceClient & ServiceAccess::getGraspPoseService()
 	return *(this->getGraspPoseThriftClient().access);
 }
 
+shared_ptr<ServiceConnectionPool<MInverseKinematicsServiceClient>> ServiceAccess::getIkServicePool()
+{
+	return this->getServicePool<MInverseKinematicsServiceClient>("ikService", "IK");
+}
+
+shared_ptr<ServiceConnectionPool<MPathPlanningServiceClient>> ServiceAccess::getPathPlanningServicePool()
+{
+	return this->getServicePool<MPathPlanningServiceClient>("pathPlanningService", "pathPlanning");
+}
+
+shared_ptr<ServiceConnectionPool<MRetargetingServiceClient>> ServiceAccess::getRetargetingServicePool()
+{
+	return this->getServicePool<MRetargetingServiceClient>("retargetingService", "retargeting");
+}
+
+shared_ptr<ServiceConnectionPool<MBlendingServiceClient>> ServiceAccess::getBlendingServicePool()
+{
+	return this->getServicePool<MBlendingServiceClient>("blendingService", "blending");
+}
+
+shared_ptr<ServiceConnectionPool<MCollisionDetectionServiceClient>> ServiceAccess::getCollisionDetectionServicePool()
+{
+	return this->getServicePool<MCollisionDetectionServiceClient>("collisionDetectionService", "collisionDetection");
+}
+
+shared_ptr<ServiceConnectionPool<MGraspPoseServiceClient>> ServiceAccess::getGraspPoseServicePool()
+{
+	return this->getServicePool<MGraspPoseServiceClient>("graspPoseService", "graspPose");
+}
 
+PooledServiceClient<MInverseKinematicsServiceClient> ServiceAccess::acquireIkService()
+{
+	return this->getIkServicePool()->Acquire();
+}
+
+PooledServiceClient<MPathPlanningServiceClient> ServiceAccess::acquirePathPlanningService()
+{
+	return this->getPathPlanningServicePool()->Acquire();
+}
+
+PooledServiceClient<MRetargetingServiceClient> ServiceAccess::acquireRetargetingService()
+{
+	return this->getRetargetingServicePool()->Acquire();
+}
+
+PooledServiceClient<MBlendingServiceClient> ServiceAccess::acquireBlendingService()
+{
+	return this->getBlendingServicePool()->Acquire();
+}
+
+PooledServiceClient<MCollisionDetectionServiceClient> ServiceAccess::acquireCollisionDetectionService()
+{
+	return this->getCollisionDetectionServicePool()->Acquire();
+}
+
+PooledServiceClient<MGraspPoseServiceClient> ServiceAccess::acquireGraspPoseService()
+{
+	return this->getGraspPoseServicePool()->Acquire();
+}
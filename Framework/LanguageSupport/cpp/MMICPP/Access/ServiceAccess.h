@@ -6,6 +6,7 @@
 #include "ServiceAccesIf.h"
 #include "gen-cpp/core_types.h"
 #include <unordered_map>
+#include <mutex>
 namespace MMIStandard {
 	class ServiceAccess : public ServiceAccessIf
 	{
@@ -17,21 +18,30 @@ namespace MMIStandard {
 		//	The address of the MMIRegister
 		MIPAddress const *mmiRegisterAddress;
 
-		//	Map which contains all descriptions of the avaialable services
-		unordered_map<string, MServiceDescription> serviceDescriptions;
-
 		//	The id of the session to which it belongs
 		string sessionID;
 
+		//	Guards the clients, the MMUs of a session may access the services concurrently
+		mutex accessLock;
+
 	private:
-		//	Getter for the service description based on the service name
-		MServiceDescription* getServiceDescription(const string &servicename);
+		//	Getter for the service description based on the service name, throws a runtime_error if the service is not registered
+		//	The descriptions are shared by all sessions (see ServiceDirectory)
+		MServiceDescription getServiceDescription(const string &serviceName, const string &errorName);
+
+		//	Returns the client of the session for the service, creates the client on the first call
+		template <class T>
+		ThriftClient<T> &getThriftClient(shared_ptr<ThriftClient<T>> &client, const string &serviceName, const string &errorName);
+
+		//	Returns the adapter wide pool of the service, throws a runtime_error if the service is not registered
+		template <class T>
+		shared_ptr<ServiceConnectionPool<T>> getServicePool(const string &serviceName, const string &errorName);
 
 	public:
 		//	Basic constructor
 		ServiceAccess(const MIPAddress  &registerAddress, const string &sessionID);
 
-		//	Fetches all service descriptions from the MMIRegister
+		//	Fetches all service descriptions from the MMIRegister, the descriptions are fetched on demand otherwise
 		void initialize();
 
 		// Inherited via ServiceAccessIf
@@ -47,5 +57,17 @@ namespace MMIStandard {
 		virtual MBlendingServiceClient & getBlendingService() override;
 		virtual MCollisionDetectionServiceClient & getCollisionDetectionServicet() override;
 		virtual MGraspPoseServiceClient & getGraspPoseService() override;
+		virtual shared_ptr<ServiceConnectionPool<MInverseKinematicsServiceClient>> getIkServicePool() override;
+		virtual shared_ptr<ServiceConnectionPool<MPathPlanningServiceClient>> getPathPlanningServicePool() override;
+		virtual shared_ptr<ServiceConnectionPool<MRetargetingServiceClient>> getRetargetingServicePool() override;
+		virtual shared_ptr<ServiceConnectionPool<MBlendingServiceClient>> getBlendingServicePool() override;
+		virtual shared_ptr<ServiceConnectionPool<MCollisionDetectionServiceClient>> getCollisionDetectionServicePool() override;
+		virtual shared_ptr<ServiceConnectionPool<MGraspPoseServiceClient>> getGraspPoseServicePool() override;
+		virtual PooledServiceClient<MInverseKinematicsServiceClient> acquireIkService() override;
+		virtual PooledServiceClient<MPathPlanningServiceClient> acquirePathPlanningService() override;
+		virtual PooledServiceClient<MRetargetingServiceClient> acquireRetargetingService() override;
+		virtual PooledServiceClient<MBlendingServiceClient> acquireBlendingService() override;
+		virtual PooledServiceClient<MCollisionDetectionServiceClient> acquireCollisionDetectionService() override;
+		virtual PooledServiceClient<MGraspPoseServiceClient> acquireGraspPoseService() override;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "ServiceCallExecutor.h"
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+
+using namespace MMIStandard;
+using namespace std;
+
+int ServiceCallExecutor::threadCount = 4;
+
+namespace
+{
+	class ServiceThreads
+	{
+		/*
+			The threads are started on the first call and stopped at the end of the process, the queued calls are executed before
+		*/
+	private:
+		vector<thread> threads;
+		deque<function<void()>> tasks;
+		mutex lock;
+		condition_variable wake;
+		bool stopping;
+
+	public:
+		ServiceThreads(int threadCount) :stopping{ false }
+		{
+			for (int i = 0; i < max(threadCount, 1); i++)
+				this->threads.emplace_back(&ServiceThreads::Execute, this);
+		}
+
+		~ServiceThreads()
+		{
+			{
+				lock_guard<mutex> guard(this->lock);
+				this->stopping = true;
+			}
+			this->wake.notify_all();
+			for (thread &thread : this->threads)
+				thread.join();
+		}
+
+		void Post(function<void()> task)
+		{
+			{
+				lock_guard<mutex> guard(this->lock);
+				this->tasks.emplace_back(move(task));
+			}
+			this->wake.notify_one();
+		}
+
+	private:
+		void Execute()
+		{
+			unique_lock<mutex> guard(this->lock);
+			while (true)
+			{
+				this->wake.wait(guard, [this] { return this->stopping || !this->tasks.empty(); });
+				if (this->tasks.empty())
+					return;
+
+				function<void()> task = move(this->tasks.front());
+				this->tasks.pop_front();
+				guard.unlock();
+				// the exceptions of the calls are stored in their futures
+				task();
+				guard.lock();
+			}
+		}
+	};
+
+	ServiceThreads &GetThreads()
+	{
+		static ServiceThreads threads{ ServiceCallExecutor::threadCount };
+		return threads;
+	}
+}
+
+void ServiceCallExecutor::Post(function<void()> task)
+{
+	GetThreads().Post(move(task));
+}
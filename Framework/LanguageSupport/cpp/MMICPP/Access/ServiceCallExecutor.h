@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "ServiceConnectionPool.h"
+#include <functional>
+#include <future>
+#include <memory>
+
+using namespace std;
+
+namespace MMIStandard {
+	class ServiceCallExecutor
+	{
+		/*
+			Threads which execute the blocking thrift calls of the asynchronous service calls.
+			An MMU can issue several service calls (e.g. IK, collision and grasp queries) and continue with its own computation,
+			the results are collected through the returned futures. Each call uses its own connection of the service pool.
+		*/
+	public:
+		//	The number of threads, is read when the first call is executed
+		static int threadCount;
+
+		//	Executes the task on the service threads
+		static void Post(function<void()> task);
+
+		//	Executes the call with the checked out connection on the service threads and returns its result through the future
+		//	The connection is checked out by the caller, so the call does not depend on the session of the caller
+		//	<param name="client">The connection which is used for the call, it is returned to its pool after the call</param>
+		//	<param name="call">Is called with the service client and the result, e.g. [=](MInverseKinematicsServiceClient &ik, MAvatarPostureValues &_return) { ik.ComputeIK(_return, posture, properties); }</param>
+		template <class R, class T, class F>
+		static future<R> Call(PooledServiceClient<T> client, F call)
+		{
+			auto task = make_shared<packaged_task<R()>>([client = move(client), call = move(call)]() mutable
+			{
+				// the task is kept alive by the future, so the connection is moved out to return it to the pool right after the call
+				PooledServiceClient<T> connection = move(client);
+				R result;
+				// a broken connection is reopened and the call repeated once, other exceptions are stored in the future
+				connection.Call([&](T &service) { call(service, result); });
+				return result;
+			});
+			future<R> result = task->get_future();
+			Post([task] { (*task)(); });
+			return result;
+		}
+
+		//	Executes the call with a connection of the pool on the service threads and returns its result through the future
+		//	The connection is checked out by the service thread, so the caller is not blocked while all connections of the pool are in use
+		//	<param name="pool">The pool of the service, e.g. serviceAccess->getIkServicePool()</param>
+		//	<param name="call">Is called with the service client and the result, see above</param>
+		template <class R, class T, class F>
+		static future<R> Call(shared_ptr<ServiceConnectionPool<T>> pool, F call)
+		{
+			auto task = make_shared<packaged_task<R()>>([pool = move(pool), call = move(call)]() mutable
+			{
+				// the connection is returned to the pool at the end of the task
+				PooledServiceClient<T> connection = pool->Acquire();
+				R result;
+				// a broken connection is reopened and the call repeated once, other exceptions are stored in the future
+				connection.Call([&](T &service) { call(service, result); });
+				return result;
+			});
+			future<R> result = task->get_future();
+			Post([task] { (*task)(); });
+			return result;
+		}
+	};
+}
@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "ServiceConnectionPool.h"
+#include "ThriftClient/ThriftClient.cpp"
+#include "gen-cpp/MInverseKinematicsService.h"
+#include "gen-cpp/MPathPlanningService.h"
+#include "gen-cpp/MRetargetingService.h"
+#include "gen-cpp/MBlendingService.h"
+#include "gen-cpp/MCollisionDetectionService.h"
+#include "gen-cpp/MGraspPoseService.h"
+#include "Utils/Logger.h"
+#include "ServiceDirectory.h"
+
+using namespace MMIStandard;
+using namespace std;
+
+size_t ServicePoolSettings::maxConnections = 8;
+chrono::seconds ServicePoolSettings::maxIdleTime{ 60 };
+chrono::milliseconds ServicePoolSettings::probeIdleTime{ 1000 };
+chrono::milliseconds ServicePoolSettings::initialBackoff{ 100 };
+chrono::milliseconds ServicePoolSettings::maxBackoff{ 5000 };
+
+template<class T>
+mutex ServiceConnectionPool<T>::poolsLock;
+
+template<class T>
+unordered_map<string, shared_ptr<ServiceConnectionPool<T>>> ServiceConnectionPool<T>::pools;
+
+template<class T>
+PooledServiceClient<T>::PooledServiceClient(shared_ptr<ServiceConnectionPool<T>> pool, unique_ptr<ThriftClient<T>> client) :pool{ move(pool) }, client{ move(client) }, failed{ false }
+{
+}
+
+template<class T>
+PooledServiceClient<T>::PooledServiceClient(PooledServiceClient && other) noexcept :pool{ move(other.pool) }, client{ move(other.client) }, failed{ other.failed }
+{
+}
+
+template<class T>
+PooledServiceClient<T> & PooledServiceClient<T>::operator=(PooledServiceClient && other) noexcept
+{
+	if (this != &other)
+	{
+		if (this->client != nullptr)
+			this->pool->Release(move(this->client), this->failed);
+		this->pool = move(other.pool);
+		this->client = move(other.client);
+		this->failed = other.failed;
+	}
+	return *this;
+}
+
+template<class T>
+PooledServiceClient<T>::~PooledServiceClient()
+{
+	if (this->client != nullptr)
+		this->pool->Release(move(this->client), this->failed);
+}
+
+template<class T>
+ServiceConnectionPool<T>::ServiceConnectionPool(const string & address, int port, const TransportSettings & settings) :address{ address }, port{ port }, settings{ settings }, openConnections{ 0 }, nextTicket{ 0 }, servingTicket{ 0 }, backoff{ 0 }
+{
+}
+
+template<class T>
+shared_ptr<ServiceConnectionPool<T>> ServiceConnectionPool<T>::Get(const string & address, int port, const TransportSettings & settings)
+{
+	string key = address + ":" + std::to_string(port) + ":" + TransportSettings::ToString(settings.transport) + ":" + TransportSettings::ToString(settings.protocol);
+
+	lock_guard<mutex> guard(poolsLock);
+	shared_ptr<ServiceConnectionPool<T>> &pool = pools[key];
+	if (pool == nullptr)
+		pool = make_shared<ServiceConnectionPool<T>>(address, port, settings);
+	return pool;
+}
+
+template<class T>
+PooledServiceClient<T> ServiceConnectionPool<T>::Acquire()
+{
+	unique_ptr<ThriftClient<T>> client;
+	bool probe = false;
+	{
+		unique_lock<mutex> guard(this->lock);
+		uint64_t ticket = this->nextTicket++;
+		size_t maxConnections = max<size_t>(ServicePoolSettings::maxConnections, 1);
+		this->available.wait(guard, [&] { return ticket == this->servingTicket && (!this->idle.empty() || this->openConnections < maxConnections); });
+		this->servingTicket++;
+
+		auto now = chrono::steady_clock::now();
+		if (!this->idle.empty())
+		{
+			auto idleTime = now - this->idle.front().since;
+			bool stale = idleTime > ServicePoolSettings::maxIdleTime;
+			probe = idleTime > ServicePoolSettings::probeIdleTime;
+			client = move(this->idle.front().client);
+			this->idle.pop_front();
+			if (stale)
+				client->Close();
+		}
+		else if (now < this->retryAt)
+		{
+			guard.unlock();
+			this->available.notify_all();
+			// the service may have been restarted at another address
+			ServiceDirectory::Invalidate();
+			throw runtime_error("Service at " + this->address + ":" + std::to_string(this->port) + " is not reachable, the next connect is tried in " + std::to_string(chrono::duration_cast<chrono::milliseconds>(this->retryAt - now).count()) + " ms");
+		}
+		else
+			this->openConnections++;
+	}
+	// the next caller may check out a connection while this one connects
+	this->available.notify_all();
+
+	// a connection which was used recently is handed out without a round trip
+	if (client != nullptr && client->IsOpen())
+	{
+		if (!probe || Probe(*client))
+			return PooledServiceClient<T>(this->shared_from_this(), move(client));
+
+		Logger::printLog(L_INFO, "Reconnecting to the service at " + this->address + ":" + std::to_string(this->port) + ", the connection is broken");
+		client->Close();
+	}
+
+	try
+	{
+		if (client == nullptr)
+			client = make_unique<ThriftClient<T>>(this->address, this->port, this->settings, false);
+		client->Open();
+	}
+	catch (...)
+	{
+		{
+			lock_guard<mutex> guard(this->lock);
+			this->openConnections--;
+			this->backoff = this->backoff.count() == 0 ? ServicePoolSettings::initialBackoff : min(this->backoff * 2, ServicePoolSettings::maxBackoff);
+			this->retryAt = chrono::steady_clock::now() + this->backoff;
+		}
+		this->available.notify_all();
+		Logger::printLog(L_ERROR, "Unable to connect to the service at " + this->address + ":" + std::to_string(this->port));
+		ServiceDirectory::Invalidate();
+		throw;
+	}
+
+	{
+		lock_guard<mutex> guard(this->lock);
+		this->backoff = chrono::milliseconds{ 0 };
+	}
+	return PooledServiceClient<T>(this->shared_from_this(), move(client));
+}
+
+template<class T>
+void ServiceConnectionPool<T>::Release(unique_ptr<ThriftClient<T>> client, bool failed)
+{
+	if (failed)
+		client->Close();
+	{
+		lock_guard<mutex> guard(this->lock);
+		if (failed)
+			this->openConnections--;
+		else
+			this->idle.push_back(IdleConnection{ move(client), chrono::steady_clock::now() });
+	}
+	this->available.notify_all();
+
+	// the failed connection is destroyed outside of the lock
+}
+
+template<class T>
+bool ServiceConnectionPool<T>::Probe(ThriftClient<T>& client)
+{
+	try
+	{
+		map<string, string> status;
+		client.access->GetStatus(status);
+		return true;
+	}
+	catch (...)
+	{
+		return false;
+	}
+}
+
+// the pools of the services which can be accessed by the MMUs (see ServiceAccessIf)
+template class MMIStandard::PooledServiceClient<MInverseKinematicsServiceClient>;
+template class MMIStandard::PooledServiceClient<MPathPlanningServiceClient>;
+template class MMIStandard::PooledServiceClient<MRetargetingServiceClient>;
+template class MMIStandard::PooledServiceClient<MBlendingServiceClient>;
+template class MMIStandard::PooledServiceClient<MCollisionDetectionServiceClient>;
+template class MMIStandard::PooledServiceClient<MGraspPoseServiceClient>;
+template class MMIStandard::ServiceConnectionPool<MInverseKinematicsServiceClient>;
+template class MMIStandard::ServiceConnectionPool<MPathPlanningServiceClient>;
+template class MMIStandard::ServiceConnectionPool<MRetargetingServiceClient>;
+template class MMIStandard::ServiceConnectionPool<MBlendingServiceClient>;
+template class MMIStandard::ServiceConnectionPool<MCollisionDetectionServiceClient>;
+template class MMIStandard::ServiceConnectionPool<MGraspPoseServiceClient>;
@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "ThriftClient/ThriftClient.h"
+#include "Utils/TransportSettings.h"
+#include <thrift/transport/TTransportException.h>
+#include <string>
+#include <memory>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <exception>
+#include <utility>
+
+using namespace std;
+
+namespace MMIStandard {
+
+	struct ServicePoolSettings
+	{
+		/*
+			Settings of all service connection pools of the adapter
+		*/
+
+		//	The maximum number of connections to one service, further callers wait until a connection is returned
+		static size_t maxConnections;
+
+		//	Connections which were not used for this time are reopened before they are handed out, the service may have dropped them
+		static chrono::seconds maxIdleTime;
+
+		//	Connections which were not used for this time are probed with GetStatus before they are handed out, a broken connection is reopened
+		//	The service may have been restarted in the meantime, which is not visible on the local socket
+		static chrono::milliseconds probeIdleTime;
+
+		//	The time a failed connect blocks further connects, it is doubled on each failure up to the maximum
+		static chrono::milliseconds initialBackoff;
+		static chrono::milliseconds maxBackoff;
+	};
+
+	template <class T>
+	class ServiceConnectionPool;
+
+	template <class T>
+	class PooledServiceClient
+	{
+		/*
+			A connection checked out from a ServiceConnectionPool, it is returned to the pool once the object is destroyed.
+			If a call through operator-> or Call throws (e.g. a TTransportException), or Failed was called, the connection is closed instead of being reused,
+			also if the exception is caught while the connection is still alive (the connection may be interrupted in the middle of a call).
+			Calls through operator* are not tracked, the caller has to use Failed.
+		*/
+	public:
+		class CallGuard
+		{
+			/*
+				Is returned by operator-> and lives until the end of the call, marks the connection as failed if the call throws
+			*/
+		private:
+			PooledServiceClient &owner;
+			int uncaughtExceptions;
+
+		public:
+			CallGuard(PooledServiceClient &owner) :owner(owner), uncaughtExceptions{ uncaught_exceptions() } {}
+			~CallGuard() { if (uncaught_exceptions() > this->uncaughtExceptions) this->owner.failed = true; }
+
+			T *operator->() const { return this->owner.client->access.get(); }
+		};
+
+	private:
+		shared_ptr<ServiceConnectionPool<T>> pool;
+		unique_ptr<ThriftClient<T>> client;
+		bool failed;
+
+	public:
+		//	Basic constructor, is used by the pool
+		PooledServiceClient(shared_ptr<ServiceConnectionPool<T>> pool, unique_ptr<ThriftClient<T>> client);
+
+		PooledServiceClient(PooledServiceClient &&other) noexcept;
+		PooledServiceClient& operator=(PooledServiceClient &&other) noexcept;
+		PooledServiceClient(const PooledServiceClient&) = delete;
+		PooledServiceClient& operator=(const PooledServiceClient&) = delete;
+
+		//	Returns the connection to the pool
+		~PooledServiceClient();
+
+		//	Access to the service client, a call which throws marks the connection as failed
+		CallGuard operator->() { return CallGuard(*this); }
+
+		//	Access to the service client, the calls are not tracked
+		T &operator*() const { return *this->client->access; }
+
+		//	Marks the connection as broken, it is closed instead of being reused
+		void Failed() { this->failed = true; }
+
+		//	Executes the call with the service client and returns its result, e.g. connection.Call([&](MInverseKinematicsServiceClient &ik) { ik.ComputeIK(result, posture, properties); })
+		//	If the connection turns out to be broken (TTransportException, e.g. the service was restarted), it is reopened and the call is repeated once
+		//	Any other exception marks the connection as failed and is rethrown
+		template <class F>
+		auto Call(F call) -> decltype(call(declval<T&>()))
+		{
+			try
+			{
+				return call(*this->client->access);
+			}
+			catch (const apache::thrift::transport::TTransportException &)
+			{
+				// the connection is reopened and the call repeated below
+			}
+			catch (...)
+			{
+				this->failed = true;
+				throw;
+			}
+
+			try
+			{
+				this->client->Close();
+				this->client->Open();
+				return call(*this->client->access);
+			}
+			catch (...)
+			{
+				this->failed = true;
+				throw;
+			}
+		}
+	};
+
+	template <class T>
+	class ServiceConnectionPool : public enable_shared_from_this<ServiceConnectionPool<T>>
+	{
+		/*
+			Reusable connections to one service which are shared by all sessions of the adapter.
+			A connection is used by one caller at a time, so the MMUs of different avatars can call the service concurrently.
+			Waiting callers are served in the order of their calls, the number of connections is bounded (see ServicePoolSettings).
+			If the service can not be reached, further connects are rejected for a growing backoff time instead of blocking each caller.
+		*/
+		friend class PooledServiceClient<T>;
+
+	private:
+		struct IdleConnection
+		{
+			unique_ptr<ThriftClient<T>> client;
+			chrono::steady_clock::time_point since;
+		};
+
+		string address;
+		int port;
+		TransportSettings settings;
+
+		mutex lock;
+		condition_variable available;
+
+		//	The connections which are not checked out, the longest unused first
+		deque<IdleConnection> idle;
+
+		//	The number of idle, checked out and connecting connections
+		size_t openConnections;
+
+		//	The callers are served in the order of their tickets
+		uint64_t nextTicket;
+		uint64_t servingTicket;
+
+		//	Connects are rejected until this time after a failed connect
+		chrono::steady_clock::time_point retryAt;
+		chrono::milliseconds backoff;
+
+		//	The pools of the services structured by address, port and transport settings
+		static mutex poolsLock;
+		static unordered_map<string, shared_ptr<ServiceConnectionPool<T>>> pools;
+
+	private:
+		//	Returns a connection after it has been used
+		void Release(unique_ptr<ThriftClient<T>> client, bool failed);
+
+		//	Returns true if the service answers GetStatus on the connection
+		static bool Probe(ThriftClient<T> &client);
+
+	public:
+		//	Basic constructor, use Get to share the pool of a service
+		ServiceConnectionPool(const string &address, int port, const TransportSettings &settings);
+
+		ServiceConnectionPool(const ServiceConnectionPool&) = delete;
+		ServiceConnectionPool& operator=(const ServiceConnectionPool&) = delete;
+
+		//	Returns the pool of the service, creates it on the first call
+		static shared_ptr<ServiceConnectionPool<T>> Get(const string &address, int port, const TransportSettings &settings);
+
+		//	Checks out a connection, waits if all connections are in use
+		//	Throws a runtime_error if the service can not be reached, the service descriptions are invalidated then (see ServiceDirectory)
+		PooledServiceClient<T> Acquire();
+	};
+}
@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "ServiceDirectory.h"
+#include "gen-cpp/MMIRegisterService.h"
+#include "ThriftClient/ThriftClient.cpp"
+#include "Utils/Logger.h"
+
+using namespace MMIStandard;
+using namespace std;
+
+chrono::seconds ServiceDirectory::timeToLive{ 30 };
+chrono::seconds ServiceDirectory::missingTimeToLive{ 5 };
+
+mutex ServiceDirectory::lock;
+condition_variable ServiceDirectory::fetched;
+shared_ptr<const ServiceDirectory::Services> ServiceDirectory::services;
+chrono::steady_clock::time_point ServiceDirectory::fetchedAt;
+chrono::steady_clock::time_point ServiceDirectory::attemptedAt;
+bool ServiceDirectory::fetching = false;
+uint64_t ServiceDirectory::fetchCount = 0;
+bool ServiceDirectory::invalidated = false;
+
+thread ServiceDirectory::refreshThread;
+mutex ServiceDirectory::refreshLock;
+condition_variable ServiceDirectory::refreshStop;
+bool ServiceDirectory::refreshStopping = false;
+
+bool ServiceDirectory::GetServiceDescription(MServiceDescription & _return, const MIPAddress & registerAddress, const string & sessionID, const string & serviceName)
+{
+	unique_lock<mutex> guard(lock);
+	auto now = chrono::steady_clock::now();
+	bool found = services != nullptr && services->find(serviceName) != services->end();
+	bool expired = services == nullptr || invalidated || now - fetchedAt >= timeToLive;
+
+	// a missing service and a failed fetch are not asked for again until missingTimeToLive has passed
+	if ((expired || !found) && (attemptedAt == chrono::steady_clock::time_point{} || now - attemptedAt >= missingTimeToLive))
+		Fetch(guard, registerAddress, sessionID);
+
+	if (services == nullptr)
+		return false;
+
+	auto it = services->find(serviceName);
+	if (it == services->end())
+		return false;
+
+	_return = it->second;
+	return true;
+}
+
+void ServiceDirectory::Refresh(const MIPAddress & registerAddress, const string & sessionID)
+{
+	unique_lock<mutex> guard(lock);
+	Fetch(guard, registerAddress, sessionID);
+}
+
+void ServiceDirectory::Invalidate()
+{
+	// the register is asked on the next lookup, but not more often than every missingTimeToLive
+	lock_guard<mutex> guard(lock);
+	invalidated = true;
+}
+
+void ServiceDirectory::Fetch(unique_lock<mutex>& guard, const MIPAddress & registerAddress, const string & sessionID)
+{
+	if (fetching)
+	{
+		// the result of the running fetch is used
+		uint64_t count = fetchCount;
+		fetched.wait(guard, [count] { return fetchCount != count; });
+		return;
+	}
+
+	fetching = true;
+	guard.unlock();
+	shared_ptr<const Services> result;
+	try
+	{
+		result = Request(registerAddress, sessionID);
+	}
+	catch (...)
+	{
+		Logger::printLog(L_ERROR, "Problem fetching available services from the register.Wrong address ? Server down ? ");
+	}
+	guard.lock();
+
+	auto now = chrono::steady_clock::now();
+	attemptedAt = now;
+	if (result != nullptr)
+	{
+		services = move(result);
+		fetchedAt = now;
+		invalidated = false;
+	}
+	fetching = false;
+	fetchCount++;
+	fetched.notify_all();
+}
+
+shared_ptr<const ServiceDirectory::Services> ServiceDirectory::Request(const MIPAddress & registerAddress, const string & sessionID)
+{
+	Logger::printLog(L_INFO, "Trying to fetch the services from register: " + registerAddress.Address + ":" + std::to_string(registerAddress.Port));
+
+	ThriftClient<MMIRegisterServiceClient> client{ registerAddress.Address, registerAddress.Port, false };
+	client.Open();
+	vector<MServiceDescription> serviceDescriptions;
+	client.access->GetRegisteredServices(serviceDescriptions, sessionID);
+
+	auto result = make_shared<Services>();
+	for (MServiceDescription &serviceDescription : serviceDescriptions)
+	{
+		if (serviceDescription.Addresses.empty())
+			continue;
+		MMI_LOG(L_DEBUG, "found: " + serviceDescription.Name + " at " + serviceDescription.Addresses[0].Address + ":" + std::to_string(serviceDescription.Addresses[0].Port));
+
+		// the first registered service of a name is used
+		result->emplace(serviceDescription.Name, move(serviceDescription));
+	}
+	return result;
+}
+
+void ServiceDirectory::StartRefresh(const MIPAddress & registerAddress, const string & adapterID)
+{
+	if (refreshThread.joinable())
+		return;
+
+	{
+		lock_guard<mutex> guard(refreshLock);
+		refreshStopping = false;
+	}
+	refreshThread = thread([registerAddress, adapterID]
+	{
+		unique_lock<mutex> guard(refreshLock);
+		while (!refreshStopping)
+		{
+			if (refreshStop.wait_for(guard, timeToLive / 2, [] { return refreshStopping; }))
+				break;
+			guard.unlock();
+
+			// the register is only asked if a session has used the services
+			bool used;
+			{
+				lock_guard<mutex> servicesGuard(lock);
+				used = services != nullptr;
+			}
+			if (used)
+				Refresh(registerAddress, adapterID);
+			guard.lock();
+		}
+	});
+}
+
+void ServiceDirectory::StopRefresh()
+{
+	if (!refreshThread.joinable())
+		return;
+
+	{
+		lock_guard<mutex> guard(refreshLock);
+		refreshStopping = true;
+	}
+	refreshStop.notify_all();
+	refreshThread.join();
+}
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "gen-cpp/core_types.h"
+#include "gen-cpp/services_types.h"
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+
+using namespace std;
+
+namespace MMIStandard {
+	class ServiceDirectory
+	{
+		/*
+			Adapter wide cache of the service descriptions of the MMIRegister, shared by the ServiceAccess of all sessions.
+			The descriptions are fetched again once they are older than timeToLive or have been invalidated.
+			A service which is not registered is only looked up again after missingTimeToLive, the same applies after a failed fetch,
+			then the last fetched descriptions are used further.
+			If several callers miss at the same time only one of them fetches the descriptions, the others wait for its result.
+			The refresh thread fetches the descriptions in the background, so the callers usually do not wait for the register.
+		*/
+	public:
+		//	The time the fetched descriptions are used
+		static chrono::seconds timeToLive;
+
+		//	The time a missing service is reported without asking the register again, also the time between failed fetches
+		static chrono::seconds missingTimeToLive;
+
+	private:
+		typedef unordered_map<string, MServiceDescription> Services;
+
+		static mutex lock;
+		static condition_variable fetched;
+
+		//	The last fetched descriptions, nullptr until the first successful fetch
+		static shared_ptr<const Services> services;
+
+		//	The time of the last successful fetch and of the last attempt
+		static chrono::steady_clock::time_point fetchedAt;
+		static chrono::steady_clock::time_point attemptedAt;
+
+		//	Whether the descriptions are fetched at the moment and the number of finished fetches
+		static bool fetching;
+		static uint64_t fetchCount;
+
+		//	Whether the descriptions have to be fetched before they are used again
+		static bool invalidated;
+
+		//	The thread which fetches the descriptions in the background
+		static thread refreshThread;
+		static mutex refreshLock;
+		static condition_variable refreshStop;
+		static bool refreshStopping;
+
+	private:
+		//	Fetches the descriptions, or waits for the fetch of another caller, the lock has to be held
+		static void Fetch(unique_lock<mutex> &guard, const MIPAddress &registerAddress, const string &sessionID);
+
+		//	Requests the descriptions from the register
+		static shared_ptr<const Services> Request(const MIPAddress &registerAddress, const string &sessionID);
+
+	public:
+		//	Returns the description of the service, fetches the descriptions from the register if required
+		//	<param name="_return">The description of the service</param>
+		//	<param name="registerAddress">The address of the register which is asked if the descriptions are outdated</param>
+		//	<param name="sessionID">The session of the caller, is passed to the register</param>
+		//	<param name="serviceName">The name of the service</param>
+		//	Returns false if the service is not registered
+		static bool GetServiceDescription(MServiceDescription &_return, const MIPAddress &registerAddress, const string &sessionID, const string &serviceName);
+
+		//	Fetches the descriptions from the register, concurrent callers share the fetch
+		static void Refresh(const MIPAddress &registerAddress, const string &sessionID);
+
+		//	Marks the descriptions as outdated, e.g. if a service can not be reached at its address, use Refresh to fetch them immediately
+		static void Invalidate();
+
+		//	Starts the thread which fetches the descriptions every half of timeToLive once they have been used
+		static void StartRefresh(const MIPAddress &registerAddress, const string &adapterID);
+
+		//	Stops the refresh thread
+		static void StopRefresh();
+	};
+}
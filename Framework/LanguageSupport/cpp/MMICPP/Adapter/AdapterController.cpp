@@ -12,17 +12,49 @@
 #include "Utils/Logger.h"
 #include "ThriftServer/ThriftNonBlockingServer.h"
 #include "ThriftServer/ThriftServer.h"
+#include "SessionCleaner.h"
+#include "Access/ServiceDirectory.h"
+#include "ThriftServer/CollisionDetectionServer.h"
+#include "Collision/LocalCollisionDetection.h"
 
 CPPMMUInstantiator AdapterController::instantiator;
 
-AdapterController::AdapterController(const MIPAddress & aAddress, const MIPAddress &rAddress, const string &mmuPath, int workerCount, const CPPMMUInstantiator &instantiator, const vector<string> & languages, const MAdapterDescription &adapterDescription) :adapterAddress(aAddress), registerAddress(rAddress), mmuPath(mmuPath), workerCount{ workerCount }, languages{ languages }
+AdapterController::AdapterController(const MIPAddress & aAddress, const MIPAddress &rAddress, const string &mmuPath, const ServerSettings &serverSettings, const CPPMMUInstantiator &instantiator, const vector<string> & languages, const MAdapterDescription &adapterDescription) :adapterAddress(aAddress), registerAddress(rAddress), mmuPath(mmuPath), serverSettings{ serverSettings }, languages{ languages }
 {
 	this->isRegistered = false;
+	this->isCollisionServiceRegistered = false;
 	AdapterController::instantiator = instantiator;
 
+	if (this->serverSettings.type == S_NONBLOCKING && this->serverSettings.transport.transport != T_FRAMED)
+	{
+		Logger::printLog(L_INFO, "The nonblocking server only supports the framed transport");
+		this->serverSettings.transport.transport = T_FRAMED;
+	}
+
 	//init SessionData
 	SessionData::adapterDescription = adapterDescription;
 	SessionData::registerAddress = rAddress;
+	SessionData::CreateStepExecutor(this->serverSettings.stepThreadCount);
+
+	//advertise the transport and protocol, so the clients can connect with the same settings
+	SessionData::adapterDescription.__isset.Properties = true;
+	this->serverSettings.transport.WriteProperties(SessionData::adapterDescription.Properties);
+
+	//the local collision detection is registered as service of the adapter
+	if (this->serverSettings.collisionPort > 0)
+	{
+		MIPAddress collisionAddress{};
+		collisionAddress.__set_Address(this->adapterAddress.Address);
+		collisionAddress.__set_Port(this->serverSettings.collisionPort);
+
+		MServiceDescription &description = LocalCollisionDetection::description;
+		description.__set_Name(LocalCollisionDetection::ServiceName);
+		description.__set_ID(adapterDescription.ID + ".collisionDetection");
+		description.__set_Language("C++");
+		description.__set_Addresses(vector<MIPAddress>{collisionAddress});
+		description.__isset.Properties = true;
+		this->serverSettings.transport.WriteProperties(description.Properties);
+	}
 }
 
 const CPPMMUInstantiator & AdapterController::GetMMUInstantiator()
@@ -36,6 +68,8 @@ AdapterController::~AdapterController()
 	client.Start();
 	MBoolResponse response{};
 	client.access->UnregisterAdapter(response, SessionData::adapterDescription);
+	if (this->isCollisionServiceRegistered)
+		client.access->UnregisterService(response, LocalCollisionDetection::description);
 
 	//this->thriftServer.~AdapterServer();
 }
@@ -51,13 +85,28 @@ void AdapterController::Start()
 
 	thread fileWatcherThread(&FileWatcher::Start, watcher);
 
+	//removes the unused sessions, the thread is only started if a timeout is set
+	SessionCleaner cleaner{ this->serverSettings.sessionTimeout };
+	cleaner.start();
+
+	//keeps the service descriptions of the sessions up to date
+	ServiceDirectory::StartRefresh(this->registerAddress, SessionData::adapterDescription.ID);
+
 	////new thread for adapter server
 	thread serverThread(&AdapterController::StartAdapterServer, this);
+
+	//new thread for the server of the local collision detection
+	thread collisionThread;
+	if (this->serverSettings.collisionPort > 0)
+		collisionThread = thread(&AdapterController::StartCollisionServer, this);
 	//
 	////block "main thread" until all threads finished
 	registerThread.join();
 	fileWatcherThread.join();
 	serverThread.join();
+	if (collisionThread.joinable())
+		collisionThread.join();
+	ServiceDirectory::StopRefresh();
 }
 
 void AdapterController::RegisterAdapter()
@@ -80,17 +129,62 @@ void AdapterController::RegisterAdapter()
 			this_thread::sleep_for(1s);
 		}	
 	}
+
+	if (this->serverSettings.collisionPort > 0)
+		this->RegisterCollisionService();
+}
+
+void AdapterController::RegisterCollisionService()
+{
+	while (this->isCollisionServiceRegistered != true)
+	{
+		try
+		{
+			ThriftClient<MMIRegisterServiceClient> client{ this->registerAddress.Address,this->registerAddress.Port };
+			client.Start();
+			MBoolResponse response{};
+			client.access->RegisterService(response, LocalCollisionDetection::description);
+			this->isCollisionServiceRegistered = response.Successful;
+			if (this->isCollisionServiceRegistered)
+				Logger::printLog(L_INFO, "Successfully registered the collision detection service at MMIRegister");
+		}
+		catch (...)
+		{
+			Logger::printLog(L_ERROR, "Failed to register the collision detection service at MMIRegister");
+			this_thread::sleep_for(1s);
+		}
+	}
 }
 
 void AdapterController::StartAdapterServer()
 {
-	//ThriftNonBlockingServer server {};
-	ThriftServer server{};
 	Logger::printLog(L_INFO, "Starting adapter server at: " + this->adapterAddress.Address + ":" + std::to_string (this->adapterAddress.Port));
 	try 
 	{
-		server.Start(this->adapterAddress.Port,this->workerCount);
-		//server.Start(this->adapterAddress.Port);
+		if (this->serverSettings.type == S_NONBLOCKING)
+		{
+			ThriftNonBlockingServer server{};
+			server.Start(this->adapterAddress.Port, this->serverSettings.ioThreadCount, this->serverSettings.workerCount, this->serverSettings.transport.protocol);
+		}
+		else
+		{
+			ThriftServer server{};
+			server.Start(this->adapterAddress.Port, this->serverSettings.workerCount, this->serverSettings.transport);
+		}
+	}
+	catch (...)
+	{
+		Logger::printLog(L_ERROR, boost::current_exception_diagnostic_information());
+	}
+}
+
+void AdapterController::StartCollisionServer()
+{
+	Logger::printLog(L_INFO, "Starting collision detection server at: " + this->adapterAddress.Address + ":" + std::to_string(this->serverSettings.collisionPort));
+	try
+	{
+		CollisionDetectionServer server{};
+		server.Start(this->serverSettings.collisionPort, this->serverSettings.workerCount, this->serverSettings.transport);
 	}
 	catch (...)
 	{
@@ -10,6 +10,7 @@
 #include "Adapter/CPPMMUInstantiator.h"
 #include "Utils/Logger.h"
 #include "gen-cpp/register_types.h"  // added, sadam
+#include "ThriftServer/ServerSettings.h"
 
 using namespace MMIStandard;
 using namespace std;
@@ -24,6 +25,7 @@ namespace MMIStandard {
 				registers the adapter at the MMIRegister
 				starts the FileWatcher
 				starts the AdapterServer
+				serves and registers the local collision detection if a port is set
 		*/
 
 	private:
@@ -42,8 +44,11 @@ namespace MMIStandard {
 		//	Bool which shows, if the adapter is registered at the MMIRegister
 		bool isRegistered;
 
-		//	The number of server threads
-		int workerCount;
+		//	Bool which shows, if the collision detection service is registered at the MMIRegister
+		bool isCollisionServiceRegistered;
+
+		//	The server engine and the number of server threads
+		ServerSettings serverSettings;
 
 		//	The helper class which instantiates the MMUs from file
 		static CPPMMUInstantiator instantiator;
@@ -55,16 +60,23 @@ namespace MMIStandard {
 		//	Creates and starts an new AdapterServer
 		void StartAdapterServer();
 
+		//	Registers the local collision detection at the MMIRegister
+		void RegisterCollisionService();
+
+		//	Creates and starts the server of the local collision detection
+		void StartCollisionServer();
+
 	public:
 		//	Basic constructor
 		//	<param name="address">The address of the adapter</param>
 		//	<param name="mmiRegisterAddress">The address of the register (where all services, adapters and mmus are registered)</param>
 		//	<param name="mmuPath">The path where the MMUs are located</param>
+		//	<param name="serverSettings">The server engine and the number of server threads</param>
 		//	<param name="instantioator">the instantiator class which instantiates thte MMus from file</param>
 		//	<param name="languages">the languages the adapter should support </param>
 		//	<param name="adapterDescription">the description of the adapter</param>
 		//	<param name="logLevel">the log level for the logger, default = L_Debug</param>
-		AdapterController(const MIPAddress & aAddress, const MIPAddress &rAddress, const string &mmuPath, int workerCount, const CPPMMUInstantiator &instantiator, const vector<string> &languages, const MAdapterDescription &adapterDescription);		//returns a const reference of the instantiator
+		AdapterController(const MIPAddress & aAddress, const MIPAddress &rAddress, const string &mmuPath, const ServerSettings &serverSettings, const CPPMMUInstantiator &instantiator, const vector<string> &languages, const MAdapterDescription &adapterDescription);		//returns a const reference of the instantiator
 
 		static const CPPMMUInstantiator & GetMMUInstantiator();
 		//	Basic destructor
@@ -3,17 +3,25 @@
 // Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
 
 #include "AvatarContent.h"
+#include <mutex>
 
 AvatarContent::AvatarContent(string avatarId) :avatarID{ avatarId }
 {
 }
 
- MotionModelUnitBaseIf & AvatarContent::GetMMUbyId(const string &mmuId) const
+void AvatarContent::AddMMU(const string & mmuId, unique_ptr<MotionModelUnitBaseIf> mmu)
 {
+	unique_lock<shared_mutex> guard(this->mmuLock);
+	this->MMUs[mmuId] = move(mmu);
+}
+
+ shared_ptr<MotionModelUnitBaseIf> AvatarContent::GetMMUbyId(const string &mmuId) const
+{
+	shared_lock<shared_mutex> guard(this->mmuLock);
 	auto iter = this->MMUs.find(mmuId);
 	if (iter != this->MMUs.end()) // mmu found!
 	{
-		return *iter->second;
+		return iter->second;
 	}
 	else
 	{
@@ -21,3 +29,22 @@ AvatarContent::AvatarContent(string avatarId) :avatarID{ avatarId }
 	}
 }
 
+vector<string> AvatarContent::GetMMUIds() const
+{
+	shared_lock<shared_mutex> guard(this->mmuLock);
+	vector<string> mmuIds;
+	mmuIds.reserve(this->MMUs.size());
+	for (const auto &mmu : this->MMUs)
+		mmuIds.emplace_back(mmu.first);
+	return mmuIds;
+}
+
+vector<shared_ptr<MotionModelUnitBaseIf>> AvatarContent::GetMMUs() const
+{
+	shared_lock<shared_mutex> guard(this->mmuLock);
+	vector<shared_ptr<MotionModelUnitBaseIf>> mmus;
+	mmus.reserve(this->MMUs.size());
+	for (const auto &mmu : this->MMUs)
+		mmus.emplace_back(mmu.second);
+	return mmus;
+}
@@ -5,6 +5,9 @@
 #pragma once
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include <memory>
+#include <shared_mutex>
 #include "MotionModelUnitBaseIf.h"
 #include "gen-cpp/scene_types.h"
 
@@ -19,12 +22,16 @@ namespace MMIStandard {
 		//	the id of the avatar
 		string avatarID;
 
-		// The list of MMUs of the session
-		mutable unordered_map<string, unique_ptr<MotionModelUnitBaseIf>> MMUs;
-
 		//	The posture of the reference avatar
 		MAvatarPosture referencePosture;
 
+	private:
+		// The list of MMUs of the session, a replaced MMU is kept alive by the calls which still use it
+		unordered_map<string, shared_ptr<MotionModelUnitBaseIf>> MMUs;
+
+		//	Guards the MMUs, MMUs can be loaded while other calls of the session step the loaded ones
+		mutable shared_mutex mmuLock;
+
 	public:
 		//	Basic constructor
 		AvatarContent(string avatarId);
@@ -34,8 +41,19 @@ namespace MMIStandard {
 		AvatarContent(AvatarContent&&) = delete;
 		AvatarContent& operator=(AvatarContent&&) = delete;
 
-		//	Returns the MMU based on the id
-		MotionModelUnitBaseIf &GetMMUbyId(const string &mmuId) const;
+		//	Adds the MMU, an already loaded MMU with the same id is replaced
+		//	<param name="mmuId">The id of the MMU</param>
+		//	<param name="mmu">The instantiated MMU</param>
+		void AddMMU(const string &mmuId, unique_ptr<MotionModelUnitBaseIf> mmu);
+
+		//	Returns the MMU based on the id, the handle keeps the MMU alive if it is replaced during the call
+		shared_ptr<MotionModelUnitBaseIf> GetMMUbyId(const string &mmuId) const;
+
+		//	Returns the ids of all MMUs
+		vector<string> GetMMUIds() const;
+
+		//	Returns all MMUs
+		vector<shared_ptr<MotionModelUnitBaseIf>> GetMMUs() const;
 	};
 }
 
@@ -3,27 +3,69 @@
 // Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
 
 #include "CPPMMUInstantiator.h"
-#include <iostream>
+#include <mutex>
+#include <stdexcept>
 
-typedef MotionModelUnitBaseIf* (__cdecl *MMU_factory)();
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
 
 using namespace std;
 
-std::unique_ptr<MotionModelUnitBaseIf> CPPMMUInstantiator::InstantiateMMU(const string &mmuPath)
+unordered_map<string, CPPMMUInstantiator::MMU_factory> CPPMMUInstantiator::factories;
+shared_mutex CPPMMUInstantiator::factoriesLock;
+
+CPPMMUInstantiator::MMU_factory CPPMMUInstantiator::GetFactory(const string & mmuPath)
 {
-	DWORD dwError = 0;
+	{
+		shared_lock<shared_mutex> guard(factoriesLock);
+		auto it = factories.find(mmuPath);
+		if (it != factories.end())
+			return it->second;
+	}
+
+	// the lock is held while loading, so concurrent first calls of the same library load it only once
+	unique_lock<shared_mutex> guard(factoriesLock);
+	auto it = factories.find(mmuPath);
+	if (it != factories.end())
+		return it->second;
+
+#ifdef _WIN32
 	// Load the DLL
 	HINSTANCE dll_handle = LoadLibraryA(mmuPath.c_str());
 	if (!dll_handle) {
-		throw  std::invalid_argument("Unable to load the DLL, wrong path?");
+		throw  std::invalid_argument("Unable to load the DLL, wrong path? " + mmuPath + " (error " + std::to_string(GetLastError()) + ")");
 	}
 
 	// Get the function from the DLL
 	MMU_factory MMU_func = reinterpret_cast<MMU_factory>(::GetProcAddress(dll_handle, "instantiate"));
 	if (!MMU_func) {
 		::FreeLibrary(dll_handle);
-		throw std::runtime_error("Unable to create the MMU, check the DLL");
+		throw std::runtime_error("Unable to create the MMU, check the DLL: " + mmuPath);
+	}
+#else
+	// Load the shared library, the symbols of different MMUs are kept apart
+	void *library_handle = dlopen(mmuPath.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if (!library_handle) {
+		const char *error = dlerror();
+		throw  std::invalid_argument("Unable to load the library, wrong path? " + string(error != nullptr ? error : mmuPath));
 	}
 
-	return std::unique_ptr<MotionModelUnitBaseIf> { MMU_func() };
-}
\ No newline at end of file
+	// Get the function from the library
+	MMU_factory MMU_func = reinterpret_cast<MMU_factory>(dlsym(library_handle, "instantiate"));
+	if (!MMU_func) {
+		dlclose(library_handle);
+		throw std::runtime_error("Unable to create the MMU, check the library: " + mmuPath);
+	}
+#endif
+
+	factories.emplace(mmuPath, MMU_func);
+	return MMU_func;
+}
+
+std::unique_ptr<MotionModelUnitBaseIf> CPPMMUInstantiator::InstantiateMMU(const string &mmuPath) const
+{
+	return std::unique_ptr<MotionModelUnitBaseIf> { GetFactory(mmuPath)() };
+}
@@ -4,6 +4,10 @@
 
 #pragma once
 #include "MotionModelUnitBaseIf.h"
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <shared_mutex>
 
 using namespace MMIStandard;
 using namespace std;
@@ -13,10 +17,24 @@ namespace MMIStandard {
 	{
 		/*
 			 Class which instantiates basic CPP MMUs
+			 The libraries are loaded with LoadLibrary on Windows and dlopen on other platforms.
+			 Each library is loaded once per process, the resolved instantiate functions are cached by the path.
+			 The libraries are never unloaded, since the instantiated MMUs execute their code.
 		*/
+	private:
+		//	The instantiate function of an MMU library
+		typedef MotionModelUnitBaseIf* (*MMU_factory)();
+
+		//	The instantiate functions of the loaded libraries structured by the path
+		static unordered_map<string, MMU_factory> factories;
+		static shared_mutex factoriesLock;
+
+	private:
+		//	Returns the instantiate function of the library, loads the library on the first call
+		static MMU_factory GetFactory(const string &mmuPath);
+
 	public:
 		//	Returns the instantiated MMU based on the path
-		unique_ptr<MotionModelUnitBaseIf> InstantiateMMU(const string &mmuPath);
+		unique_ptr<MotionModelUnitBaseIf> InstantiateMMU(const string &mmuPath) const;
 	};
 }
-
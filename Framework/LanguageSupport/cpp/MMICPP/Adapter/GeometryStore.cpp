@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "GeometryStore.h"
+#include "boost/functional/hash.hpp"
+
+using namespace MMIStandard;
+
+namespace
+{
+	void HashVertices(size_t &seed, const vector<MVector3> &vertices)
+	{
+		boost::hash_combine(seed, vertices.size());
+		for (const MVector3 &vertex : vertices)
+		{
+			boost::hash_combine(seed, vertex.X);
+			boost::hash_combine(seed, vertex.Y);
+			boost::hash_combine(seed, vertex.Z);
+		}
+	}
+
+	size_t GetMemoryUsage(const MCollider &collider)
+	{
+		size_t usage = sizeof(MCollider);
+		if (collider.__isset.MeshColliderProperties)
+			usage += collider.MeshColliderProperties.Vertices.capacity() * sizeof(MVector3) + collider.MeshColliderProperties.Triangles.capacity() * sizeof(int32_t);
+		if (collider.__isset.Colliders)
+		{
+			for (const MCollider &child : collider.Colliders)
+				usage += GetMemoryUsage(child);
+		}
+		return usage;
+	}
+}
+
+GeometryStore::GeometryStore() :sharedSincePurge{ 0 }
+{
+}
+
+template<typename T>
+shared_ptr<const T> GeometryStore::Share(unordered_multimap<size_t, weak_ptr<const T>> &entries, size_t hash, const T & value)
+{
+	// the stored instances have no ID, so the value is compared without its ID
+	T geometry(value);
+	geometry.ID.clear();
+
+	auto range = entries.equal_range(hash);
+	for (auto iter = range.first; iter != range.second; ++iter)
+	{
+		shared_ptr<const T> entry = iter->second.lock();
+		if (entry && *entry == geometry)
+			return entry;
+	}
+
+	shared_ptr<const T> entry = make_shared<const T>(move(geometry));
+	entries.emplace(hash, entry);
+	return entry;
+}
+
+template<typename T>
+void GeometryStore::Purge(unordered_multimap<size_t, weak_ptr<const T>> &entries)
+{
+	for (auto iter = entries.begin(); iter != entries.end();)
+	{
+		if (iter->second.expired())
+			iter = entries.erase(iter);
+		else
+			++iter;
+	}
+}
+
+void GeometryStore::PurgeIfRequired()
+{
+	// the expired entries are removed after as many calls as there are entries, so the cleanup is amortized over the calls
+	if (++this->sharedSincePurge > this->meshes.size() + this->colliders.size())
+		this->Purge();
+}
+
+shared_ptr<const MMesh> GeometryStore::Share(const MMesh & mesh)
+{
+	this->PurgeIfRequired();
+	return Share(this->meshes, Hash(mesh), mesh);
+}
+
+shared_ptr<const MCollider> GeometryStore::Share(const MCollider & collider)
+{
+	this->PurgeIfRequired();
+	return Share(this->colliders, Hash(collider), collider);
+}
+
+size_t GeometryStore::MeshCount() const
+{
+	size_t count = 0;
+	for (const auto &entry : this->meshes)
+	{
+		if (!entry.second.expired())
+			count++;
+	}
+	return count;
+}
+
+size_t GeometryStore::ColliderCount() const
+{
+	size_t count = 0;
+	for (const auto &entry : this->colliders)
+	{
+		if (!entry.second.expired())
+			count++;
+	}
+	return count;
+}
+
+size_t GeometryStore::GetMemoryUsage() const
+{
+	size_t usage = 0;
+	for (const auto &entry : this->meshes)
+	{
+		shared_ptr<const MMesh> mesh = entry.second.lock();
+		if (mesh)
+			usage += sizeof(MMesh) + mesh->Vertices.capacity() * sizeof(MVector3) + mesh->Triangles.capacity() * sizeof(int32_t) + mesh->UVCoordinates.capacity() * sizeof(MVector2);
+	}
+	for (const auto &entry : this->colliders)
+	{
+		shared_ptr<const MCollider> collider = entry.second.lock();
+		if (collider)
+			usage += ::GetMemoryUsage(*collider);
+	}
+	return usage;
+}
+
+void GeometryStore::Purge()
+{
+	Purge(this->meshes);
+	Purge(this->colliders);
+	this->sharedSincePurge = 0;
+}
+
+size_t GeometryStore::Hash(const MMesh & mesh)
+{
+	size_t seed = 0;
+	HashVertices(seed, mesh.Vertices);
+	boost::hash_range(seed, mesh.Triangles.begin(), mesh.Triangles.end());
+	return seed;
+}
+
+size_t GeometryStore::Hash(const MCollider & collider)
+{
+	size_t seed = 0;
+	boost::hash_combine(seed, static_cast<int>(collider.Type));
+	if (collider.__isset.MeshColliderProperties)
+	{
+		HashVertices(seed, collider.MeshColliderProperties.Vertices);
+		boost::hash_range(seed, collider.MeshColliderProperties.Triangles.begin(), collider.MeshColliderProperties.Triangles.end());
+	}
+	if (collider.__isset.Colliders)
+	{
+		for (const MCollider &child : collider.Colliders)
+		{
+			boost::hash_combine(seed, child.ID);
+			boost::hash_combine(seed, Hash(child));
+		}
+	}
+	return seed;
+}
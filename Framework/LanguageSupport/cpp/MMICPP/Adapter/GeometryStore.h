@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "gen-cpp/scene_types.h"
+#include <unordered_map>
+#include <memory>
+
+using namespace MMIStandard;
+using namespace std;
+
+namespace MMIStandard {
+	class GeometryStore
+	{
+		/*
+			Content addressed storage of meshes and colliders.
+			Identical geometry (e.g. the same part placed many times on an assembly line) is stored once and shared by all scene objects using it.
+			The ID of a mesh / collider is usually the id of its scene object, so the shared instances are stored without ID (the ID is kept by the SceneObjectEntry).
+			The store only keeps weak references, a mesh / collider is released as soon as the last scene object using it is gone.
+			The store itself is not synchronized, the shared instances are immutable and can be read from any thread.
+		*/
+	private:
+		//	The stored meshes / colliders structured by the hash of their content, several entries may share a hash
+		unordered_multimap<size_t, weak_ptr<const MMesh>> meshes;
+		unordered_multimap<size_t, weak_ptr<const MCollider>> colliders;
+
+		//	The number of Share calls since the expired entries were removed the last time
+		size_t sharedSincePurge;
+
+	private:
+		//	Returns the shared instance which equals the value, the value is added if there is none
+		template<typename T>
+		static shared_ptr<const T> Share(unordered_multimap<size_t, weak_ptr<const T>> &entries, size_t hash, const T &value);
+
+		//	Removes the entries whose instances have been released
+		template<typename T>
+		static void Purge(unordered_multimap<size_t, weak_ptr<const T>> &entries);
+
+		//	Calls Purge if enough Share calls have been made since the last purge
+		void PurgeIfRequired();
+
+	public:
+		//	Basic constructor
+		GeometryStore();
+
+		GeometryStore(const GeometryStore&) = delete;
+		GeometryStore& operator=(const GeometryStore&) = delete;
+
+		//	Returns the shared instance of the mesh, meshes which only differ in their ID result in the same instance
+		//	The ID of the shared instance is empty
+		shared_ptr<const MMesh> Share(const MMesh &mesh);
+
+		//	Returns the shared instance of the collider, colliders which only differ in their ID result in the same instance
+		//	The ID of the shared instance is empty, the IDs of the child colliders are kept
+		shared_ptr<const MCollider> Share(const MCollider &collider);
+
+		//	Returns the number of distinct meshes / colliders which are currently in use
+		size_t MeshCount() const;
+		size_t ColliderCount() const;
+
+		//	Returns the estimated number of bytes used by the meshes and colliders which are currently in use
+		size_t GetMemoryUsage() const;
+
+		//	Removes the entries whose instances have been released, is done implicitly while new geometry is added
+		void Purge();
+
+		//	Hash functions over the content, the hash covers the geometry without the ID, the remaining fields are only compared on a hash collision
+		static size_t Hash(const MMesh &mesh);
+		static size_t Hash(const MCollider &collider);
+	};
+}
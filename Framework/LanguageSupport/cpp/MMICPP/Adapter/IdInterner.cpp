@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "IdInterner.h"
+#include <stdexcept>
+
+using namespace MMIStandard;
+
+IdInterner::Handle IdInterner::Intern(const string & id)
+{
+	auto iter = this->handlesById.find(id);
+	if (iter != this->handlesById.end())
+		return iter->second;
+
+	if (id.empty())
+	{
+		throw runtime_error("Can not intern an empty id");
+	}
+
+	Handle handle;
+	if (!this->freeHandles.empty())
+	{
+		handle = this->freeHandles.back();
+		this->freeHandles.pop_back();
+		this->idsByHandle[handle] = id;
+	}
+	else
+	{
+		if (this->idsByHandle.size() >= InvalidHandle)
+		{
+			throw runtime_error("Can not intern id " + id + ": no free handle left");
+		}
+		handle = static_cast<Handle>(this->idsByHandle.size());
+		this->idsByHandle.emplace_back(id);
+	}
+	this->handlesById.emplace(id, handle);
+	return handle;
+}
+
+IdInterner::Handle IdInterner::Find(const string & id) const
+{
+	auto iter = this->handlesById.find(id);
+	if (iter == this->handlesById.end())
+		return InvalidHandle;
+
+	return iter->second;
+}
+
+void IdInterner::Release(Handle handle)
+{
+	if (!this->IsValid(handle))
+		return;
+
+	this->handlesById.erase(this->idsByHandle[handle]);
+	this->idsByHandle[handle].clear();
+	this->freeHandles.emplace_back(handle);
+}
+
+const string & IdInterner::GetID(Handle handle) const
+{
+	return this->idsByHandle.at(handle);
+}
+
+bool IdInterner::IsValid(Handle handle) const
+{
+	// interned ids are never empty, an empty id marks a released handle
+	return handle < this->idsByHandle.size() && !this->idsByHandle[handle].empty();
+}
+
+size_t IdInterner::Size() const
+{
+	return this->handlesById.size();
+}
+
+size_t IdInterner::Capacity() const
+{
+	return this->idsByHandle.size();
+}
+
+void IdInterner::Clear()
+{
+	this->handlesById.clear();
+	this->idsByHandle.clear();
+	this->freeHandles.clear();
+}
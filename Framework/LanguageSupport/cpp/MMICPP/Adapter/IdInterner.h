@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+using namespace std;
+
+namespace MMIStandard {
+	class IdInterner
+	{
+		/*
+			Maps string ids (GUIDs) to dense 32 bit handles.
+			An id is hashed once when it is interned, afterwards the handle can be used to index plain vectors.
+			Released handles are reused, so the handles stay dense.
+		*/
+	public:
+		typedef uint32_t Handle;
+
+		//	Handle which is returned for unknown ids
+		static const Handle InvalidHandle = UINT32_MAX;
+
+	private:
+		//	The handles structured by the id
+		unordered_map<string, Handle> handlesById;
+
+		//	The ids structured by the handle, released handles contain an empty string
+		vector<string> idsByHandle;
+
+		//	Released handles which are reused by the next Intern
+		vector<Handle> freeHandles;
+
+	public:
+		//	Returns the handle of the id, a new handle is assigned if the id is unknown
+		Handle Intern(const string &id);
+
+		//	Returns the handle of the id or InvalidHandle if the id is unknown
+		Handle Find(const string &id) const;
+
+		//	Releases the handle of the id, the handle may be assigned to another id afterwards
+		void Release(Handle handle);
+
+		//	Returns the id of the handle
+		const string &GetID(Handle handle) const;
+
+		//	Returns true if the handle is currently assigned to an id
+		bool IsValid(Handle handle) const;
+
+		//	Returns the number of interned ids
+		size_t Size() const;
+
+		//	Returns the upper bound of all handles
+		size_t Capacity() const;
+
+		//	Releases all handles
+		void Clear();
+	};
+}
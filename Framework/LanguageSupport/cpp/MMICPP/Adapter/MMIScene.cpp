@@ -3,23 +3,188 @@
 // Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
 
 #include "MMIScene.h"
+#include "SceneUpdateMerger.h"
 #include "Extensions/MVector3Extensions.h"
 #include "Extensions/MQuaternionExtensions.h"
 #include "boost/exception/diagnostic_information.hpp"
 #include "Utils/Logger.h"
 #include <iostream>
+#include <thread>
 #include "Extensions/MBoolResponseExtensions.h"
 
-MMIScene::MMIScene():frameID{0},historyBufferSize{20}
+MMIScene::MMIScene(size_t historyBufferSize):activeState{0},readerCounts{},sceneHistory{historyBufferSize}
 {
 }
 
-void MMIScene::GetSceneObjects(std::vector<MSceneObject>& _return)
+void MMIScene::SetHistoryBufferSize(size_t historyBufferSize)
+{
+	lock_guard<mutex> lock(this->historyMutex);
+	this->sceneHistory.SetCapacity(historyBufferSize);
+}
+
+int MMIScene::GetFrameID() const
+{
+	lock_guard<mutex> lock(this->historyMutex);
+	return this->sceneHistory.NewestFrameID();
+}
+
+int MMIScene::GetOldestFrameID() const
+{
+	lock_guard<mutex> lock(this->historyMutex);
+	return this->sceneHistory.OldestFrameID();
+}
+
+size_t MMIScene::GetMemoryUsage()
+{
+	// the geometry is only modified by the writers
+	lock_guard<mutex> lock(this->writeMutex);
+
+	size_t usage = 0;
+	this->VisitSceneObjects([&usage](const SceneObjectEntry &entry)
+	{
+		usage += sizeof(SceneObjectEntry) + entry.sceneObject.ID.capacity() + entry.sceneObject.Name.capacity() + entry.meshID.capacity() + entry.colliderID.capacity();
+	});
+	this->VisitAvatars([&usage](const MAvatar &avatar)
+	{
+		usage += sizeof(MAvatar) + avatar.PostureValues.PostureData.capacity() * sizeof(double);
+	});
+
+	// both instances hold the scene objects and avatars, the geometry is shared
+	return 2 * usage + this->geometry.GetMemoryUsage();
+}
+
+bool MMIScene::GetSceneChanges(MSceneUpdate & _return, int fromFrameID, int toFrameID) const
 {
-	for(const pair <string, MSceneObject> &ob: this->sceneObjectsById)
+	// only the shared pointers are copied while the history is locked, the merge runs without the lock
+	vector<shared_ptr<const MSceneUpdate>> updates;
+	{
+		lock_guard<mutex> lock(this->historyMutex);
+		if (!this->sceneHistory.GetUpdates(updates, fromFrameID, toFrameID))
+			return false;
+	}
+
+	if (updates.size() == 1)
 	{
-		_return.emplace_back(ob.second);
+		_return = *updates[0];
+		return true;
 	}
+
+	SceneUpdateMerger merger;
+	for (const auto &update : updates)
+		merger.Append(*update);
+	return merger.GetResult(_return);
+}
+
+MMIScene::ReadGuard::ReadGuard(const MMIScene & scene) :scene{ scene }
+{
+	// register at the published instance and check that it has not been swapped in the meantime,
+	// otherwise the writer may already be modifying the instance and the registration is retried
+	while (true)
+	{
+		this->index = scene.activeState.load();
+		scene.readerCounts[this->index].fetch_add(1);
+		if (scene.activeState.load() == this->index)
+			break;
+		scene.readerCounts[this->index].fetch_sub(1);
+	}
+}
+
+MMIScene::ReadGuard::~ReadGuard()
+{
+	this->scene.readerCounts[this->index].fetch_sub(1);
+}
+
+const SceneState & MMIScene::ReadGuard::State() const
+{
+	return this->scene.states[this->index];
+}
+
+void MMIScene::Write(const function<void(SceneState&)>& write)
+{
+	int published = this->activeState.load();
+	int unpublished = 1 - published;
+
+	// no reader can enter the unpublished instance, the readers of the previous write have already left it
+	write(this->states[unpublished]);
+	this->activeState.store(unpublished);
+
+	// wait until the readers of the previously published instance have left, new readers use the updated instance
+	while (this->readerCounts[published].load() != 0)
+		this_thread::yield();
+
+	write(this->states[published]);
+}
+
+void MMIScene::VisitSceneObjects(const function<void(const SceneObjectEntry&)>& visitor) const
+{
+	ReadGuard guard(*this);
+	guard.State().VisitSceneObjects(visitor);
+}
+
+void MMIScene::VisitSceneObjects(const function<void(const SceneObjectEntry&)>& visitor, int & frameID) const
+{
+	ReadGuard guard(*this);
+	frameID = guard.State().GetFrameID();
+	guard.State().VisitSceneObjects(visitor);
+}
+
+int MMIScene::GetVisibleFrameID() const
+{
+	ReadGuard guard(*this);
+	return guard.State().GetFrameID();
+}
+
+bool MMIScene::VisitSceneObject(const string & id, const function<void(const SceneObjectEntry&)>& visitor) const
+{
+	ReadGuard guard(*this);
+	return guard.State().VisitSceneObject(id, visitor);
+}
+
+bool MMIScene::VisitSceneObjectByName(const string & name, const function<void(const SceneObjectEntry&)>& visitor) const
+{
+	ReadGuard guard(*this);
+	return guard.State().VisitSceneObjectByName(name, visitor);
+}
+
+void MMIScene::VisitSceneObjectsInRange(const MVector3 & position, double range, const function<void(const SceneObjectEntry&)>& visitor) const
+{
+	ReadGuard guard(*this);
+	guard.State().VisitSceneObjectsInRange(position, range, visitor);
+}
+
+void MMIScene::VisitAvatars(const function<void(const MAvatar&)>& visitor) const
+{
+	ReadGuard guard(*this);
+	guard.State().VisitAvatars(visitor);
+}
+
+bool MMIScene::VisitAvatar(const string & id, const function<void(const MAvatar&)>& visitor) const
+{
+	ReadGuard guard(*this);
+	return guard.State().VisitAvatar(id, visitor);
+}
+
+bool MMIScene::VisitAvatarByName(const string & name, const function<void(const MAvatar&)>& visitor) const
+{
+	ReadGuard guard(*this);
+	return guard.State().VisitAvatarByName(name, visitor);
+}
+
+void MMIScene::VisitAvatarsInRange(const MVector3 & position, double range, const function<void(const MAvatar&)>& visitor) const
+{
+	ReadGuard guard(*this);
+	guard.State().VisitAvatarsInRange(position, range, visitor);
+}
+
+void MMIScene::GetSceneObjects(std::vector<MSceneObject>& _return)
+{
+	ReadGuard guard(*this);
+	_return.reserve(_return.size() + guard.State().SceneObjectCount());
+	guard.State().VisitSceneObjects([&](const SceneObjectEntry &entry)
+	{
+		_return.emplace_back();
+		entry.CopyTo(_return.back());
+	});
 }
 
 shared_ptr<vector<MSceneObject>> MMIScene::GetSceneObjects()
@@ -31,9 +196,10 @@ shared_ptr<vector<MSceneObject>> MMIScene::GetSceneObjects()
 
 void MMIScene::GetSceneObjectByID(MSceneObject & _return, const std::string & id)
 {
-	auto iter = this->sceneObjectsById.find(id);
-	if (iter != sceneObjectsById.end())
-		_return = iter->second;
+	this->VisitSceneObject(id, [&](const SceneObjectEntry &entry)
+	{
+		entry.CopyTo(_return);
+	});
 }
 
 shared_ptr<MSceneObject> MMIScene::GetSceneObjectByID(const string & id)
@@ -45,9 +211,10 @@ shared_ptr<MSceneObject> MMIScene::GetSceneObjectByID(const string & id)
 
 void MMIScene::GetSceneObjectByName(MSceneObject & _return, const std::string & name)
 {
-	auto iter = nameIdMappingSceneObjects.find(name);
-	if (iter != nameIdMappingSceneObjects.end())
-		this->GetSceneObjectByID(_return,iter->second[0]);
+	this->VisitSceneObjectByName(name, [&](const SceneObjectEntry &entry)
+	{
+		entry.CopyTo(_return);
+	});
 }
 
 shared_ptr<MSceneObject> MMIScene::GetSceneObjectByName(const string & name)
@@ -59,15 +226,11 @@ shared_ptr<MSceneObject> MMIScene::GetSceneObjectByName(const string & name)
 
 void MMIScene::GetSceneObjectsInRange(std::vector<MSceneObject>& _return, const::MMIStandard::MVector3 & position, const double range)
 {
-	vector<MSceneObject> objects;
-	this->GetSceneObjects(objects);
-	for (const MSceneObject &ob : objects)
+	this->VisitSceneObjectsInRange(position, range, [&](const SceneObjectEntry &entry)
 	{
-		if (MVector3Extensions::EuclideanDistance(ob.Transform.Position, position) <= range)
-		{
-			_return.emplace_back(ob);
-		}	
-	}
+		_return.emplace_back();
+		entry.CopyTo(_return.back());
+	});
 }
 
 shared_ptr<vector<MSceneObject>> MMIScene::GetSceneObjectsInRange(const MVector3 & position, const double range)
@@ -79,13 +242,24 @@ shared_ptr<vector<MSceneObject>> MMIScene::GetSceneObjectsInRange(const MVector3
 
 void MMIScene::GetColliders(std::vector<MCollider>& _return)
 {
-	vector<MSceneObject> sceneObjects;
-	this->GetSceneObjects(sceneObjects);
+	ReadGuard guard(*this);
+	_return.reserve(_return.size() + guard.State().SceneObjectCount());
+	guard.State().VisitSceneObjects([&](const SceneObjectEntry &entry)
+	{
+		_return.emplace_back();
+		entry.CopyCollider(_return.back());
+	});
+}
 
-	for (const MSceneObject &ob : sceneObjects)
+void MMIScene::GetColliders(vector<shared_ptr<const MCollider>>& _return) const
+{
+	ReadGuard guard(*this);
+	_return.reserve(_return.size() + guard.State().SceneObjectCount());
+	guard.State().VisitSceneObjects([&](const SceneObjectEntry &entry)
 	{
-		_return.emplace_back(ob.Collider);
-	}
+		if (entry.collider)
+			_return.emplace_back(entry.collider);
+	});
 }
 
 shared_ptr<vector<MCollider>> MMIScene::GetColliders()
@@ -97,9 +271,20 @@ shared_ptr<vector<MCollider>> MMIScene::GetColliders()
 
 void MMIScene::GetColliderById(MCollider & _return, const std::string & id)
 {
-	MSceneObject sceneObject;
-	this->GetSceneObjectByID(sceneObject, id);
-	_return = sceneObject.Collider;
+	this->VisitSceneObject(id, [&](const SceneObjectEntry &entry)
+	{
+		entry.CopyCollider(_return);
+	});
+}
+
+shared_ptr<const MCollider> MMIScene::GetSharedColliderByID(const string & id) const
+{
+	shared_ptr<const MCollider> _return;
+	this->VisitSceneObject(id, [&](const SceneObjectEntry &entry)
+	{
+		_return = entry.collider;
+	});
+	return _return;
 }
 
 shared_ptr<MCollider> MMIScene::GetColliderById(const string & id)
@@ -111,16 +296,14 @@ shared_ptr<MCollider> MMIScene::GetColliderById(const string & id)
 
 void MMIScene::GetCollidersInRange(std::vector<MCollider>& _return, const::MMIStandard::MVector3 & position, const double range)
 {
-	vector<MSceneObject> sceneObjects;
-	this->GetSceneObjectsInRange(sceneObjects, position, range);
-
-	for (const MSceneObject &ob : sceneObjects)
+	this->VisitSceneObjectsInRange(position, range, [&](const SceneObjectEntry &entry)
 	{
-		if (ob.__isset.Collider)
+		if (entry.collider)
 		{
-			_return.emplace_back(ob.Collider);
+			_return.emplace_back();
+			entry.CopyCollider(_return.back());
 		}
-	}
+	});
 }
 
 shared_ptr<vector<MCollider>> MMIScene::GetCollidersInRange(const::MMIStandard::MVector3 & position, const double range)
@@ -132,10 +315,24 @@ shared_ptr<vector<MCollider>> MMIScene::GetCollidersInRange(const::MMIStandard::
 
 void MMIScene::GetMeshes(std::vector<MMesh>& _return)
 {
-	vector<MSceneObject> sceneObjects;
-	this->GetSceneObjects(sceneObjects);
-	for (const MSceneObject &sceneObject: sceneObjects)
-		_return.emplace_back(sceneObject.Mesh);
+	ReadGuard guard(*this);
+	_return.reserve(_return.size() + guard.State().SceneObjectCount());
+	guard.State().VisitSceneObjects([&](const SceneObjectEntry &entry)
+	{
+		_return.emplace_back();
+		entry.CopyMesh(_return.back());
+	});
+}
+
+void MMIScene::GetMeshes(vector<shared_ptr<const MMesh>>& _return) const
+{
+	ReadGuard guard(*this);
+	_return.reserve(_return.size() + guard.State().SceneObjectCount());
+	guard.State().VisitSceneObjects([&](const SceneObjectEntry &entry)
+	{
+		if (entry.mesh)
+			_return.emplace_back(entry.mesh);
+	});
 }
 
 shared_ptr<vector<MMesh>> MMIScene::GetMeshes()
@@ -147,9 +344,20 @@ shared_ptr<vector<MMesh>> MMIScene::GetMeshes()
 
 void MMIScene::GetMeshByID(MMesh & _return, const std::string & id)
 {
-	MSceneObject sceneObject;
-	this->GetSceneObjectByID(sceneObject, id);
-	_return = sceneObject.Mesh;
+	this->VisitSceneObject(id, [&](const SceneObjectEntry &entry)
+	{
+		entry.CopyMesh(_return);
+	});
+}
+
+shared_ptr<const MMesh> MMIScene::GetSharedMeshByID(const string & id) const
+{
+	shared_ptr<const MMesh> _return;
+	this->VisitSceneObject(id, [&](const SceneObjectEntry &entry)
+	{
+		_return = entry.mesh;
+	});
+	return _return;
 }
 
 shared_ptr<MMesh> MMIScene::GetMeshByID(const std::string & id)
@@ -161,10 +369,8 @@ shared_ptr<MMesh> MMIScene::GetMeshByID(const std::string & id)
 
 void MMIScene::GetTransforms(std::vector<MTransform>& _return)
 {
-	vector<MSceneObject> sceneObjects;
-	this->GetSceneObjects(sceneObjects);
-	for (const MSceneObject &sceneObject : sceneObjects)
-		_return.emplace_back(sceneObject.Transform);
+	ReadGuard guard(*this);
+	guard.State().GetTransforms(_return);
 }
 
 shared_ptr<vector<MTransform>> MMIScene::GetTransforms()
@@ -176,9 +382,8 @@ shared_ptr<vector<MTransform>> MMIScene::GetTransforms()
 
 void MMIScene::GetTransformByID(MTransform & _return, const std::string & id)
 {
-	MSceneObject sceneObject;
-	this->GetSceneObjectByID(sceneObject, id);
-	_return = sceneObject.Transform;
+	ReadGuard guard(*this);
+	guard.State().GetTransformByID(_return, id);
 }
 
 shared_ptr<MTransform> MMIScene::GetTransformByID(string & id)
@@ -190,10 +395,12 @@ shared_ptr<MTransform> MMIScene::GetTransformByID(string & id)
 
 void MMIScene::GetAvatars(std::vector<MAvatar>& _return)
 {
-	for(const auto &ob : this->avatarsById)
+	ReadGuard guard(*this);
+	_return.reserve(_return.size() + guard.State().AvatarCount());
+	guard.State().VisitAvatars([&](const MAvatar &avatar)
 	{
-		_return.emplace_back(ob.second);
-	}
+		_return.emplace_back(avatar);
+	});
 }
 
 shared_ptr<vector<MAvatar>> MMIScene::GetAvatars()
@@ -205,9 +412,10 @@ shared_ptr<vector<MAvatar>> MMIScene::GetAvatars()
 
 void MMIScene::GetAvatarByID(MAvatar & _return, const std::string & id)
 {
-	auto iter = this->avatarsById.find(id);
-	if (iter != avatarsById.end())
-		_return = iter->second;
+	this->VisitAvatar(id, [&](const MAvatar &avatar)
+	{
+		_return = avatar;
+	});
 }
 
 shared_ptr<MAvatar> MMIScene::GetAvatarByID(const string & id)
@@ -219,9 +427,10 @@ shared_ptr<MAvatar> MMIScene::GetAvatarByID(const string & id)
 
 void MMIScene::GetAvatarByName(MAvatar & _return, const std::string & name)
 {
-	auto iter = nameIdMappingAvatars.find(name);
-	if (iter != nameIdMappingAvatars.end())
-		this->GetAvatarByID(_return, iter->second[0]);
+	this->VisitAvatarByName(name, [&](const MAvatar &avatar)
+	{
+		_return = avatar;
+	});
 }
 
 shared_ptr<MAvatar> MMIScene::GetAvatarByName(const string & name)
@@ -233,21 +442,10 @@ shared_ptr<MAvatar> MMIScene::GetAvatarByName(const string & name)
 
 void MMIScene::GetAvatarsInRange(std::vector<MAvatar>& _return, const::MMIStandard::MVector3 & position, const double distance)
 {
-	vector<MAvatar> avatars;
-	this->GetAvatars(avatars);
-
-	for (MAvatar avatar : avatars)
+	this->VisitAvatarsInRange(position, distance, [&](const MAvatar &avatar)
 	{
-		MVector3 avatarPosition = MVector3{};
-		avatarPosition.__set_X(avatar.PostureValues.PostureData[0]);
-		avatarPosition.__set_Y(avatar.PostureValues.PostureData[1]);
-		avatarPosition.__set_Z(avatar.PostureValues.PostureData[3]);
-
-		if (MVector3Extensions::EuclideanDistance(avatarPosition, position) <= distance)
-		{
-			_return.emplace_back(avatar);
-		}
-	}
+		_return.emplace_back(avatar);
+	});
 }
 
 shared_ptr<vector<MAvatar>> MMIScene::GetAvatarsInRange(const::MMIStandard::MVector3 & position, const double distance)
@@ -264,21 +462,61 @@ double MMIScene::GetSimulationTime()
 
 void MMIScene::GetSceneChanges(MSceneUpdate & _return)
 {
-	_return = this->sceneUpdate;
+	shared_ptr<const MSceneUpdate> lastUpdate = atomic_load(&this->sceneUpdate);
+	if (lastUpdate != nullptr)
+		_return = *lastUpdate;
 }
 
 shared_ptr<MSceneUpdate> MMIScene::GetSceneChanges()
 {
-	return make_shared<MSceneUpdate>(this->sceneUpdate);
+	auto _return = make_shared<MSceneUpdate>();
+	this->GetSceneChanges(*_return);
+	return _return;
 }
 
 
 //TODO check
 void MMIScene::GetFullScene(MSceneUpdate & _return)
 {
+	int frameID;
+	this->GetFullScene(_return, frameID);
+}
+
+void MMIScene::GetFullScene(MSceneUpdate & _return, int & frameID) const
+{
+	ReadGuard guard(*this);
+	const SceneState &state = guard.State();
+	frameID = state.GetFrameID();
+
+	_return.AddedSceneObjects.reserve(state.SceneObjectCount());
+	state.VisitSceneObjects([&](const SceneObjectEntry &entry)
+	{
+		_return.AddedSceneObjects.emplace_back();
+		entry.CopyTo(_return.AddedSceneObjects.back());
+	});
+	_return.__isset.AddedSceneObjects = true;
 
-	this->GetSceneObjects(_return.AddedSceneObjects);
-	this->GetAvatars(_return.AddedAvatars);
+	_return.AddedAvatars.reserve(state.AvatarCount());
+	state.VisitAvatars([&](const MAvatar &avatar)
+	{
+		_return.AddedAvatars.emplace_back(avatar);
+	});
+	_return.__isset.AddedAvatars = true;
+}
+
+bool MMIScene::GetSceneChangesSince(MSceneUpdate & _return, int sinceFrameID, int & frameID) const
+{
+	int currentFrameID = this->GetFrameID();
+	if (this->GetSceneChanges(_return, sinceFrameID, currentFrameID))
+	{
+		frameID = currentFrameID;
+		return true;
+	}
+
+	// the frame has aged out (or the changes can not be merged), the caller has to resynchronize
+	_return = MSceneUpdate();
+	this->GetFullScene(_return, frameID);
+	return false;
 }
 
 shared_ptr<MSceneUpdate> MMIScene::GetFullScene()
@@ -300,236 +538,76 @@ shared_ptr<MNavigationMesh> MMIScene::GetNavigationMesh()
 
 void MMIScene::Clear()
 {
-	this->avatarsById.clear();
-	this->sceneObjectsById.clear();
-	this->nameIdMappingAvatars.clear();
-	this->nameIdMappingSceneObjects.clear();
-	this->sceneUpdate.~MSceneUpdate();
-	this->sceneUpdate =  MSceneUpdate{};
-	this->frameID = 0;
-	this->sceneHistory.clear();
+	lock_guard<mutex> lock(this->writeMutex);
+	this->Write([](SceneState &state)
+	{
+		state.Clear();
+	});
+	atomic_store(&this->sceneUpdate, shared_ptr<const MSceneUpdate>());
+	lock_guard<mutex> historyLock(this->historyMutex);
+	this->sceneHistory.Clear();
 }
 
 void MMIScene::Apply(MBoolResponse & _return, const MSceneUpdate & sceneUpdate)
 {
-	_return.__set_Successful(true);
-	this->frameID++;
-	this->sceneHistory.emplace_front(pair(frameID, sceneUpdate));
-	while (this->sceneHistory.size() > (size_t)this->historyBufferSize)
-		sceneHistory.pop_back();
-
-	this->sceneUpdate = sceneUpdate;
-
-	if(sceneUpdate.__isset.AddedAvatars)
-		this->AddAvatars(_return,sceneUpdate.AddedAvatars);
-	
-	if (sceneUpdate.__isset.AddedSceneObjects)
-		this->AddSceneObjects(_return, sceneUpdate.AddedSceneObjects);
-
-	if (sceneUpdate.__isset.ChangedAvatars)
-		this->UpdataAvatars(_return,sceneUpdate.ChangedAvatars);
-
-	if (sceneUpdate.__isset.ChangedSceneObjects)
-		this->UpdateSceneObjects(_return,sceneUpdate.ChangedSceneObjects);
-
-	if (sceneUpdate.__isset.RemovedAvatars)
-		this->RemoveAvatars(_return,sceneUpdate.RemovedAvatars);
-
-	if (sceneUpdate.__isset.RemovedSceneObjects)
-		this->RemoveSceneObjects(_return,sceneUpdate.RemovedSceneObjects);
+	this->Apply(_return, make_shared<const MSceneUpdate>(sceneUpdate));
 }
 
-
-void MMIScene::AddAvatars(MBoolResponse & _return, const vector<MAvatar>& avatars)
+void MMIScene::Apply(MBoolResponse & _return, MSceneUpdate && sceneUpdate)
 {
-	
-	for (const MAvatar &avatar : avatars)
-	{
-		if(!this->avatarsById.insert(std::pair<string, MAvatar>(avatar.ID, avatar)).second) // try to insert new avatar return is false if avatar is already in the map
-		{
-			string message = "Could not add avatar: " + avatar.Name + " is already registered";
-			Logger::printLog(L_ERROR, message);
-			MBoolResponseExtensions::Update(_return, message, false);
-			continue;
-		}
-
-		auto iter1 = this->nameIdMappingAvatars.find(avatar.Name);
-		if (iter1 != nameIdMappingAvatars.end()) // contains already the avatar
-		{
-			
-			if (!(std::find(iter1->second.begin(), iter1->second.end(), avatar.ID) != iter1->second.end()))
-				this->nameIdMappingAvatars[avatar.Name].emplace_back(avatar.ID);
-		}
-		else
-		{
-			nameIdMappingAvatars.insert(std::pair < string, vector<string>>(avatar.Name, vector<string>{avatar.ID}));
-		}
-	}
+	// the thrift types have no move constructor, the generated swap exchanges the members without copying
+	auto update = make_shared<MSceneUpdate>();
+	swap(*update, sceneUpdate);
+	this->Apply(_return, shared_ptr<const MSceneUpdate>(move(update)));
 }
 
-void MMIScene::AddSceneObjects(MBoolResponse & _return, const vector<MSceneObject>& sceneObjects)
+void MMIScene::Apply(MBoolResponse & _return, shared_ptr<const MSceneUpdate> sceneUpdatePtr)
 {
-	for (const MSceneObject &sceneObject: sceneObjects)
-	{
-		if (!this->sceneObjectsById.insert(std::pair<string, MSceneObject>(sceneObject.ID, sceneObject)).second)
-		{
-			string message = "Could not add scene object: " + sceneObject.Name + " is already registered";
-			Logger::printLog(L_ERROR, message);
-			MBoolResponseExtensions::Update(_return, message, false);
-			continue;
-		}
-
-		auto iter1 = this->nameIdMappingSceneObjects.find(sceneObject.Name);
-		if (iter1 != nameIdMappingSceneObjects.end())
-		{
-			if (!(std::find(iter1->second.begin(), iter1->second.end(), sceneObject.ID) != iter1->second.end()))
-				this->nameIdMappingSceneObjects[sceneObject.Name].emplace_back( sceneObject.ID );
-		}
-		else
-		{
-			nameIdMappingSceneObjects.insert(std::pair < string, vector<string>>(sceneObject.Name, vector<string>{sceneObject.ID}));
-		}
-	}
-}
+	const MSceneUpdate &sceneUpdate = *sceneUpdatePtr;
+	lock_guard<mutex> lock(this->writeMutex);
+	_return.__set_Successful(true);
 
-void MMIScene::UpdataAvatars(MBoolResponse & _return, const vector<MAvatarUpdate>& avatars)
-{
-	for (MAvatarUpdate avatarUpdate : avatars)
+	// only the writers append to the history, so the id of the next frame is known before it is applied
+	int frameID;
 	{
-		auto iter = this->avatarsById.find(avatarUpdate.ID);
-		if (iter != avatarsById.end())
-		{
-			if (avatarUpdate.__isset.Description)
-				iter->second.Description = avatarUpdate.Description;
-
-			if (avatarUpdate.__isset.PostureValues)
-				iter->second.PostureValues = avatarUpdate.PostureValues;
-
-			if (avatarUpdate.__isset.SceneObjects)
-				iter->second.SceneObjects = avatarUpdate.SceneObjects;
-		}
-		else
-		{
-			string message = "Could not update avatar : " + avatarUpdate.ID + " not found";
-			Logger::printLog(L_ERROR, message);
-			MBoolResponseExtensions::Update(_return, message, false);
-		}
+		lock_guard<mutex> historyLock(this->historyMutex);
+		frameID = this->sceneHistory.NewestFrameID() + 1;
 	}
-}
 
-void MMIScene::UpdateSceneObjects(MBoolResponse & _return, const vector<MSceneObjectUpdate>& sceneObjects)
-{
-	for (MSceneObjectUpdate sceneObjectUpdate : sceneObjects)
+	// the geometry is shared once and referenced by both instances
+	SharedGeometry sharedGeometry(this->geometry, sceneUpdate);
+
+	// both instances report the same failures, only the response of the first one is returned
+	bool first = true;
+	this->Write([&](SceneState &state)
 	{
-		auto iter = this->sceneObjectsById.find(sceneObjectUpdate.ID);
-		if (iter != sceneObjectsById.end())
+		state.SetFrameID(frameID);
+		if (first)
 		{
-			if (sceneObjectUpdate.__isset.Transform)
-			{
-				MTransformUpdate transformUpdate = sceneObjectUpdate.Transform;
-				try
-				{
-					if(transformUpdate.__isset.Position)
-						MVector3Extensions::ToMVector3(iter->second.Transform.Position, sceneObjectUpdate.Transform.Position);
-					
-					if(transformUpdate.__isset.Rotation)
-						MQuaternionExtensions::ToMQuaternion(iter->second.Transform.Rotation, sceneObjectUpdate.Transform.Rotation);
-				}
-				catch (...)
-				{
-					std::clog << boost::current_exception_diagnostic_information() << std::endl;
-					_return.__set_Successful(false);
-					if (_return.__isset.LogData)
-					{
-						_return.LogData.emplace_back(boost::current_exception_diagnostic_information());
-					}
-					else
-					{
-						_return.__set_LogData(vector<string>{ boost::current_exception_diagnostic_information() });
-					}
-				}
-				if (transformUpdate.__isset.Parent)
-					iter->second.Transform.Parent = sceneObjectUpdate.Transform.Parent;
-			}
-
-			if (sceneObjectUpdate.__isset.Collider)
-				iter->second.Collider=sceneObjectUpdate.Collider;
-
-			if (sceneObjectUpdate.__isset.Mesh)
-				iter->second.Mesh = sceneObjectUpdate.Mesh;
-
-			if (sceneObjectUpdate.__isset.PhysicsProperties)
-				iter->second.PhysicsProperties = sceneObjectUpdate.PhysicsProperties;
+			state.Apply(_return, sceneUpdate, sharedGeometry);
+			first = false;
 		}
 		else
 		{
-			string message = "Could not update scene object: " + sceneObjectUpdate.ID + " object not found";
-			Logger::printLog(L_ERROR, message);
-			MBoolResponseExtensions::Update(_return, message, false);
+			MBoolResponse ignored;
+			state.Apply(ignored, sceneUpdate, sharedGeometry);
 		}
-	}
-}
-
-void MMIScene::RemoveAvatars(MBoolResponse & _return, const vector<string>& avatarIDs)
-{
-	MBoolResponse response{};
-	response.Successful = true;
+	});
 
-	for (string id : avatarIDs)
+	// the frame is reported once the readers can see it, otherwise a reader could label the previous frame with its id
 	{
-		auto avatarIter = this->avatarsById.find(id);
-		if (avatarIter != avatarsById.end()) //pos avatar in avatarsById
-		{
-			auto nameIdIter = this->nameIdMappingAvatars.find(avatarIter->second.Name);
-			if (nameIdIter != nameIdMappingAvatars.end()) //pos vector<string> of ids
-			{
-				auto idIter = std::find(nameIdIter->second.begin(), nameIdIter->second.end(), id); //pos string in the ids vector<string>
-				if (idIter != nameIdIter->second.end())
-					nameIdIter->second.erase(idIter);
-			}
-
-			avatarsById.erase(avatarIter);
-		}
-		else
-		{
-			string message = "could not remove avatar: " + id + " not found";
-			Logger::printLog(L_ERROR, message);
-			MBoolResponseExtensions::Update(_return, message, false);
-		}
+		lock_guard<mutex> historyLock(this->historyMutex);
+		this->sceneHistory.Append(sceneUpdatePtr);
 	}
+	atomic_store(&this->sceneUpdate, move(sceneUpdatePtr));
 
-}
-
-void MMIScene::RemoveSceneObjects(MBoolResponse & _return, const vector<string>& sceneObjectIDs)
-{
-	MBoolResponse response{};
-	response.Successful = true;
-
-	for (string id : sceneObjectIDs)
+	if (_return.__isset.LogData)
 	{
-		auto iter = this->sceneObjectsById.find(id);
-		if (iter != sceneObjectsById.end())
-		{
-			auto iter1 = this->nameIdMappingSceneObjects.find(iter->second.Name);
-			if (iter1 != nameIdMappingSceneObjects.end())
-			{
-				auto iter2 = std::find(iter1->second.begin(), iter1->second.end(), id);
-				if (iter2 != iter1->second.end())
-					iter1->second.erase(iter2);
-			}
-
-			sceneObjectsById.erase(iter);
-		}
-		else
-		{
-			string message = "could not remove scene object:  " + id + " not found";
+		for (const string &message : _return.LogData)
 			Logger::printLog(L_ERROR, message);
-			MBoolResponseExtensions::Update(_return, message, false);
-		}
 	}
 }
 
-
 // new functions in MSceneAccessIf, sadam
 void MMIScene::GetData(std::string& _return, const std::string& fileFormat, const std::string& selection)
 {
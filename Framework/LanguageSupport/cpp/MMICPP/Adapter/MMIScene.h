@@ -5,7 +5,12 @@
 #pragma once
 #include "gen-cpp/MSceneAccess.h"
 #include "gen-cpp/scene_types.h"
-#include <unordered_map>
+#include "SceneState.h"
+#include "SceneHistory.h"
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <mutex>
 
 using namespace MMIStandard;
 using namespace std;
@@ -17,67 +22,144 @@ namespace MMIStandard {
 			Class represents a (hyptothetical) scene which can be specifically set up by the developer
 		*/
 	private:
-		//	Map contains all scene objects structured by the specific id
-		unordered_map<string, MSceneObject> sceneObjectsById;
+		/*
+			Readers and the writer are synchronized with two instances of the scene content (left-right scheme):
+			the readers use the published instance without locking while Apply updates the other instance,
+			publishes it and replays the update on the previous instance as soon as its last reader has left.
+		*/
+
+		//	The meshes and colliders of both instances, identical geometry is stored once
+		//	Is only modified by the writer, which shares the geometry of an update once for both instances (see SharedGeometry)
+		//	The readers only access the shared immutable instances
+		GeometryStore geometry;
+
+		//	The two instances of the scene content
+		SceneState states[2];
 
-		//	Map containing all avatars structured by the specific id
-		unordered_map<string, MAvatar> avatarsById;
+		//	The index of the instance which is published to the readers
+		atomic<int> activeState;
 
-		//	Mapping between the name of a scene object and a unique id
-		unordered_map<string, vector<string>> nameIdMappingSceneObjects;
+		//	The number of readers which currently use each instance
+		mutable atomic<int> readerCounts[2];
 
-		//	Mapping between the name of a avatar and a unique id
-		unordered_map<string, vector<string>> nameIdMappingAvatars;
+		//	Serializes the writers
+		mutex writeMutex;
 
-		//	MSceneUpdate from the previous frame
-		MSceneUpdate sceneUpdate;
+		//	MSceneUpdate from the previous frame, is exchanged atomically
+		shared_ptr<const MSceneUpdate> sceneUpdate;
 
-		//	ID of the frame
-		int frameID;
+		//	Ring buffer which contains the history of the last n applied scene manipulations and the id of the current frame
+		SceneHistory sceneHistory;
 
-		//	The size of the HistoryBuffer
-		int historyBufferSize;
+		//	Protects the sceneHistory, is only held while the shared updates are accessed
+		mutable mutex historyMutex;
 
-		//	A list  which contains the history of the last n applied scene manipulations
-		list<pair<int, MSceneUpdate>>sceneHistory;
+		//	Scoped access to the published instance, the instance is not modified while the guard exists
+		class ReadGuard
+		{
+			const MMIScene &scene;
+			int index;
+		public:
+			ReadGuard(const MMIScene &scene);
+			~ReadGuard();
+			ReadGuard(const ReadGuard&) = delete;
+			ReadGuard& operator=(const ReadGuard&) = delete;
+			const SceneState &State() const;
+		};
 
 	private:
-		//	Removes all scene objects from the scene
-		//	<param name="sceneObjectIDs">The IDs of the scene objects which schould be removed</param>
-		void RemoveSceneObjects(MBoolResponse & _return, const vector<string>& sceneObjectIDs);
+		//	Applies the write operation on both instances, the caller has to hold the writeMutex
+		//	<param name="write">Is called once for each instance, starting with the unpublished one</param>
+		void Write(const function<void(SceneState &)> &write);
 
 		//	Clears the whole scene
 		void Clear();
 
-		//	Adds all avatars to the scene
-		//	<param name="avatars">The avatars which should be added</param>
-		void AddAvatars(MBoolResponse & _return, const vector<MAvatar>& avatars);
+		//	Records the update in the history and applies it on both instances
+		//	<param name="sceneUpdate">The scene manipulation, is shared with the history and must not be modified afterwards</param>
+		void Apply(MBoolResponse &_return, shared_ptr<const MSceneUpdate> sceneUpdate);
 
-		//	Adds all scene objects to the scene
-		//	<param name="sceneObjects>The scene objects which should be added</param>
-		void AddSceneObjects(MBoolResponse & _return, const vector<MSceneObject>& sceneObjects);
+	public:
+		//	Basic Constructor
+		//	<param name="historyBufferSize">The number of scene manipulations which are kept in the history</param>
+		MMIScene(size_t historyBufferSize = 20);
 
-		//	Updates all avatars
-		//	<param name="avatars>The avatars which should be updated</param>
-		void UpdataAvatars(MBoolResponse & _return, const vector<MAvatarUpdate>& avatars);
+		//	Changes the number of scene manipulations which are kept in the history, the newest ones are kept
+		void SetHistoryBufferSize(size_t historyBufferSize);
 
-		//	Updates all scene objects
-		//	<param name="avatars>The scene objects which should be updated</param>
-		void UpdateSceneObjects(MBoolResponse & _return, const vector<MSceneObjectUpdate>& sceneObjects);
+		//	Returns the id of the current frame, every applied scene manipulation increments the id, the empty scene has the id 0
+		//	The id is incremented once the readers see the manipulation, a reader may already see the next frame but never an older one
+		int GetFrameID() const;
 
-		//	Removes all scene objects from the scene
-		//	<param name="avatarIDs">The IDs of the avatars which schould be removed</param>
-		void RemoveAvatars(MBoolResponse & _return, const vector<string>& avatarIDs);
+		//	Returns the id of the oldest frame which can be used as start of GetSceneChanges
+		int GetOldestFrameID() const;
 
+		//	Returns the estimated number of bytes used by the scene objects, avatars and their geometry
+		size_t GetMemoryUsage();
 
-	public:
-		//	Basic Constructor
-		MMIScene();
+		//	Returns the merged scene manipulations which turn the scene of one frame into the scene of a later frame
+		//	<param name="fromFrameID">The frame the changes start at</param>
+		//	<param name="toFrameID">The frame the changes end at</param>
+		//	Returns false if a frame is outside of the history or the manipulations can not be expressed by a single update
+		bool GetSceneChanges(MSceneUpdate &_return, int fromFrameID, int toFrameID) const;
+
+		//	Returns the merged scene manipulations since the given frame up to the current frame
+		//	If the frame is not retained in the history anymore the full scene is returned instead (see GetFullScene)
+		//	<param name="sinceFrameID">The last frame known by the caller</param>
+		//	<param name="frameID">Is set to the id of the frame the returned update leads to</param>
+		//	Returns true if _return contains the changes, false if it contains the full scene
+		bool GetSceneChangesSince(MSceneUpdate &_return, int sinceFrameID, int &frameID) const;
+
+		//	Returns all sceneobjects and avatars of one frame as MSceneUpdate
+		//	<param name="frameID">Is set to the id of the returned frame</param>
+		void GetFullScene(MSceneUpdate &_return, int &frameID) const;
 
 		//Applies the scene manipulation on the scene
 		// <param name="sceneUpdates">The scene manipulations to be considered</param>
 		void Apply(MBoolResponse &_return, const MSceneUpdate &scene);
 
+		//	Applies the scene manipulation on the scene without copying it, the content of the update is taken over
+		// <param name="sceneUpdates">The scene manipulations to be considered, is empty afterwards</param>
+		void Apply(MBoolResponse &_return, MSceneUpdate &&scene);
+
+
+		//	Read views for in-process access (e.g. C++ MMUs casting their sceneAccess to MMIScene)
+		//	The visitors receive references into the scene storage, nothing is copied or allocated.
+		//	The mesh and the collider of a scene object are shared with identical scene objects and are referenced by the SceneObjectEntry.
+		//	The references are only valid during the call of the visitor and must not be stored.
+		//	The visitors run on a consistent frame and may be called concurrently to Apply, a long running visitor delays the next Apply.
+
+		//	Calls the visitor for every scene object
+		void VisitSceneObjects(const function<void(const SceneObjectEntry &)> &visitor) const;
+
+		//	Calls the visitor for every scene object
+		//	<param name="frameID">The frame of the visited scene objects</param>
+		void VisitSceneObjects(const function<void(const SceneObjectEntry &)> &visitor, int &frameID) const;
+
+		//	Returns the frame the readers currently see, may already be the frame which is being applied (see GetFrameID)
+		int GetVisibleFrameID() const;
+
+		//	Calls the visitor for the scene object with the given id, returns false if the id is unknown
+		bool VisitSceneObject(const string &id, const function<void(const SceneObjectEntry &)> &visitor) const;
+
+		//	Calls the visitor for the first scene object with the given name, returns false if the name is unknown
+		bool VisitSceneObjectByName(const string &name, const function<void(const SceneObjectEntry &)> &visitor) const;
+
+		//	Calls the visitor for every scene object within the range of the position
+		void VisitSceneObjectsInRange(const MVector3 &position, double range, const function<void(const SceneObjectEntry &)> &visitor) const;
+
+		//	Calls the visitor for every avatar
+		void VisitAvatars(const function<void(const MAvatar &)> &visitor) const;
+
+		//	Calls the visitor for the avatar with the given id, returns false if the id is unknown
+		bool VisitAvatar(const string &id, const function<void(const MAvatar &)> &visitor) const;
+
+		//	Calls the visitor for the first avatar with the given name, returns false if the name is unknown
+		bool VisitAvatarByName(const string &name, const function<void(const MAvatar &)> &visitor) const;
+
+		//	Calls the visitor for every avatar within the range of the position
+		void VisitAvatarsInRange(const MVector3 &position, double range, const function<void(const MAvatar &)> &visitor) const;
+
 
 		//	Inherited via MSceneAccessIf
 
@@ -101,10 +183,18 @@ namespace MMIStandard {
 		virtual void GetColliders(std::vector<MCollider>& _return) override;
 		shared_ptr<vector<MCollider>> GetColliders();
 
+		//	Returns the shared colliders of the scene objects without copying them, scene objects without collider are skipped
+		//	The shared instances have no ID (see GeometryStore)
+		void GetColliders(vector<shared_ptr<const MCollider>> &_return) const;
+
 		//	Returns the collider of the scene object based on the id
 		virtual void GetColliderById(MCollider & _return, const std::string & id) override;
 		shared_ptr<MCollider> GetColliderById(const string &id);
 
+		//	Returns the shared collider of the scene object without copying it, nullptr if the id is unknown or the scene object has no collider
+		//	The shared instance has no ID (see GeometryStore)
+		shared_ptr<const MCollider> GetSharedColliderByID(const string &id) const;
+
 		//	Returns the collider of the scene objects based on the range
 		virtual void GetCollidersInRange(std::vector<MCollider>& _return, const::MMIStandard::MVector3 & position, const double range) override;
 		shared_ptr <vector<MCollider>> GetCollidersInRange(const::MMIStandard::MVector3 & position, const double range);
@@ -113,10 +203,18 @@ namespace MMIStandard {
 		virtual void GetMeshes(std::vector<MMesh>& _return) override;
 		shared_ptr<vector<MMesh>> GetMeshes();
 
+		//	Returns the shared meshes of the scene objects without copying them, scene objects without mesh are skipped
+		//	Identical meshes are returned as the same instance without ID
+		void GetMeshes(vector<shared_ptr<const MMesh>> &_return) const;
+
 		//	Returns the meshes of the scene object based on the id
 		virtual void GetMeshByID(MMesh & _return, const std::string & id) override;
 		shared_ptr<MMesh>GetMeshByID(const std::string & id);
 
+		//	Returns the shared mesh of the scene object without copying it, nullptr if the id is unknown or the scene object has no mesh
+		//	The shared instance has no ID (see GeometryStore)
+		shared_ptr<const MMesh> GetSharedMeshByID(const string &id) const;
+
 		//	Returns the transforms of the scene objects
 		virtual void GetTransforms(std::vector<MTransform>& _return) override;
 		shared_ptr<vector<MTransform>> GetTransforms();
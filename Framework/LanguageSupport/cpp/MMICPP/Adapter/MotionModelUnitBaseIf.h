@@ -73,7 +73,7 @@ public:
 };
 
 // Method must be implemented in the cpp file
-// specify name and id here
+// specify name and id here, on Linux the export is declared without __declspec(dllexport) and __cdecl
 //extern "C" __declspec(dllexport) MotionModelUnitBaseIf* __cdecl instantiate()
 //{
 //	return new MotionModelUnitBaseIf{ "C++TestMMU",1337 };
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "RpcMetrics.h"
+#include "Utils/Logger.h"
+#include <cstring>
+#include <exception>
+
+using namespace MMIStandard;
+
+//initialize static members
+array<CallMetrics, R_COUNT> RpcMetrics::methods;
+unordered_map<string, unique_ptr<array<CallMetrics, R_COUNT>>> RpcMetrics::mmus;
+shared_mutex RpcMetrics::mmusLock;
+thread RpcMetrics::dumpThread;
+mutex RpcMetrics::dumpLock;
+condition_variable RpcMetrics::dumpStop;
+bool RpcMetrics::dumpStopping = false;
+
+const array<string, R_COUNT> RpcMetrics::MethodNames =
+{
+	"Initialize",
+	"AssignInstruction",
+	"DoStep",
+	"GetBoundaryConstraints",
+	"CheckPrerequisites",
+	"Abort",
+	"Dispose",
+	"ExecuteFunction",
+	"GetStatus",
+	"GetAdapterDescription",
+	"CreateSession",
+	"CloseSession",
+	"PushScene",
+	"GetLoadableMMUs",
+	"GetMMus",
+	"GetDescription",
+	"GetScene",
+	"GetSceneChanges",
+	"LoadMMUs",
+	"CreateCheckpoint",
+	"RestoreCheckpoint",
+};
+
+string CallMetrics::ToString() const
+{
+	return "calls=" + std::to_string(this->calls.load(memory_order_relaxed))
+		+ " errors=" + std::to_string(this->errors.load(memory_order_relaxed))
+		+ " " + this->latency.ToString()
+		+ " bytesIn=" + std::to_string(this->bytesIn.load(memory_order_relaxed))
+		+ " bytesOut=" + std::to_string(this->bytesOut.load(memory_order_relaxed));
+}
+
+RpcMetrics::Scope::Scope(Rpc_method method) :methodID{ method }, method{ RpcMetrics::methods[method] }, mmu{ nullptr }, start{ chrono::steady_clock::now() }, failed{ false }, exceptions{ uncaught_exceptions() }
+{
+}
+
+RpcMetrics::Scope::~Scope()
+{
+	bool failed = this->failed || uncaught_exceptions() > this->exceptions;
+	uint64_t micros = static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - this->start).count());
+
+	for (CallMetrics *metrics : { &this->method, this->mmu })
+	{
+		if (metrics == nullptr)
+			continue;
+
+		metrics->calls.fetch_add(1, memory_order_relaxed);
+		if (failed)
+			metrics->errors.fetch_add(1, memory_order_relaxed);
+		metrics->latency.Record(micros);
+	}
+}
+
+void RpcMetrics::Scope::Failed()
+{
+	this->failed = true;
+}
+
+void RpcMetrics::Scope::SetMMU(const string & mmuID)
+{
+	this->mmu = &GetMMUMetrics(mmuID)[this->methodID];
+}
+
+array<CallMetrics, R_COUNT>& RpcMetrics::GetMMUMetrics(const string & mmuID)
+{
+	{
+		shared_lock<shared_mutex> guard(mmusLock);
+		auto it = mmus.find(mmuID);
+		if (it != mmus.end())
+			return *it->second;
+	}
+
+	// a concurrent first call of the same MMU may win the insert, then its entry is used
+	unique_lock<shared_mutex> guard(mmusLock);
+	return *mmus.emplace(mmuID, make_unique<array<CallMetrics, R_COUNT>>()).first->second;
+}
+
+bool RpcMetrics::ParseMethod(Rpc_method & _return, const char * functionName)
+{
+	// thrift prefixes the function names with the service name
+	const char *separator = strrchr(functionName, '.');
+	const char *name = separator != nullptr ? separator + 1 : functionName;
+
+	for (int i = 0; i < R_COUNT; i++)
+	{
+		if (MethodNames[i] == name)
+		{
+			_return = static_cast<Rpc_method>(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+void RpcMetrics::RecordBytesIn(Rpc_method method, uint64_t bytes)
+{
+	methods[method].bytesIn.fetch_add(bytes, memory_order_relaxed);
+}
+
+void RpcMetrics::RecordBytesOut(Rpc_method method, uint64_t bytes)
+{
+	methods[method].bytesOut.fetch_add(bytes, memory_order_relaxed);
+}
+
+void RpcMetrics::Report(map<string, string>& _return)
+{
+	for (int i = 0; i < R_COUNT; i++)
+	{
+		if (methods[i].calls.load(memory_order_relaxed) > 0)
+			_return["RPC." + MethodNames[i]] = methods[i].ToString();
+	}
+
+	shared_lock<shared_mutex> guard(mmusLock);
+	for (const auto &mmu : mmus)
+	{
+		for (int i = 0; i < R_COUNT; i++)
+		{
+			if ((*mmu.second)[i].calls.load(memory_order_relaxed) > 0)
+				_return["RPC." + MethodNames[i] + "." + mmu.first] = (*mmu.second)[i].ToString();
+		}
+	}
+}
+
+void RpcMetrics::StartDump(int intervalSeconds)
+{
+	if (intervalSeconds <= 0 || dumpThread.joinable())
+		return;
+
+	dumpStopping = false;
+	dumpThread = thread([intervalSeconds]()
+	{
+		unique_lock<mutex> lock(dumpLock);
+		while (!dumpStop.wait_for(lock, chrono::seconds(intervalSeconds), [] { return dumpStopping; }))
+		{
+			map<string, string> report;
+			Report(report);
+			for (const auto &entry : report)
+				Logger::printLog(L_INFO, entry.first + ": " + entry.second);
+		}
+	});
+}
+
+void RpcMetrics::StopDump()
+{
+	if (!dumpThread.joinable())
+		return;
+
+	{
+		lock_guard<mutex> lock(dumpLock);
+		dumpStopping = true;
+	}
+	dumpStop.notify_all();
+	dumpThread.join();
+}
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "Utils/LatencyHistogram.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <condition_variable>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+namespace MMIStandard {
+
+	//	The methods of MMIAdapterIf
+	enum Rpc_method
+	{
+		R_INITIALIZE,
+		R_ASSIGN_INSTRUCTION,
+		R_DO_STEP,
+		R_GET_BOUNDARY_CONSTRAINTS,
+		R_CHECK_PREREQUISITES,
+		R_ABORT,
+		R_DISPOSE,
+		R_EXECUTE_FUNCTION,
+		R_GET_STATUS,
+		R_GET_ADAPTER_DESCRIPTION,
+		R_CREATE_SESSION,
+		R_CLOSE_SESSION,
+		R_PUSH_SCENE,
+		R_GET_LOADABLE_MMUS,
+		R_GET_MMUS,
+		R_GET_DESCRIPTION,
+		R_GET_SCENE,
+		R_GET_SCENE_CHANGES,
+		R_LOAD_MMUS,
+		R_CREATE_CHECKPOINT,
+		R_RESTORE_CHECKPOINT,
+		R_COUNT,
+	};
+
+	//	The measurements of one method
+	struct CallMetrics
+	{
+		atomic<uint64_t> calls{ 0 };
+		atomic<uint64_t> errors{ 0 };
+		atomic<uint64_t> bytesIn{ 0 };
+		atomic<uint64_t> bytesOut{ 0 };
+		LatencyHistogram latency;
+
+		//	Returns a short summary, e.g. "calls=10 errors=0 p50=12us ... bytesIn=1200 bytesOut=800"
+		string ToString() const;
+	};
+
+	class RpcMetrics
+	{
+		/*
+			Instrumentation of the adapter calls, counts calls, errors and transferred bytes and records the latencies of each method.
+			The methods which address an MMU are additionally recorded per MMU id, so slow MMUs can be identified.
+			Recording is lock free, the measurements are reported by GetStatus and optionally logged periodically (see StartDump).
+		*/
+	public:
+		class Scope
+		{
+			/*
+				Records a call from its construction to its destruction
+			*/
+		private:
+			Rpc_method methodID;
+			CallMetrics &method;
+			CallMetrics *mmu;
+			chrono::steady_clock::time_point start;
+			bool failed;
+
+			//	The number of exceptions in flight at the start, a call which is left by an exception is counted as failed
+			int exceptions;
+
+		public:
+			//	<param name="method">The method which is called</param>
+			Scope(Rpc_method method);
+			~Scope();
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+
+			//	Marks the call as failed, e.g. if an exception was caught by the handler
+			void Failed();
+
+			//	Records the call additionally for the MMU, is called once the MMU has been found
+			//	Calls of unknown MMU ids are only recorded for the method, so the client can not add arbitrary entries
+			void SetMMU(const string &mmuID);
+		};
+
+	private:
+		//	The measurements of the methods
+		static array<CallMetrics, R_COUNT> methods;
+
+		//	The measurements of the methods structured by the MMU id, an entry is added on the first call of a loaded MMU
+		static unordered_map<string, unique_ptr<array<CallMetrics, R_COUNT>>> mmus;
+		static shared_mutex mmusLock;
+
+		//	The thread which logs the measurements periodically
+		static thread dumpThread;
+		static mutex dumpLock;
+		static condition_variable dumpStop;
+		static bool dumpStopping;
+
+	private:
+		//	Returns the measurements of the MMU, creates them on the first call
+		static array<CallMetrics, R_COUNT> &GetMMUMetrics(const string &mmuID);
+
+	public:
+		RpcMetrics() = delete;
+
+		//	The names of the methods as used by thrift
+		static const array<string, R_COUNT> MethodNames;
+
+		//	Returns the method of a thrift function name (e.g. "MMIAdapter.DoStep"), returns false if it is no method of MMIAdapterIf
+		static bool ParseMethod(Rpc_method &_return, const char *functionName);
+
+		//	Adds the bytes of a serialized request / response of the method
+		static void RecordBytesIn(Rpc_method method, uint64_t bytes);
+		static void RecordBytesOut(Rpc_method method, uint64_t bytes);
+
+		//	Returns the measurements of the methods which have been called, e.g. "RPC.DoStep" and "RPC.DoStep.MoveMMU"
+		static void Report(map<string, string> &_return);
+
+		//	Starts logging the measurements periodically
+		//	<param name="intervalSeconds">The interval between two logs, the logging is disabled if it is 0 or less</param>
+		static void StartDump(int intervalSeconds);
+
+		//	Stops the periodic logging
+		static void StopDump();
+	};
+}
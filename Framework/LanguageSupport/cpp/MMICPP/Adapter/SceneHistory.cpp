@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "SceneHistory.h"
+#include <algorithm>
+
+SceneHistory::SceneHistory(size_t capacity) :updates(capacity), start{ 0 }, count{ 0 }, newestFrameID{ 0 }
+{
+}
+
+int SceneHistory::Append(shared_ptr<const MSceneUpdate> update)
+{
+	this->newestFrameID++;
+	if (this->updates.empty())
+		return this->newestFrameID;
+
+	if (this->count == this->updates.size())
+	{
+		// overwrite the oldest update
+		this->updates[this->start] = move(update);
+		this->start = (this->start + 1) % this->updates.size();
+	}
+	else
+	{
+		this->updates[(this->start + this->count) % this->updates.size()] = move(update);
+		this->count++;
+	}
+	return this->newestFrameID;
+}
+
+void SceneHistory::Clear()
+{
+	for (auto &update : this->updates)
+		update.reset();
+	this->start = 0;
+	this->count = 0;
+	this->newestFrameID = 0;
+}
+
+void SceneHistory::SetCapacity(size_t capacity)
+{
+	size_t kept = std::min(this->count, capacity);
+	vector<shared_ptr<const MSceneUpdate>> resized(capacity);
+	for (size_t i = 0; i < kept; i++)
+	{
+		resized[i] = move(this->updates[(this->start + this->count - kept + i) % this->updates.size()]);
+	}
+	this->updates.swap(resized);
+	this->start = 0;
+	this->count = kept;
+}
+
+size_t SceneHistory::Capacity() const
+{
+	return this->updates.size();
+}
+
+size_t SceneHistory::Size() const
+{
+	return this->count;
+}
+
+int SceneHistory::NewestFrameID() const
+{
+	return this->newestFrameID;
+}
+
+int SceneHistory::OldestFrameID() const
+{
+	return this->newestFrameID - static_cast<int>(this->count);
+}
+
+bool SceneHistory::GetUpdates(vector<shared_ptr<const MSceneUpdate>>& _return, int fromFrameID, int toFrameID) const
+{
+	if (fromFrameID > toFrameID || fromFrameID < this->OldestFrameID() || toFrameID > this->newestFrameID)
+		return false;
+
+	_return.reserve(_return.size() + (toFrameID - fromFrameID));
+	size_t offset = static_cast<size_t>(fromFrameID - this->OldestFrameID());
+	for (int frameID = fromFrameID; frameID < toFrameID; frameID++, offset++)
+	{
+		_return.emplace_back(this->updates[(this->start + offset) % this->updates.size()]);
+	}
+	return true;
+}
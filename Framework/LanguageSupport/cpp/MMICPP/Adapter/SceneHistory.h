@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "gen-cpp/scene_types.h"
+#include <vector>
+#include <memory>
+
+using namespace MMIStandard;
+using namespace std;
+
+namespace MMIStandard {
+	class SceneHistory
+	{
+		/*
+			Fixed size ring buffer of the last applied scene updates.
+			The update which leads to frame n is stored with the frame id n, frame 0 is the empty scene.
+			Appending and evicting are O(1), the updates are shared and never modified.
+		*/
+	private:
+		//	The ring buffer, contains Capacity() slots
+		vector<shared_ptr<const MSceneUpdate>> updates;
+
+		//	The slot of the oldest retained update
+		size_t start;
+
+		//	The number of retained updates
+		size_t count;
+
+		//	The id of the newest frame
+		int newestFrameID;
+
+	public:
+		//	Basic constructor
+		//	<param name="capacity">The maximum number of retained updates</param>
+		SceneHistory(size_t capacity);
+
+		//	Appends the update as next frame, the oldest update is evicted if the buffer is full
+		//	Returns the id of the new frame
+		int Append(shared_ptr<const MSceneUpdate> update);
+
+		//	Removes all updates and resets the frame id to 0
+		void Clear();
+
+		//	Changes the capacity, the newest updates are kept
+		void SetCapacity(size_t capacity);
+
+		//	Returns the maximum number of retained updates
+		size_t Capacity() const;
+
+		//	Returns the number of retained updates
+		size_t Size() const;
+
+		//	Returns the id of the newest frame
+		int NewestFrameID() const;
+
+		//	Returns the id of the oldest frame the changes can be computed from (the frame before the oldest retained update)
+		int OldestFrameID() const;
+
+		//	Appends the updates which lead from the frame fromFrameID to the frame toFrameID in the order of application
+		//	Returns false if the range is invalid or contains updates which are not retained anymore
+		bool GetUpdates(vector<shared_ptr<const MSceneUpdate>> &_return, int fromFrameID, int toFrameID) const;
+	};
+}
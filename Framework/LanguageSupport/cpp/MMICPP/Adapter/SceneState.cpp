@@ -0,0 +1,529 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "SceneState.h"
+#include "Extensions/MVector3Extensions.h"
+#include "Extensions/MQuaternionExtensions.h"
+#include "Extensions/MBoolResponseExtensions.h"
+#include "boost/exception/diagnostic_information.hpp"
+#include <algorithm>
+
+void SceneObjectEntry::CopyTo(MSceneObject & _return) const
+{
+	_return = this->sceneObject;
+	if (this->CopyMesh(_return.Mesh))
+		_return.__isset.Mesh = true;
+	if (this->CopyCollider(_return.Collider))
+		_return.__isset.Collider = true;
+}
+
+bool SceneObjectEntry::CopyMesh(MMesh & _return) const
+{
+	if (!this->mesh)
+		return false;
+
+	_return = *this->mesh;
+	_return.ID = this->meshID;
+	return true;
+}
+
+bool SceneObjectEntry::CopyCollider(MCollider & _return) const
+{
+	if (!this->collider)
+		return false;
+
+	_return = *this->collider;
+	_return.ID = this->colliderID;
+	return true;
+}
+
+void SceneObjectEntry::SetMesh(shared_ptr<const MMesh> value, const string & id)
+{
+	this->mesh = move(value);
+	this->meshID = id;
+}
+
+void SceneObjectEntry::SetCollider(shared_ptr<const MCollider> value, const string & id)
+{
+	this->collider = move(value);
+	this->colliderID = id;
+}
+
+SharedGeometry::SharedGeometry(GeometryStore & geometry, const MSceneUpdate & sceneUpdate)
+{
+	if (sceneUpdate.__isset.AddedSceneObjects)
+	{
+		this->addedMeshes.resize(sceneUpdate.AddedSceneObjects.size());
+		this->addedColliders.resize(sceneUpdate.AddedSceneObjects.size());
+		for (size_t i = 0; i < sceneUpdate.AddedSceneObjects.size(); i++)
+		{
+			const MSceneObject &sceneObject = sceneUpdate.AddedSceneObjects[i];
+			if (sceneObject.__isset.Mesh)
+				this->addedMeshes[i] = geometry.Share(sceneObject.Mesh);
+			if (sceneObject.__isset.Collider)
+				this->addedColliders[i] = geometry.Share(sceneObject.Collider);
+		}
+	}
+
+	if (sceneUpdate.__isset.ChangedSceneObjects)
+	{
+		this->changedMeshes.resize(sceneUpdate.ChangedSceneObjects.size());
+		this->changedColliders.resize(sceneUpdate.ChangedSceneObjects.size());
+		for (size_t i = 0; i < sceneUpdate.ChangedSceneObjects.size(); i++)
+		{
+			const MSceneObjectUpdate &sceneObjectUpdate = sceneUpdate.ChangedSceneObjects[i];
+			if (sceneObjectUpdate.__isset.Mesh)
+				this->changedMeshes[i] = geometry.Share(sceneObjectUpdate.Mesh);
+			if (sceneObjectUpdate.__isset.Collider)
+				this->changedColliders[i] = geometry.Share(sceneObjectUpdate.Collider);
+		}
+	}
+}
+
+SceneState::SceneState():sceneObjectIndex{sceneObjectTransforms},avatarIndex{avatarTransforms},frameID{0}
+{
+}
+
+int SceneState::GetFrameID() const
+{
+	return this->frameID;
+}
+
+void SceneState::SetFrameID(int frameID)
+{
+	this->frameID = frameID;
+}
+
+const SceneObjectEntry * SceneState::FindSceneObject(IdInterner::Handle handle) const
+{
+	if (handle >= this->sceneObjects.size())
+		return nullptr;
+
+	return this->sceneObjects[handle].get();
+}
+
+const MAvatar * SceneState::FindAvatar(IdInterner::Handle handle) const
+{
+	if (handle >= this->avatars.size())
+		return nullptr;
+
+	return this->avatars[handle].get();
+}
+
+void SceneState::VisitSceneObjects(const function<void(const SceneObjectEntry&)>& visitor) const
+{
+	for (const auto &sceneObject : this->sceneObjects)
+	{
+		if (sceneObject)
+			visitor(*sceneObject);
+	}
+}
+
+bool SceneState::VisitSceneObject(const string & id, const function<void(const SceneObjectEntry&)>& visitor) const
+{
+	const SceneObjectEntry *sceneObject = this->FindSceneObject(this->sceneObjectIds.Find(id));
+	if (sceneObject == nullptr)
+		return false;
+
+	visitor(*sceneObject);
+	return true;
+}
+
+bool SceneState::VisitSceneObjectByName(const string & name, const function<void(const SceneObjectEntry&)>& visitor) const
+{
+	auto iter = this->nameIdMappingSceneObjects.find(name);
+	if (iter == nameIdMappingSceneObjects.end() || iter->second.empty())
+		return false;
+
+	const SceneObjectEntry *sceneObject = this->FindSceneObject(iter->second[0]);
+	if (sceneObject == nullptr)
+		return false;
+
+	visitor(*sceneObject);
+	return true;
+}
+
+void SceneState::VisitSceneObjectsInRange(const MVector3 & position, double range, const function<void(const SceneObjectEntry&)>& visitor) const
+{
+	this->sceneObjectIndex.Query(position, range, [&](TransformStore::Handle handle)
+	{
+		const SceneObjectEntry *sceneObject = this->FindSceneObject(handle);
+		if (sceneObject != nullptr)
+			visitor(*sceneObject);
+	});
+}
+
+void SceneState::VisitAvatars(const function<void(const MAvatar&)>& visitor) const
+{
+	for (const auto &avatar : this->avatars)
+	{
+		if (avatar)
+			visitor(*avatar);
+	}
+}
+
+bool SceneState::VisitAvatar(const string & id, const function<void(const MAvatar&)>& visitor) const
+{
+	const MAvatar *avatar = this->FindAvatar(this->avatarIds.Find(id));
+	if (avatar == nullptr)
+		return false;
+
+	visitor(*avatar);
+	return true;
+}
+
+bool SceneState::VisitAvatarByName(const string & name, const function<void(const MAvatar&)>& visitor) const
+{
+	auto iter = this->nameIdMappingAvatars.find(name);
+	if (iter == nameIdMappingAvatars.end() || iter->second.empty())
+		return false;
+
+	const MAvatar *avatar = this->FindAvatar(iter->second[0]);
+	if (avatar == nullptr)
+		return false;
+
+	visitor(*avatar);
+	return true;
+}
+
+void SceneState::VisitAvatarsInRange(const MVector3 & position, double range, const function<void(const MAvatar&)>& visitor) const
+{
+	this->avatarIndex.Query(position, range, [&](TransformStore::Handle handle)
+	{
+		const MAvatar *avatar = this->FindAvatar(handle);
+		if (avatar != nullptr)
+			visitor(*avatar);
+	});
+}
+
+size_t SceneState::SceneObjectCount() const
+{
+	return this->sceneObjectIds.Size();
+}
+
+size_t SceneState::AvatarCount() const
+{
+	return this->avatarIds.Size();
+}
+
+void SceneState::GetTransforms(vector<MTransform>& _return) const
+{
+	_return.reserve(_return.size() + this->sceneObjectTransforms.Size());
+	for (TransformStore::Handle handle = 0; handle < this->sceneObjectTransforms.Capacity(); handle++)
+	{
+		if (!this->sceneObjectTransforms.IsValid(handle))
+			continue;
+
+		_return.emplace_back();
+		this->sceneObjectTransforms.GetTransform(_return.back(), handle);
+	}
+}
+
+bool SceneState::GetTransformByID(MTransform & _return, const string & id) const
+{
+	IdInterner::Handle handle = this->sceneObjectIds.Find(id);
+	if (!this->sceneObjectTransforms.IsValid(handle))
+		return false;
+
+	this->sceneObjectTransforms.GetTransform(_return, handle);
+	return true;
+}
+
+void SceneState::Clear()
+{
+	this->avatars.clear();
+	this->sceneObjects.clear();
+	this->avatarIds.Clear();
+	this->sceneObjectIds.Clear();
+	this->nameIdMappingAvatars.clear();
+	this->nameIdMappingSceneObjects.clear();
+	this->sceneObjectIndex.Clear();
+	this->avatarIndex.Clear();
+	this->sceneObjectTransforms.Clear();
+	this->avatarTransforms.Clear();
+	this->frameID = 0;
+}
+
+bool SceneState::GetAvatarRootTransform(MTransform & _return, const string & avatarID, const MAvatarPostureValues & postureValues)
+{
+	// the posture data starts with the position and the rotation of the root joint
+	const vector<double> &data = postureValues.PostureData;
+	if (data.size() < 3)
+		return false;
+
+	_return.__set_ID(avatarID);
+	_return.Position.__set_X(data[0]);
+	_return.Position.__set_Y(data[1]);
+	_return.Position.__set_Z(data[2]);
+
+	if (data.size() >= 7)
+	{
+		_return.Rotation.__set_X(data[3]);
+		_return.Rotation.__set_Y(data[4]);
+		_return.Rotation.__set_Z(data[5]);
+		_return.Rotation.__set_W(data[6]);
+	}
+	else
+	{
+		_return.Rotation.__set_W(1);
+	}
+	return true;
+}
+
+void SceneState::UpdateAvatarTransform(IdInterner::Handle handle, const MAvatar & avatar)
+{
+	MTransform rootTransform;
+	if (GetAvatarRootTransform(rootTransform, avatar.ID, avatar.PostureValues))
+	{
+		if (this->avatarTransforms.IsValid(handle))
+		{
+			this->avatarTransforms.SetPosition(handle, rootTransform.Position);
+			this->avatarTransforms.SetRotation(handle, rootTransform.Rotation);
+		}
+		else
+		{
+			this->avatarTransforms.Insert(handle, rootTransform);
+		}
+		this->avatarIndex.Insert(handle);
+	}
+	else
+	{
+		this->avatarIndex.Remove(handle);
+		this->avatarTransforms.Remove(handle);
+	}
+}
+
+void SceneState::Apply(MBoolResponse & _return, const MSceneUpdate & sceneUpdate, const SharedGeometry & geometry)
+{
+	if(sceneUpdate.__isset.AddedAvatars)
+		this->AddAvatars(_return,sceneUpdate.AddedAvatars);
+	
+	if (sceneUpdate.__isset.AddedSceneObjects)
+		this->AddSceneObjects(_return, sceneUpdate.AddedSceneObjects, geometry.addedMeshes, geometry.addedColliders);
+
+	if (sceneUpdate.__isset.ChangedAvatars)
+		this->UpdataAvatars(_return,sceneUpdate.ChangedAvatars);
+
+	if (sceneUpdate.__isset.ChangedSceneObjects)
+		this->UpdateSceneObjects(_return,sceneUpdate.ChangedSceneObjects, geometry.changedMeshes, geometry.changedColliders);
+
+	if (sceneUpdate.__isset.RemovedAvatars)
+		this->RemoveAvatars(_return,sceneUpdate.RemovedAvatars);
+
+	if (sceneUpdate.__isset.RemovedSceneObjects)
+		this->RemoveSceneObjects(_return,sceneUpdate.RemovedSceneObjects);
+}
+
+void SceneState::AddAvatars(MBoolResponse & _return, const vector<MAvatar>& avatars)
+{
+	
+	for (const MAvatar &avatar : avatars)
+	{
+		if (avatar.ID.empty() || this->avatarIds.Find(avatar.ID) != IdInterner::InvalidHandle)
+		{
+			string message = "Could not add avatar: " + avatar.Name + " is already registered or has no id";
+			MBoolResponseExtensions::Update(_return, message, false);
+			continue;
+		}
+
+		IdInterner::Handle handle = this->avatarIds.Intern(avatar.ID);
+		if (handle >= this->avatars.size())
+			this->avatars.resize(size_t(handle) + 1);
+		this->avatars[handle] = make_unique<MAvatar>(avatar);
+
+		this->UpdateAvatarTransform(handle, avatar);
+
+		// the handle is new, so it can not be contained in the mapping yet
+		this->nameIdMappingAvatars[avatar.Name].emplace_back(handle);
+	}
+}
+
+void SceneState::AddSceneObjects(MBoolResponse & _return, const vector<MSceneObject>& sceneObjects, const vector<shared_ptr<const MMesh>> &meshes, const vector<shared_ptr<const MCollider>> &colliders)
+{
+	for (size_t i = 0; i < sceneObjects.size(); i++)
+	{
+		const MSceneObject &sceneObject = sceneObjects[i];
+		if (sceneObject.ID.empty() || this->sceneObjectIds.Find(sceneObject.ID) != IdInterner::InvalidHandle)
+		{
+			string message = "Could not add scene object: " + sceneObject.Name + " is already registered or has no id";
+			MBoolResponseExtensions::Update(_return, message, false);
+			continue;
+		}
+
+		IdInterner::Handle handle = this->sceneObjectIds.Intern(sceneObject.ID);
+		if (handle >= this->sceneObjects.size())
+			this->sceneObjects.resize(size_t(handle) + 1);
+		// the geometry is shared with all identical scene objects and is not kept in the scene object itself
+		auto entry = make_unique<SceneObjectEntry>();
+		entry->sceneObject.ID = sceneObject.ID;
+		entry->sceneObject.Name = sceneObject.Name;
+		entry->sceneObject.Transform = sceneObject.Transform;
+		if (sceneObject.__isset.PhysicsProperties)
+			entry->sceneObject.__set_PhysicsProperties(sceneObject.PhysicsProperties);
+		if (sceneObject.__isset.Properties)
+			entry->sceneObject.__set_Properties(sceneObject.Properties);
+		if (sceneObject.__isset.Attachments)
+			entry->sceneObject.__set_Attachments(sceneObject.Attachments);
+		if (sceneObject.__isset.Constraints)
+			entry->sceneObject.__set_Constraints(sceneObject.Constraints);
+		if (sceneObject.__isset.Mesh)
+			entry->SetMesh(meshes[i], sceneObject.Mesh.ID);
+		if (sceneObject.__isset.Collider)
+			entry->SetCollider(colliders[i], sceneObject.Collider.ID);
+		this->sceneObjects[handle] = move(entry);
+
+		this->sceneObjectTransforms.Insert(handle, sceneObject.Transform);
+		this->sceneObjectIndex.Insert(handle);
+
+		this->nameIdMappingSceneObjects[sceneObject.Name].emplace_back(handle);
+	}
+}
+
+void SceneState::UpdataAvatars(MBoolResponse & _return, const vector<MAvatarUpdate>& avatars)
+{
+	for (const MAvatarUpdate &avatarUpdate : avatars)
+	{
+		IdInterner::Handle handle = this->avatarIds.Find(avatarUpdate.ID);
+		if (this->FindAvatar(handle) != nullptr)
+		{
+			MAvatar &avatar = *this->avatars[handle];
+			if (avatarUpdate.__isset.Description)
+				avatar.Description = avatarUpdate.Description;
+
+			if (avatarUpdate.__isset.PostureValues)
+			{
+				avatar.PostureValues = avatarUpdate.PostureValues;
+				this->UpdateAvatarTransform(handle, avatar);
+			}
+
+			if (avatarUpdate.__isset.SceneObjects)
+				avatar.__set_SceneObjects(avatarUpdate.SceneObjects);
+		}
+		else
+		{
+			string message = "Could not update avatar : " + avatarUpdate.ID + " not found";
+			MBoolResponseExtensions::Update(_return, message, false);
+		}
+	}
+}
+
+void SceneState::UpdateSceneObjects(MBoolResponse & _return, const vector<MSceneObjectUpdate>& sceneObjects, const vector<shared_ptr<const MMesh>> &meshes, const vector<shared_ptr<const MCollider>> &colliders)
+{
+	for (size_t i = 0; i < sceneObjects.size(); i++)
+	{
+		const MSceneObjectUpdate &sceneObjectUpdate = sceneObjects[i];
+		IdInterner::Handle handle = this->sceneObjectIds.Find(sceneObjectUpdate.ID);
+		if (this->FindSceneObject(handle) != nullptr)
+		{
+			SceneObjectEntry &entry = *this->sceneObjects[handle];
+			MSceneObject &sceneObject = entry.sceneObject;
+			if (sceneObjectUpdate.__isset.Transform)
+			{
+				const MTransformUpdate &transformUpdate = sceneObjectUpdate.Transform;
+				try
+				{
+					if (transformUpdate.__isset.Position)
+					{
+						MVector3Extensions::ToMVector3(sceneObject.Transform.Position, transformUpdate.Position);
+						this->sceneObjectTransforms.SetPosition(handle, sceneObject.Transform.Position);
+						this->sceneObjectIndex.Insert(handle);
+					}
+					
+					if (transformUpdate.__isset.Rotation)
+					{
+						MQuaternionExtensions::ToMQuaternion(sceneObject.Transform.Rotation, transformUpdate.Rotation);
+						this->sceneObjectTransforms.SetRotation(handle, sceneObject.Transform.Rotation);
+					}
+				}
+				catch (...)
+				{
+					string message = boost::current_exception_diagnostic_information();
+					MBoolResponseExtensions::Update(_return, message, false);
+				}
+				if (transformUpdate.__isset.Parent)
+				{
+					sceneObject.Transform.__set_Parent(transformUpdate.Parent);
+					this->sceneObjectTransforms.SetParent(handle, transformUpdate.Parent);
+				}
+			}
+
+			if (sceneObjectUpdate.__isset.Collider)
+				entry.SetCollider(colliders[i], sceneObjectUpdate.Collider.ID);
+
+			if (sceneObjectUpdate.__isset.Mesh)
+				entry.SetMesh(meshes[i], sceneObjectUpdate.Mesh.ID);
+
+			if (sceneObjectUpdate.__isset.PhysicsProperties)
+				sceneObject.__set_PhysicsProperties(sceneObjectUpdate.PhysicsProperties);
+		}
+		else
+		{
+			string message = "Could not update scene object: " + sceneObjectUpdate.ID + " object not found";
+			MBoolResponseExtensions::Update(_return, message, false);
+		}
+	}
+}
+
+void SceneState::RemoveAvatars(MBoolResponse & _return, const vector<string>& avatarIDs)
+{
+	for (const string &id : avatarIDs)
+	{
+		IdInterner::Handle handle = this->avatarIds.Find(id);
+		const MAvatar *avatar = this->FindAvatar(handle);
+		if (avatar != nullptr)
+		{
+			auto nameIdIter = this->nameIdMappingAvatars.find(avatar->Name);
+			if (nameIdIter != nameIdMappingAvatars.end()) //pos vector of handles
+			{
+				auto idIter = std::find(nameIdIter->second.begin(), nameIdIter->second.end(), handle);
+				if (idIter != nameIdIter->second.end())
+					nameIdIter->second.erase(idIter);
+				if (nameIdIter->second.empty())
+					nameIdMappingAvatars.erase(nameIdIter);
+			}
+
+			this->avatarIndex.Remove(handle);
+			this->avatarTransforms.Remove(handle);
+			this->avatars[handle].reset();
+			this->avatarIds.Release(handle);
+		}
+		else
+		{
+			string message = "could not remove avatar: " + id + " not found";
+			MBoolResponseExtensions::Update(_return, message, false);
+		}
+	}
+
+}
+
+void SceneState::RemoveSceneObjects(MBoolResponse & _return, const vector<string>& sceneObjectIDs)
+{
+	for (const string &id : sceneObjectIDs)
+	{
+		IdInterner::Handle handle = this->sceneObjectIds.Find(id);
+		const SceneObjectEntry *sceneObject = this->FindSceneObject(handle);
+		if (sceneObject != nullptr)
+		{
+			auto iter1 = this->nameIdMappingSceneObjects.find(sceneObject->sceneObject.Name);
+			if (iter1 != nameIdMappingSceneObjects.end())
+			{
+				auto iter2 = std::find(iter1->second.begin(), iter1->second.end(), handle);
+				if (iter2 != iter1->second.end())
+					iter1->second.erase(iter2);
+				if (iter1->second.empty())
+					nameIdMappingSceneObjects.erase(iter1);
+			}
+
+			this->sceneObjectIndex.Remove(handle);
+			this->sceneObjectTransforms.Remove(handle);
+			this->sceneObjects[handle].reset();
+			this->sceneObjectIds.Release(handle);
+		}
+		else
+		{
+			string message = "could not remove scene object:  " + id + " not found";
+			MBoolResponseExtensions::Update(_return, message, false);
+		}
+	}
+}
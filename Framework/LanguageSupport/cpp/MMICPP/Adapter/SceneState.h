@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "gen-cpp/scene_types.h"
+#include "IdInterner.h"
+#include "TransformStore.h"
+#include "SpatialHashGrid.h"
+#include "GeometryStore.h"
+#include <unordered_map>
+#include <functional>
+#include <memory>
+
+using namespace MMIStandard;
+using namespace std;
+namespace MMIStandard {
+
+	struct SceneObjectEntry
+	{
+		/*
+			A scene object as it is stored in the scene.
+			The mesh and the collider are not part of the scene object itself but are shared with all identical scene objects (see GeometryStore).
+		*/
+
+		//	The scene object without Mesh and Collider
+		MSceneObject sceneObject;
+
+		//	The mesh / collider of the scene object, nullptr if the scene object has none
+		//	The shared instances have no ID, the IDs of the scene object are kept in meshID / colliderID
+		shared_ptr<const MMesh> mesh;
+		shared_ptr<const MCollider> collider;
+
+		//	The ID of the mesh / collider of the scene object
+		string meshID;
+		string colliderID;
+
+		//	Writes the complete scene object including the mesh and the collider
+		void CopyTo(MSceneObject &_return) const;
+
+		//	Writes the mesh / collider including its ID, returns false and leaves _return unchanged if the scene object has none
+		bool CopyMesh(MMesh &_return) const;
+		bool CopyCollider(MCollider &_return) const;
+
+		//	Sets the shared mesh / collider and the ID of the scene object
+		void SetMesh(shared_ptr<const MMesh> value, const string &id);
+		void SetCollider(shared_ptr<const MCollider> value, const string &id);
+	};
+
+	struct SharedGeometry
+	{
+		/*
+			The meshes and colliders of a scene update as shared instances of the GeometryStore.
+			The geometry is shared once per update and used for both instances of the scene, so it is hashed and copied only once.
+			The entries are structured like the added / changed scene objects of the update, nullptr if the scene object sets no mesh / collider.
+		*/
+		vector<shared_ptr<const MMesh>> addedMeshes;
+		vector<shared_ptr<const MCollider>> addedColliders;
+		vector<shared_ptr<const MMesh>> changedMeshes;
+		vector<shared_ptr<const MCollider>> changedColliders;
+
+		//	Shares the meshes and colliders of the update through the store
+		SharedGeometry(GeometryStore &geometry, const MSceneUpdate &sceneUpdate);
+	};
+
+	class SceneState
+	{
+		/*
+			The content of a scene (scene objects, avatars and the indices over them) without any synchronization.
+			MMIScene keeps two instances and publishes one of them to the readers while the other one is updated.
+		*/
+	private:
+		//	Maps the ids of the scene objects / avatars to the handles which index the containers below
+		IdInterner sceneObjectIds;
+		IdInterner avatarIds;
+
+		//	All scene objects structured by the handle of their id, released handles contain nullptr
+		vector<unique_ptr<SceneObjectEntry>> sceneObjects;
+
+		//	All avatars structured by the handle of their id, released handles contain nullptr
+		vector<unique_ptr<MAvatar>> avatars;
+
+		//	Mapping between the name of a scene object and the handles of its ids
+		unordered_map<string, vector<IdInterner::Handle>> nameIdMappingSceneObjects;
+
+		//	Mapping between the name of a avatar and the handles of its ids
+		unordered_map<string, vector<IdInterner::Handle>> nameIdMappingAvatars;
+
+		//	Dense storage of the scene object transforms which is used for scans over all transforms, indexed by the scene object handle
+		TransformStore sceneObjectTransforms;
+
+		//	Dense storage of the avatar root transforms, indexed by the avatar handle
+		TransformStore avatarTransforms;
+
+		//	Spatial index over the positions of the scene objects
+		SpatialHashGrid sceneObjectIndex;
+
+		//	Spatial index over the root positions of the avatars
+		SpatialHashGrid avatarIndex;
+
+		//	The id of the frame the state represents
+		int frameID;
+
+	private:
+		//	Returns the root transform of the avatar, false if the posture does not contain a root position
+		static bool GetAvatarRootTransform(MTransform &_return, const string &avatarID, const MAvatarPostureValues &postureValues);
+
+		//	Writes the root transform of the avatar into the transform store and the spatial index
+		void UpdateAvatarTransform(IdInterner::Handle handle, const MAvatar &avatar);
+
+		//	Returns the scene object / avatar of the handle or nullptr if the handle is not in use
+		const SceneObjectEntry *FindSceneObject(IdInterner::Handle handle) const;
+		const MAvatar *FindAvatar(IdInterner::Handle handle) const;
+
+	public:
+		//	Basic constructor
+		SceneState();
+
+		SceneState(const SceneState&) = delete;
+		SceneState& operator=(const SceneState&) = delete;
+
+		//	Applies the scene manipulation, failures are reported in the response only and are not logged
+		//	<param name="sceneUpdate">The scene manipulation to be considered</param>
+		//	<param name="geometry">The shared meshes and colliders of the update, the scene objects share identical geometry through it</param>
+		void Apply(MBoolResponse &_return, const MSceneUpdate &sceneUpdate, const SharedGeometry &geometry);
+
+		//	Clears the whole state
+		void Clear();
+
+		//	Getter and setter for the id of the frame the state represents
+		int GetFrameID() const;
+		void SetFrameID(int frameID);
+
+		//	Adds all avatars to the scene
+		//	<param name="avatars">The avatars which should be added</param>
+		void AddAvatars(MBoolResponse & _return, const vector<MAvatar>& avatars);
+
+		//	Adds all scene objects to the scene
+		//	<param name="sceneObjects>The scene objects which should be added</param>
+		//	<param name="meshes">The shared meshes / colliders of the scene objects</param>
+		void AddSceneObjects(MBoolResponse & _return, const vector<MSceneObject>& sceneObjects, const vector<shared_ptr<const MMesh>> &meshes, const vector<shared_ptr<const MCollider>> &colliders);
+
+		//	Updates all avatars
+		//	<param name="avatars>The avatars which should be updated</param>
+		void UpdataAvatars(MBoolResponse & _return, const vector<MAvatarUpdate>& avatars);
+
+		//	Updates all scene objects
+		//	<param name="avatars>The scene objects which should be updated</param>
+		//	<param name="meshes">The shared meshes / colliders of the updates</param>
+		void UpdateSceneObjects(MBoolResponse & _return, const vector<MSceneObjectUpdate>& sceneObjects, const vector<shared_ptr<const MMesh>> &meshes, const vector<shared_ptr<const MCollider>> &colliders);
+
+		//	Removes all avatars from the scene
+		//	<param name="avatarIDs">The IDs of the avatars which schould be removed</param>
+		void RemoveAvatars(MBoolResponse & _return, const vector<string>& avatarIDs);
+
+		//	Removes all scene objects from the scene
+		//	<param name="sceneObjectIDs">The IDs of the scene objects which schould be removed</param>
+		void RemoveSceneObjects(MBoolResponse & _return, const vector<string>& sceneObjectIDs);
+
+		//	Returns the number of scene objects / avatars
+		size_t SceneObjectCount() const;
+		size_t AvatarCount() const;
+
+		//	Read views, see MMIScene
+		void VisitSceneObjects(const function<void(const SceneObjectEntry &)> &visitor) const;
+		bool VisitSceneObject(const string &id, const function<void(const SceneObjectEntry &)> &visitor) const;
+		bool VisitSceneObjectByName(const string &name, const function<void(const SceneObjectEntry &)> &visitor) const;
+		void VisitSceneObjectsInRange(const MVector3 &position, double range, const function<void(const SceneObjectEntry &)> &visitor) const;
+		void VisitAvatars(const function<void(const MAvatar &)> &visitor) const;
+		bool VisitAvatar(const string &id, const function<void(const MAvatar &)> &visitor) const;
+		bool VisitAvatarByName(const string &name, const function<void(const MAvatar &)> &visitor) const;
+		void VisitAvatarsInRange(const MVector3 &position, double range, const function<void(const MAvatar &)> &visitor) const;
+
+		//	Appends the transforms of all scene objects
+		void GetTransforms(vector<MTransform> &_return) const;
+
+		//	Returns the transform of the scene object, false if the id is unknown
+		bool GetTransformByID(MTransform &_return, const string &id) const;
+	};
+}
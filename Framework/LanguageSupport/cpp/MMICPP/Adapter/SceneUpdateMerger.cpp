@@ -0,0 +1,330 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "SceneUpdateMerger.h"
+#include "Extensions/MVector3Extensions.h"
+#include "Extensions/MQuaternionExtensions.h"
+
+SceneUpdateMerger::SceneUpdateMerger() :mergeable{ true }
+{
+}
+
+SceneUpdateMerger::SceneObjectEntry & SceneUpdateMerger::GetSceneObjectEntry(const string & id)
+{
+	auto iter = this->sceneObjectEntries.find(id);
+	if (iter != this->sceneObjectEntries.end())
+		return this->sceneObjects[iter->second];
+
+	this->sceneObjectEntries.emplace(id, this->sceneObjects.size());
+	this->sceneObjects.emplace_back();
+	this->sceneObjects.back().id = id;
+	return this->sceneObjects.back();
+}
+
+SceneUpdateMerger::AvatarEntry & SceneUpdateMerger::GetAvatarEntry(const string & id)
+{
+	auto iter = this->avatarEntries.find(id);
+	if (iter != this->avatarEntries.end())
+		return this->avatars[iter->second];
+
+	this->avatarEntries.emplace(id, this->avatars.size());
+	this->avatars.emplace_back();
+	this->avatars.back().id = id;
+	return this->avatars.back();
+}
+
+void SceneUpdateMerger::Append(const MSceneUpdate & sceneUpdate)
+{
+	// the operations are evaluated in the same order as MMIScene::Apply executes them,
+	// operations which would fail on the scene (e.g. adding an existing object) are ignored
+	if (sceneUpdate.__isset.AddedAvatars)
+	{
+		for (const MAvatar &avatar : sceneUpdate.AddedAvatars)
+		{
+			AvatarEntry &entry = this->GetAvatarEntry(avatar.ID);
+			if (entry.state == NONE)
+			{
+				entry.state = ADDED;
+				entry.added = avatar;
+			}
+			else if (entry.state != ADDED)
+			{
+				// replaced by a new avatar or changed before it was added, not expressible as one operation
+				this->mergeable = false;
+			}
+		}
+	}
+
+	if (sceneUpdate.__isset.AddedSceneObjects)
+	{
+		for (const MSceneObject &sceneObject : sceneUpdate.AddedSceneObjects)
+		{
+			SceneObjectEntry &entry = this->GetSceneObjectEntry(sceneObject.ID);
+			if (entry.state == NONE)
+			{
+				entry.state = ADDED;
+				entry.added = sceneObject;
+			}
+			else if (entry.state != ADDED)
+			{
+				this->mergeable = false;
+			}
+		}
+	}
+
+	if (sceneUpdate.__isset.ChangedAvatars)
+	{
+		for (const MAvatarUpdate &avatarUpdate : sceneUpdate.ChangedAvatars)
+		{
+			AvatarEntry &entry = this->GetAvatarEntry(avatarUpdate.ID);
+			if (entry.state == NONE)
+			{
+				entry.state = CHANGED;
+				entry.changed = avatarUpdate;
+			}
+			else if (entry.state == ADDED)
+			{
+				ApplyUpdate(entry.added, avatarUpdate);
+			}
+			else if (entry.state == CHANGED)
+			{
+				MergeUpdate(entry.changed, avatarUpdate);
+			}
+		}
+	}
+
+	if (sceneUpdate.__isset.ChangedSceneObjects)
+	{
+		for (const MSceneObjectUpdate &sceneObjectUpdate : sceneUpdate.ChangedSceneObjects)
+		{
+			SceneObjectEntry &entry = this->GetSceneObjectEntry(sceneObjectUpdate.ID);
+			try
+			{
+				if (entry.state == NONE)
+				{
+					entry.state = CHANGED;
+					entry.changed = sceneObjectUpdate;
+				}
+				else if (entry.state == ADDED)
+				{
+					ApplyUpdate(entry.added, sceneObjectUpdate);
+				}
+				else if (entry.state == CHANGED)
+				{
+					MergeUpdate(entry.changed, sceneObjectUpdate);
+				}
+			}
+			catch (...)
+			{
+				// the transform of the update is invalid, the scene rejects it as well
+				this->mergeable = false;
+			}
+		}
+	}
+
+	if (sceneUpdate.__isset.RemovedAvatars)
+	{
+		for (const string &id : sceneUpdate.RemovedAvatars)
+		{
+			AvatarEntry &entry = this->GetAvatarEntry(id);
+			if (entry.state == ADDED)
+			{
+				// added and removed within the merged frames, the avatar does not appear in the result
+				entry = AvatarEntry{};
+				entry.id = id;
+			}
+			else if (entry.state == NONE || entry.state == CHANGED)
+			{
+				entry = AvatarEntry{};
+				entry.id = id;
+				entry.state = REMOVED;
+			}
+		}
+	}
+
+	if (sceneUpdate.__isset.RemovedSceneObjects)
+	{
+		for (const string &id : sceneUpdate.RemovedSceneObjects)
+		{
+			SceneObjectEntry &entry = this->GetSceneObjectEntry(id);
+			if (entry.state == ADDED)
+			{
+				entry = SceneObjectEntry{};
+				entry.id = id;
+			}
+			else if (entry.state == NONE || entry.state == CHANGED)
+			{
+				entry = SceneObjectEntry{};
+				entry.id = id;
+				entry.state = REMOVED;
+			}
+		}
+	}
+}
+
+bool SceneUpdateMerger::GetResult(MSceneUpdate & _return) const
+{
+	if (!this->mergeable)
+		return false;
+
+	vector<MSceneObject> addedSceneObjects;
+	vector<MSceneObjectUpdate> changedSceneObjects;
+	vector<string> removedSceneObjects;
+	for (const SceneObjectEntry &entry : this->sceneObjects)
+	{
+		if (entry.state == ADDED)
+			addedSceneObjects.emplace_back(entry.added);
+		else if (entry.state == CHANGED)
+			changedSceneObjects.emplace_back(entry.changed);
+		else if (entry.state == REMOVED)
+			removedSceneObjects.emplace_back(entry.id);
+	}
+
+	vector<MAvatar> addedAvatars;
+	vector<MAvatarUpdate> changedAvatars;
+	vector<string> removedAvatars;
+	for (const AvatarEntry &entry : this->avatars)
+	{
+		if (entry.state == ADDED)
+			addedAvatars.emplace_back(entry.added);
+		else if (entry.state == CHANGED)
+			changedAvatars.emplace_back(entry.changed);
+		else if (entry.state == REMOVED)
+			removedAvatars.emplace_back(entry.id);
+	}
+
+	if (!addedSceneObjects.empty())
+		_return.__set_AddedSceneObjects(addedSceneObjects);
+	if (!changedSceneObjects.empty())
+		_return.__set_ChangedSceneObjects(changedSceneObjects);
+	if (!removedSceneObjects.empty())
+		_return.__set_RemovedSceneObjects(removedSceneObjects);
+	if (!addedAvatars.empty())
+		_return.__set_AddedAvatars(addedAvatars);
+	if (!changedAvatars.empty())
+		_return.__set_ChangedAvatars(changedAvatars);
+	if (!removedAvatars.empty())
+		_return.__set_RemovedAvatars(removedAvatars);
+	return true;
+}
+
+void SceneUpdateMerger::ApplyUpdate(MSceneObject & sceneObject, const MSceneObjectUpdate & update)
+{
+	if (update.__isset.Name)
+		sceneObject.__set_Name(update.Name);
+
+	if (update.__isset.Transform)
+	{
+		if (update.Transform.__isset.Position)
+			MVector3Extensions::ToMVector3(sceneObject.Transform.Position, update.Transform.Position);
+		if (update.Transform.__isset.Rotation)
+			MQuaternionExtensions::ToMQuaternion(sceneObject.Transform.Rotation, update.Transform.Rotation);
+		if (update.Transform.__isset.Parent)
+			sceneObject.Transform.__set_Parent(update.Transform.Parent);
+	}
+
+	if (update.__isset.Collider)
+		sceneObject.__set_Collider(update.Collider);
+	if (update.__isset.Mesh)
+		sceneObject.__set_Mesh(update.Mesh);
+	if (update.__isset.PhysicsProperties)
+		sceneObject.__set_PhysicsProperties(update.PhysicsProperties);
+	if (update.__isset.Attachments)
+		sceneObject.__set_Attachments(update.Attachments);
+	if (update.__isset.Constraints)
+		sceneObject.__set_Constraints(update.Constraints);
+
+	if (update.__isset.Properties)
+	{
+		for (const MPropertyUpdate &property : update.Properties)
+		{
+			if (property.__isset.Value)
+				sceneObject.Properties[property.Key] = property.Value;
+			else
+				sceneObject.Properties.erase(property.Key);
+		}
+		sceneObject.__isset.Properties = true;
+	}
+}
+
+void SceneUpdateMerger::ApplyUpdate(MAvatar & avatar, const MAvatarUpdate & update)
+{
+	if (update.__isset.PostureValues)
+		avatar.__set_PostureValues(update.PostureValues);
+	if (update.__isset.SceneObjects)
+		avatar.__set_SceneObjects(update.SceneObjects);
+	if (update.__isset.Description)
+		avatar.__set_Description(update.Description);
+
+	if (update.__isset.Properties)
+	{
+		for (const MPropertyUpdate &property : update.Properties)
+		{
+			if (property.__isset.Value)
+				avatar.Properties[property.Key] = property.Value;
+			else
+				avatar.Properties.erase(property.Key);
+		}
+		avatar.__isset.Properties = true;
+	}
+}
+
+void SceneUpdateMerger::MergeUpdate(MSceneObjectUpdate & earlier, const MSceneObjectUpdate & later)
+{
+	if (later.__isset.Name)
+		earlier.__set_Name(later.Name);
+
+	if (later.__isset.Transform)
+	{
+		if (!earlier.__isset.Transform)
+		{
+			earlier.__set_Transform(later.Transform);
+		}
+		else
+		{
+			if (later.Transform.__isset.Position)
+				earlier.Transform.__set_Position(later.Transform.Position);
+			if (later.Transform.__isset.Rotation)
+				earlier.Transform.__set_Rotation(later.Transform.Rotation);
+			if (later.Transform.__isset.Parent)
+				earlier.Transform.__set_Parent(later.Transform.Parent);
+		}
+	}
+
+	if (later.__isset.Collider)
+		earlier.__set_Collider(later.Collider);
+	if (later.__isset.Mesh)
+		earlier.__set_Mesh(later.Mesh);
+	if (later.__isset.PhysicsProperties)
+		earlier.__set_PhysicsProperties(later.PhysicsProperties);
+	if (later.__isset.HandPoses)
+		earlier.__set_HandPoses(later.HandPoses);
+	if (later.__isset.Attachments)
+		earlier.__set_Attachments(later.Attachments);
+	if (later.__isset.Constraints)
+		earlier.__set_Constraints(later.Constraints);
+
+	// property updates address single keys, they are applied in order
+	if (later.__isset.Properties)
+	{
+		earlier.Properties.insert(earlier.Properties.end(), later.Properties.begin(), later.Properties.end());
+		earlier.__isset.Properties = true;
+	}
+}
+
+void SceneUpdateMerger::MergeUpdate(MAvatarUpdate & earlier, const MAvatarUpdate & later)
+{
+	if (later.__isset.PostureValues)
+		earlier.__set_PostureValues(later.PostureValues);
+	if (later.__isset.SceneObjects)
+		earlier.__set_SceneObjects(later.SceneObjects);
+	if (later.__isset.Description)
+		earlier.__set_Description(later.Description);
+
+	if (later.__isset.Properties)
+	{
+		earlier.Properties.insert(earlier.Properties.end(), later.Properties.begin(), later.Properties.end());
+		earlier.__isset.Properties = true;
+	}
+}
@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "gen-cpp/scene_types.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+using namespace MMIStandard;
+using namespace std;
+
+namespace MMIStandard {
+	class SceneUpdateMerger
+	{
+		/*
+			Coalesces consecutive scene updates into a single update with the same effect:
+			the changes of an object are merged field by field (the last value wins), changes of an added object are
+			folded into the added object and an object which is added and removed again does not appear at all.
+		*/
+	private:
+		//	The accumulated operation of a single scene object / avatar
+		enum EntryState { NONE, ADDED, CHANGED, REMOVED };
+
+		struct SceneObjectEntry
+		{
+			string id;
+			EntryState state = NONE;
+			MSceneObject added;
+			MSceneObjectUpdate changed;
+		};
+
+		struct AvatarEntry
+		{
+			string id;
+			EntryState state = NONE;
+			MAvatar added;
+			MAvatarUpdate changed;
+		};
+
+		//	The entries in the order of their first appearance
+		vector<SceneObjectEntry> sceneObjects;
+		vector<AvatarEntry> avatars;
+
+		//	The index of the entries structured by the id
+		unordered_map<string, size_t> sceneObjectEntries;
+		unordered_map<string, size_t> avatarEntries;
+
+		//	Set if the updates can not be expressed by a single update (e.g. an object was removed and added again)
+		bool mergeable;
+
+	private:
+		SceneObjectEntry &GetSceneObjectEntry(const string &id);
+		AvatarEntry &GetAvatarEntry(const string &id);
+
+		//	Applies the changes of the update on the scene object / avatar
+		static void ApplyUpdate(MSceneObject &sceneObject, const MSceneObjectUpdate &update);
+		static void ApplyUpdate(MAvatar &avatar, const MAvatarUpdate &update);
+
+		//	Merges the later update into the earlier one
+		static void MergeUpdate(MSceneObjectUpdate &earlier, const MSceneObjectUpdate &later);
+		static void MergeUpdate(MAvatarUpdate &earlier, const MAvatarUpdate &later);
+
+	public:
+		//	Basic constructor
+		SceneUpdateMerger();
+
+		//	Adds the next update, the updates have to be added in the order of application
+		void Append(const MSceneUpdate &sceneUpdate);
+
+		//	Writes the merged update, returns false if the updates can not be merged into a single update
+		bool GetResult(MSceneUpdate &_return) const;
+	};
+}
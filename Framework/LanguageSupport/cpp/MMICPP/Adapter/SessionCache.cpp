@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "SessionCache.h"
+#include "SessionContent.h"
+#include "SessionData.h"
+#include "SessionHandling.h"
+#include "SessionTools.h"
+#include <ctime>
+
+using namespace MMIStandard;
+
+SessionCache::SessionCache() :generation{ 0 }
+{
+}
+
+SessionHandle SessionCache::Resolve(const string & sessionID, Entry *& entry)
+{
+	// a removed session may still be referenced by the entries, therefore all entries are dropped
+	size_t currentGeneration = SessionData::sessionGeneration.load(memory_order_acquire);
+	if (currentGeneration != this->generation)
+	{
+		this->entries.clear();
+		this->generation = currentGeneration;
+	}
+
+	auto it = this->entries.find(sessionID);
+	if (it != this->entries.end())
+	{
+		// the session may have been removed after the generation was checked
+		// if the cleaner removes it before the last access is updated, the call still completes since the MMUs are disposed once the session is released
+		SessionHandle sessionContent = it->second.sessionContent.lock();
+		if (sessionContent != nullptr)
+		{
+			sessionContent->lastAccess.store(time(0), memory_order_relaxed);
+			entry = &it->second;
+			return sessionContent;
+		}
+		this->entries.erase(it);
+	}
+
+	vector<string> ids = SessionTools::GetSplittedIds(sessionID);
+	SessionHandle sessionContent = SessionHandling::GetSessionContentBySceneID(ids[0]);
+	Entry newEntry;
+	newEntry.sessionContent = sessionContent;
+	newEntry.avatarContent = nullptr;
+	newEntry.sceneID = move(ids[0]);
+	newEntry.avatarID = move(ids[1]);
+	entry = &this->entries.emplace(sessionID, move(newEntry)).first->second;
+	return sessionContent;
+}
+
+SessionHandle SessionCache::GetSessionContent(const string & sessionID)
+{
+	Entry *entry;
+	return this->Resolve(sessionID, entry);
+}
+
+shared_ptr<const AvatarContent> SessionCache::GetAvatarContent(const string & sessionID)
+{
+	Entry *entry;
+	SessionHandle sessionContent = this->Resolve(sessionID, entry);
+
+	// the avatar content may be created after the session, so a missing avatar is looked up again on the next call
+	if (entry->avatarContent == nullptr)
+		entry->avatarContent = &sessionContent->GetAvatarContentByAvatarID(entry->avatarID);
+
+	// the avatar content is owned by the session, so the handle of the session keeps it alive
+	return shared_ptr<const AvatarContent>(sessionContent, entry->avatarContent);
+}
+
+shared_ptr<MotionModelUnitBaseIf> SessionCache::GetMMUbyId(const string & sessionID, const string & mmuID)
+{
+	shared_ptr<const AvatarContent> avatarContent = this->GetAvatarContent(sessionID);
+	shared_ptr<MotionModelUnitBaseIf> mmu = avatarContent->GetMMUbyId(mmuID);
+
+	// the MMU uses the scene and services of the session, so the handle keeps both the session and the MMU alive
+	MotionModelUnitBaseIf *instance = mmu.get();
+	return shared_ptr<MotionModelUnitBaseIf>(instance, [avatarContent, mmu](MotionModelUnitBaseIf*) {});
+}
+
+const string & SessionCache::GetSceneID(const string & sessionID)
+{
+	Entry *entry;
+	this->Resolve(sessionID, entry);
+	return entry->sceneID;
+}
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include "SessionTable.h"
+
+class MotionModelUnitBaseIf;
+
+using namespace std;
+namespace MMIStandard {
+	class SessionContent;
+	class AvatarContent;
+
+	class SessionCache
+	{
+		/*
+			Resolves session ids (sceneID:avatarID) to the session and avatar content with a single lookup.
+			The ids are only split on the first use of a session id, further calls do not allocate.
+			All entries are dropped once any session is removed (see SessionData::sessionGeneration), so no removed content is returned.
+			The entries do not keep the sessions alive, the returned handles keep the session alive until the call has finished.
+			The cache is not synchronized, each connection uses its own cache (see ThriftAdapterImplementation).
+		*/
+	private:
+		struct Entry
+		{
+			weak_ptr<const SessionContent> sessionContent;
+
+			//	The avatar content, nullptr until the avatar has been created
+			const AvatarContent *avatarContent;
+
+			string sceneID;
+			string avatarID;
+		};
+
+		//	The resolved sessions structured by the session id
+		unordered_map<string, Entry> entries;
+
+		//	The session generation the entries were resolved in
+		size_t generation;
+
+	private:
+		//	Returns the session of the session id and its entry, resolves it if it is not cached
+		SessionHandle Resolve(const string &sessionID, Entry *&entry);
+
+	public:
+		//	Basic constructor
+		SessionCache();
+
+		//	Returns the session content of the session id, throws a runtime_error if there is no session
+		SessionHandle GetSessionContent(const string &sessionID);
+
+		//	Returns the avatar content of the session id, throws a runtime_error if there is no session or avatar
+		//	The handle keeps the session alive
+		shared_ptr<const AvatarContent> GetAvatarContent(const string &sessionID);
+
+		//	Returns the MMU of the session, throws a runtime_error if there is no session, avatar or MMU
+		//	The handle keeps the session and the MMU alive, also if the MMU is replaced during the call
+		shared_ptr<MotionModelUnitBaseIf> GetMMUbyId(const string &sessionID, const string &mmuID);
+
+		//	Returns the scene id of the session id, throws a runtime_error if there is no session
+		//	The reference is valid until the next call of the cache
+		const string &GetSceneID(const string &sessionID);
+	};
+}
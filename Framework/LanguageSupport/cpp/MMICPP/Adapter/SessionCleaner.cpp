@@ -3,76 +3,127 @@
 // Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
 
 #include "SessionCleaner.h"
+#include "SessionHandling.h"
+#include "SessionTools.h"
+#include "Utils/Logger.h"
+#include "boost/exception/diagnostic_information.hpp"
 
 using namespace MMIStandard;
 using namespace std;
 
-SessionCleaner::SessionCleaner(SessionData* SessionDataRef)
-	:timeOut( 0 ),
-	updateTime( 0 ),
-	sessionManagerThread(nullptr),
-	SessionDataRef(nullptr)
+atomic<uint64_t> SessionCleaner::evictedSessions{ 0 };
+atomic<uint64_t> SessionCleaner::disposedMMUs{ 0 };
+atomic<uint64_t> SessionCleaner::reclaimedBytes{ 0 };
+
+SessionCleaner::SessionCleaner(int timeOut)
+	:timeOut( timeOut ),
+	stopping( false )
 {
-	this->SessionDataRef = SessionDataRef;
-	this->sessionManagerThread = new thread(&SessionCleaner::manageSessions, this);	
 }
 
 SessionCleaner::~SessionCleaner()
 {
-	if (this->sessionManagerThread != nullptr)
-	{
-		this->sessionManagerThread->join();
-		this->sessionManagerThread->~thread();
-		delete this->sessionManagerThread;
-	}
-	this->sessionManagerThread = nullptr;
+	this->dispose();
 }
 
 
 void SessionCleaner::start()
 {
-	if (this->sessionManagerThread != nullptr)
+	if (this->timeOut <= 0 || this->sessionManagerThread.joinable())
+		return;
+
 	{
-		if (!this->sessionManagerThread->joinable())
-		{
-			this->sessionManagerThread = new thread(&SessionCleaner::manageSessions, this);
-		}
+		lock_guard<mutex> guard(this->stopMutex);
+		this->stopping = false;
 	}
+	Logger::printLog(L_INFO, "Sessions which are unused for " + std::to_string(this->timeOut) + " s are removed");
+	this->sessionManagerThread = thread(&SessionCleaner::manageSessions, this);
 }
 
 void SessionCleaner::dispose()
 {
-	if (this->sessionManagerThread != nullptr)
+	if (!this->sessionManagerThread.joinable())
+		return;
+
 	{
-		if (!this->sessionManagerThread->joinable())
-		{
-			this->sessionManagerThread->join();
-			this->sessionManagerThread->~thread();
-			delete this->sessionManagerThread;
-		}
-		this->sessionManagerThread = nullptr;
+		lock_guard<mutex> guard(this->stopMutex);
+		this->stopping = true;
 	}
+	this->stopCondition.notify_all();
+	this->sessionManagerThread.join();
+}
+
+void SessionCleaner::Report(map<string, string>& _return)
+{
+	_return["Evicted Sessions"] = std::to_string(evictedSessions.load(memory_order_relaxed));
+	_return["Disposed MMUs"] = std::to_string(disposedMMUs.load(memory_order_relaxed));
+	_return["Reclaimed Memory"] = std::to_string(reclaimedBytes.load(memory_order_relaxed)) + " bytes";
 }
 
 void SessionCleaner::manageSessions()
 {
-	if (this->sessionManagerThread != nullptr)
+	unique_lock<mutex> guard(this->stopMutex);
+	while (!this->stopping)
 	{
-		//while (this->sessionManagerThread->joinable())
-		//{
-		//	//TODO: set thread to sleep 
-		//	
-		//	//check all sessions for timeout
-		//	int *numSesCont = this->SessionDataRef->SessionContents->size;
+		guard.unlock();
+		time_t nextExpiry = this->removeExpiredSessions(time(0));
+		guard.lock();
 
-		//	for (*int i = this->SessionDataRef->SessionContents->size - 1; i >= 0; i--)
-		//	{
-		//		SessionContent sessionContentVal = this->SessionDataRef->;
+		// a session which is created in the meantime expires after the timeout at the earliest
+		auto wakeUp = chrono::system_clock::from_time_t(nextExpiry);
+		this->stopCondition.wait_until(guard, wakeUp, [this] { return this->stopping; });
+	}
+}
 
-		//	}
+time_t SessionCleaner::removeExpiredSessions(time_t now)
+{
+	time_t nextExpiry = now + this->timeOut;
 
-		//}
+	for (const shared_ptr<SessionContent> &sessionContent : SessionData::SessionContents.GetAll())
+	{
+		time_t expiry = sessionContent->lastAccess.load(memory_order_relaxed) + this->timeOut;
+		if (expiry > now)
+		{
+			if (expiry < nextExpiry)
+				nextExpiry = expiry;
+			continue;
+		}
+
+		// the last access is checked again while the session is removed, a session which has been resolved in the meantime is kept
+		// a session which was closed and created again with the same scene id in the meantime is kept as well
+		string sceneID = SessionTools::GetSplittedIds(sessionContent->sessionID)[0];
+		if (!SessionHandling::RemoveExpiredSessionContent(sceneID, sessionContent.get(), now - this->timeOut))
+			continue;
+
+		Logger::printLog(L_INFO, "Remove unused session: " + sessionContent->sessionID);
+
+		// calls which resolved the session before it was removed may still use its MMUs, so they are disposed once the session is released
+		sessionContent->disposeMMUs.store(true, memory_order_release);
+		evictedSessions.fetch_add(1, memory_order_relaxed);
+		reclaimedBytes.fetch_add(sessionContent->sceneBuffer->GetMemoryUsage(), memory_order_relaxed);
 	}
-}
 
+	return nextExpiry;
+}
 
+void SessionCleaner::DisposeMMUs(const SessionContent & sessionContent)
+{
+	uint64_t mmuCount = 0;
+	for (const AvatarContent *avatarContent : sessionContent.GetAvatarContents())
+	{
+		for (const shared_ptr<MotionModelUnitBaseIf> &mmu : avatarContent->GetMMUs())
+		{
+			try
+			{
+				MBoolResponse response;
+				mmu->Dispose(response, map<string, string>{});
+				mmuCount++;
+			}
+			catch (...)
+			{
+				Logger::printLog(L_ERROR, "Failed to dispose MMU of session " + sessionContent.sessionID + ": " + boost::current_exception_diagnostic_information());
+			}
+		}
+	}
+	disposedMMUs.fetch_add(mmuCount, memory_order_relaxed);
+}
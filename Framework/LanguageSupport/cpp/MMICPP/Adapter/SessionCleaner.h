@@ -5,46 +5,77 @@
 #pragma once
 #include <thread>
 #include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <map>
+#include <string>
 #include "SessionData.h"
 
 using namespace MMIStandard;
 using namespace std;
 
 namespace MMIStandard {
-	// cleans the session based on a timeout 
+	// cleans the session based on a timeout
 	class SessionCleaner
 	{
+		/*
+			Removes the sessions which have not been used for the timeout (see SessionContent::lastAccess).
+			The MMUs of a removed session are disposed once the last running call has released the session (see SessionContent::disposeMMUs),
+			so an MMU is never disposed while one of its calls is still running.
+			The thread sleeps until the next session can expire, it is woken up for dispose.
+		*/
+
 		// member fields
 	public:
+		// the number of seconds a session may be unused
 		int timeOut;
-		int updateTime;
+
+		// the number of removed sessions, disposed MMUs and the estimated memory of the removed scenes
+		static atomic<uint64_t> evictedSessions;
+		static atomic<uint64_t> disposedMMUs;
+		static atomic<uint64_t> reclaimedBytes;
 
 	private:
 
 		// the utilized thread
-		thread* sessionManagerThread;
+		thread sessionManagerThread;
 
-		// assigned session data to monitor
-		SessionData* SessionDataRef;
-
-		//int* numSesCont;
+		// wakes the thread up for dispose
+		mutex stopMutex;
+		condition_variable stopCondition;
+		bool stopping;
 
 		// methods
 	public:
 		// constructor
-		SessionCleaner(SessionData* SessionDataRef);
+		// <param name="timeOut">The number of seconds a session may be unused, the cleaner is disabled if it is 0 or less</param>
+		SessionCleaner(int timeOut);
 
-		// destructor
+		// destructor, disposes the thread
 		~SessionCleaner();
 
+		SessionCleaner(const SessionCleaner&) = delete;
+		SessionCleaner& operator=(const SessionCleaner&) = delete;
+
 		// start the thread
 		void start();
 
-		// dispose the thread 
+		// dispose the thread
 		void dispose();
 
+		// returns the statistics of the cleaner for GetStatus
+		static void Report(map<string, string> &_return);
+
+		// disposes the MMUs of an evicted session, is called when the session is destroyed
+		static void DisposeMMUs(const SessionContent &sessionContent);
+
 	private:
-		// manage and clean the sessions 
+		// manage and clean the sessions
 		void manageSessions();
+
+		// removes the sessions which have expired, their MMUs are disposed once the sessions are released
+		// returns the time the next session can expire at the earliest
+		time_t removeExpiredSessions(time_t now);
 	};
 }
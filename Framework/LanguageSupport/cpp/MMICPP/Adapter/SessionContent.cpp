@@ -5,14 +5,21 @@
 #include "SessionContent.h"
 #include "SessionData.h"
 #include "Adapter/SessionTools.h"
+#include "SessionCleaner.h"
 
 
-SessionContent::SessionContent(string sessionId) :sessionID{ sessionId },lastAccess{0}
+SessionContent::SessionContent(string sessionId) :sessionID{ sessionId },lastAccess{ time(0) },disposeMMUs{ false }
 {
 	this->serviceAccess = make_unique<ServiceAccess>(SessionData::GetRegisterAddress(),sessionID);
 	this->sceneBuffer = make_unique<MMIScene>();
 }
 
+SessionContent::~SessionContent()
+{
+	if (this->disposeMMUs.load(memory_order_acquire))
+		SessionCleaner::DisposeMMUs(*this);
+}
+
 ServiceAccess  & SessionContent::GetServiceAccess() const
 {
 	return *(this->serviceAccess);
@@ -30,6 +37,7 @@ const AvatarContent & SessionContent::GetAvatarContentBySessionID(string session
 
 const AvatarContent & MMIStandard::SessionContent::GetAvatarContentByAvatarID(string avatarID) const
 {
+	shared_lock<shared_mutex> guard(this->avatarLock);
 	auto avatarContentIt = avatarContent.find(avatarID);
 	if (avatarContentIt != avatarContent.end()) //avatar content  available
 	{
@@ -41,6 +49,35 @@ const AvatarContent & MMIStandard::SessionContent::GetAvatarContentByAvatarID(st
 	}
 }
 
+AvatarContent & SessionContent::GetOrCreateAvatarContent(const string & avatarID, bool & created)
+{
+	unique_lock<shared_mutex> guard(this->avatarLock);
+	auto avatarContentIt = avatarContent.find(avatarID);
+	created = avatarContentIt == avatarContent.end();
+	if (created)
+		avatarContentIt = avatarContent.emplace(avatarID, make_unique<AvatarContent>(avatarID)).first;
+	return *avatarContentIt->second;
+}
 
+vector<const AvatarContent*> SessionContent::GetAvatarContents() const
+{
+	shared_lock<shared_mutex> guard(this->avatarLock);
+	vector<const AvatarContent*> avatarContents;
+	avatarContents.reserve(avatarContent.size());
+	for (const auto &avatar : avatarContent)
+		avatarContents.emplace_back(avatar.second.get());
+	return avatarContents;
+}
 
-
+shared_ptr<const CollisionWorld> SessionContent::GetCollisionWorld() const
+{
+	lock_guard<mutex> guard(this->collisionLock);
+	if (this->collisionWorld == nullptr || this->collisionWorld->GetFrameID() != this->sceneBuffer->GetVisibleFrameID())
+	{
+		// a new world is built, the previous one may still be queried by other threads
+		shared_ptr<CollisionWorld> world = make_shared<CollisionWorld>();
+		world->Build(*this->sceneBuffer);
+		this->collisionWorld = move(world);
+	}
+	return this->collisionWorld;
+}
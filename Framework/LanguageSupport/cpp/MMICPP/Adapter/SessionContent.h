@@ -5,7 +5,13 @@
 #pragma once
 #include "MMIScene.h"
 #include "Access/ServiceAccess.h"
-#include <concurrent_unordered_map.h>
+#include "Collision/CollisionWorld.h"
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <vector>
+#include <atomic>
+#include <ctime>
 #include "AvatarContent.h"
 
 using namespace std;
@@ -24,19 +30,36 @@ namespace MMIStandard {
 		//	The corresponding service access
 		unique_ptr<ServiceAccess> serviceAccess;
 
-		//	The avatar contents of the specific session
-		mutable Concurrency::concurrent_unordered_map<std::string, unique_ptr<AvatarContent>> avatarContent;
+		//	The avatar contents of the specific session, avatars are only added and removed with the session
+		unordered_map<std::string, unique_ptr<AvatarContent>> avatarContent;
+
+		//	Guards the avatar contents
+		mutable shared_mutex avatarLock;
 
 		//	The id of the session
 		string sessionID;
 
-		// The last time the session was used 
-		time_t lastAccess;
+		// The last time the session was used, is updated by each call which resolves the session (see SessionCache)
+		mutable atomic<time_t> lastAccess;
+
+		//	Whether the MMUs are disposed once the session is destroyed, is set if the session has been evicted by the SessionCleaner
+		//	The session is destroyed after the last running call has released its handle, so no MMU is disposed during a call
+		atomic<bool> disposeMMUs;
+
+	private:
+		//	The broad phase over the colliders of the scene, is replaced once the frame of the scene has changed
+		mutable shared_ptr<const CollisionWorld> collisionWorld;
+
+		//	Guards the collision world, concurrent queries of the same frame build the world only once
+		mutable mutex collisionLock;
 
 	public:
 
 		// Basic constructor
 		SessionContent(string sessionId);
+
+		//	Destructor, disposes the MMUs if the session has been evicted
+		~SessionContent();
 		SessionContent(const SessionContent&) = delete;
 		SessionContent& operator=(const SessionContent&) = delete;
 		SessionContent(SessionContent&&) = delete;
@@ -53,6 +76,18 @@ namespace MMIStandard {
 
 		//  Returns the avatar content based on the avatarID
 		const AvatarContent & GetAvatarContentByAvatarID(string avatarID) const;
+
+		//	Returns the avatar content based on the avatarID, creates it if there is none
+		//	<param name="avatarID">The id of the avatar</param>
+		//	<param name="created">Whether the avatar content was created</param>
+		AvatarContent & GetOrCreateAvatarContent(const string &avatarID, bool &created);
+
+		//	Returns all avatar contents of the session
+		vector<const AvatarContent*> GetAvatarContents() const;
+
+		//	Returns the collision world of the current frame of the scene, it is built on the first query of a frame
+		//	The returned world is not modified anymore and remains valid while the scene changes
+		shared_ptr<const CollisionWorld> GetCollisionWorld() const;
 	};
 }
 
@@ -3,6 +3,7 @@
 // Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
 
 #include "SessionData.h"
+#include <algorithm>
 
 using namespace MMIStandard;
 
@@ -12,8 +13,10 @@ MIPAddress SessionData::registerAddress;
 std::vector<MMUDescription> SessionData::mmuDescriptions;
 std::unordered_map<std::string, std::string> SessionData::mmuPaths;
 time_t SessionData::startTime;
-time_t SessionData::lastAccess=0;
-Concurrency::concurrent_unordered_map<std::string, unique_ptr<SessionContent>> SessionData::SessionContents;
+atomic<time_t> SessionData::lastAccess{ 0 };
+SessionTable SessionData::SessionContents;
+unique_ptr<TaskExecutor> SessionData::stepExecutor;
+atomic<size_t> SessionData::sessionGeneration{ 0 };
  
 
 const MMUDescription &SessionData::GetMMUDescription(string mmuId)
@@ -31,4 +34,10 @@ const MIPAddress & SessionData::GetRegisterAddress()
 	return  registerAddress;
 }
 
-
+void SessionData::CreateStepExecutor(int threadCount)
+{
+	// the thread calling DoStepBatch executes tasks as well, so one thread less than the hardware threads is sufficient
+	if (threadCount <= 0)
+		threadCount = max(1, static_cast<int>(thread::hardware_concurrency()) - 1);
+	stepExecutor = make_unique<TaskExecutor>(static_cast<size_t>(threadCount));
+}
@@ -5,8 +5,11 @@
 #pragma once
 #include "gen-cpp/mmu_types.h"
 #include "gen-cpp/MMIAdapter.h"
-#include <concurrent_unordered_map.h>
 #include "SessionContent.h"
+#include "SessionTable.h"
+#include "TaskExecutor.h"
+#include <memory>
+#include <atomic>
 
 using namespace MMIStandard;
 using namespace std;
@@ -24,6 +27,7 @@ namespace MMIStandard {
 		friend class FileWatcher;
 		friend class SessionHandling;
 		friend class SessionCleaner;
+		friend class SessionCache;
 	private:
 
 		//	The description of the adapter
@@ -32,8 +36,8 @@ namespace MMIStandard {
 		//	The address of the MMIRegister
 		static MIPAddress registerAddress;
 
-		//	The last time the adapter was used 
-		static time_t lastAccess;
+		//	The last time the adapter was used, is written by the calls of all connections
+		static atomic<time_t> lastAccess;
 
 		//	The time when the adapter was started
 		static time_t startTime;
@@ -44,8 +48,14 @@ namespace MMIStandard {
 		//	The paths to the Assemblies
 		static std::unordered_map<std::string, std::string> mmuPaths; //id,MMUpath
 
-		//	Map which contains all sessions
-		static Concurrency::concurrent_unordered_map<std::string, unique_ptr <SessionContent>> SessionContents;
+		//	Map which contains all sessions structured by the scene id
+		static SessionTable SessionContents;
+
+		//	Is incremented after a session content has been removed, invalidates the resolved sessions (see SessionCache)
+		static atomic<size_t> sessionGeneration;
+
+		//	The pool which executes the MMUs of independent avatars in parallel, the MMUs are executed sequentially if there is none
+		static unique_ptr<TaskExecutor> stepExecutor;
 
 	public:
 
@@ -55,6 +65,10 @@ namespace MMIStandard {
 		//Getter for the register address
 		static const MIPAddress &GetRegisterAddress();
 
+		//	Creates the pool which executes the MMUs of independent avatars, must be called before the server is started
+		//	<param name="threadCount">The number of threads, 0 uses the hardware threads</param>
+		static void CreateStepExecutor(int threadCount);
+
 		SessionData(const SessionData&) = delete;
 		SessionData& operator=(const SessionData&) = delete;
 		SessionData(SessionData&&) = delete;
@@ -9,17 +9,17 @@
 #include "Utils/Logger.h"
 
 
-const SessionContent &SessionHandling::GetSessionContentBySessionID(const string & sessionID)
+SessionHandle MMIStandard::SessionHandling::GetSessionContentBySceneID(const string & sceneID)
 {
-	return GetSessionContentBySceneID(SessionTools::GetSplittedIds(sessionID)[0]);
+	return GetModifiableSessionContentBySceneID(sceneID);
 }
 
-const SessionContent & MMIStandard::SessionHandling::GetSessionContentBySceneID(const string & sceneID)
+shared_ptr<SessionContent> SessionHandling::GetModifiableSessionContentBySceneID(const string & sceneID)
 {
-	auto it = SessionData::SessionContents.find(sceneID);
-	if (it != SessionData::SessionContents.end())
+	shared_ptr<SessionContent> sessionContent = SessionData::SessionContents.Find(sceneID);
+	if (sessionContent != nullptr)
 	{
-		return *it->second;
+		return sessionContent;
 	}
 	else
 	{
@@ -27,65 +27,57 @@ const SessionContent & MMIStandard::SessionHandling::GetSessionContentBySceneID(
 	}
 }
 
-const SessionContent & SessionHandling::CreateSessionContent(const string & sessionId)
+SessionHandle SessionHandling::CreateSessionContent(const string & sessionId)
 {
 		std::vector<string> splittedIds = SessionTools::GetSplittedIds(sessionId);
 		std::string sceneId = splittedIds[0];
 		std::string avatarId = splittedIds[1];
 
 		//check if session content is already available 
-		auto it = SessionData::SessionContents.find(sceneId);
-		if (it != SessionData::SessionContents.end())
+		shared_ptr<SessionContent> sessionContent = SessionData::SessionContents.Find(sceneId);
+		if (sessionContent == nullptr)
 		{
-			//check if existing session content has already the avatar content
-			auto avatarContentIt = it->second->avatarContent.find(avatarId);
-			if (avatarContentIt == it->second->avatarContent.end()) //avatar content not available
-			{
-
-				it->second->avatarContent[avatarId] = make_unique<AvatarContent>(avatarId);
-				return *SessionData::SessionContents[sceneId];
-			}
-			else
-			{
-				throw runtime_error("Unable to create session: session and avatar content already available");
-			}	
+			//a concurrent call may create the session content of the same scene, then its session content is used
+			bool inserted;
+			sessionContent = SessionData::SessionContents.Insert(sceneId, make_shared<SessionContent>(sessionId), inserted);
+			if (inserted)
+				Logger::printLog(L_INFO, "Create new session: " + sessionId);
 		}
-		else
-		{
-			Logger::printLog(L_INFO, "Create new session: " + sessionId);
-			unique_ptr <AvatarContent> avatarContent = make_unique<AvatarContent>(avatarId);
-			unique_ptr <SessionContent> sessionContent = make_unique<SessionContent>(sessionId);
-			sessionContent->avatarContent[avatarId] = move(avatarContent);
-			SessionData::SessionContents[sceneId] = move(sessionContent);
 
-			//TODO check
-			return *sessionContent;
+		//check if existing session content has already the avatar content
+		bool created;
+		sessionContent->GetOrCreateAvatarContent(avatarId, created);
+		if (!created)
+		{
+			throw runtime_error("Unable to create session: session and avatar content already available");
 		}
+		return sessionContent;
 }
 
 void SessionHandling::RemoveSessionContent(const string & sessionID)
 {
-	auto it = SessionData::SessionContents.find(SessionTools::GetSplittedIds(sessionID)[0]);
-	if (it != SessionData::SessionContents.end())
+	RemoveSessionContentBySceneID(SessionTools::GetSplittedIds(sessionID)[0]);
+}
+
+SessionHandle SessionHandling::RemoveSessionContentBySceneID(const string & sceneID, const SessionContent *expected)
+{
+	SessionHandle removed = SessionData::SessionContents.Remove(sceneID, expected);
+	if (removed != nullptr)
 	{
-		SessionData::SessionContents.unsafe_erase(it);
+		SessionData::sessionGeneration++;
+		return removed;
 	}
 	else
 	{
-		throw runtime_error("Can not find Session content with ID: " + sessionID);		
+		throw runtime_error("Can not find Session content with ID: " + sceneID);		
 	}	
 }
 
-MotionModelUnitBaseIf & MMIStandard::SessionHandling::GetMMUbyId(const string & sessionID, const string & mmuId)
+bool SessionHandling::RemoveExpiredSessionContent(const string & sceneID, const SessionContent * expected, time_t unusedSince)
 {
-	return GetAvatarContentBySessionID(sessionID).GetMMUbyId(mmuId);
-}
+	if (SessionData::SessionContents.RemoveExpired(sceneID, expected, unusedSince) == nullptr)
+		return false;
 
-const AvatarContent & MMIStandard::SessionHandling::GetAvatarContentBySessionID(string sessionID)
-{
-	vector<string> splitted = SessionTools::GetSplittedIds(sessionID);
-	return GetSessionContentBySceneID(splitted[0]).GetAvatarContentByAvatarID(splitted[1]);
+	SessionData::sessionGeneration++;
+	return true;
 }
-
-
-
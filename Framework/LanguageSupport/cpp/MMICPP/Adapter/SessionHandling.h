@@ -5,6 +5,7 @@
 #pragma once
 #include <string>
 #include "SessionContent.h"
+#include "SessionTable.h"
 
 using namespace std;
 namespace MMIStandard {
@@ -15,27 +16,32 @@ namespace MMIStandard {
 			Helper class for session handling
 		*/
 
-		//only ThriftAdapterImplementation can access the functions
+		//only ThriftAdapterImplementation, its SessionCache and the SessionCleaner can access the functions
 		friend class ThriftAdapterImplementation;
+		friend class SessionCache;
+		friend class SessionCleaner;
 
 	private:
-		//	 Returns the session content based on the session id
-		static const SessionContent & GetSessionContentBySessionID(const string &sessionID);
+		//	 Returns the session content based on the scene id, the handle keeps the session alive
+		static SessionHandle GetSessionContentBySceneID(const string &sceneID);
 
-		//	 Returns the session content based on the scene id
-		static const SessionContent & GetSessionContentBySceneID(const string &sceneID);
+		//	 Returns the session content based on the scene id for modifications, e.g. adding avatars and MMUs
+		static shared_ptr<SessionContent> GetModifiableSessionContentBySceneID(const string &sceneID);
 
-		//	Creates a new session content
-		static const SessionContent & CreateSessionContent(const string &sessionID);
+		//	Creates a new session content, or adds the avatar to the existing session content of the scene
+		static SessionHandle CreateSessionContent(const string &sessionID);
 
 		//	Deletes a session content based on the session id
 		static void RemoveSessionContent(const string &sessionId);
 
-		//	get the MMU based on the SessionID and the mmuID
-		static MotionModelUnitBaseIf &GetMMUbyId(const string &sessionID,const string &mmuId);
+		//	Deletes a session content based on the scene id
+		//	<param name="expected">If set, the session content is only removed if it is the expected one</param>
+		//	Returns the removed session content, it is destroyed once the handle and the handles of the running calls are released
+		static SessionHandle RemoveSessionContentBySceneID(const string &sceneID, const SessionContent *expected = nullptr);
 
-		//	get the Avatarcontent bsed on the sessionID and the mmuID
-		static const  AvatarContent & GetAvatarContentBySessionID(string sessionID);
+		//	Deletes the session content of the scene id if it is the expected one and has not been used since unusedSince (see SessionTable::RemoveExpired)
+		//	Returns false if the session content has been used or removed in the meantime
+		static bool RemoveExpiredSessionContent(const string &sceneID, const SessionContent *expected, time_t unusedSince);
 	};
 }
 
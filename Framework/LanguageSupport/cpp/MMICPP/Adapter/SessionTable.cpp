@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "SessionTable.h"
+#include "SessionContent.h"
+#include <mutex>
+
+using namespace MMIStandard;
+
+SessionTable::SessionTable() :count{ 0 }
+{
+}
+
+SessionTable::Shard & SessionTable::GetShard(const string & sceneID)
+{
+	return this->shards[hash<string>{}(sceneID) % ShardCount];
+}
+
+const SessionTable::Shard & SessionTable::GetShard(const string & sceneID) const
+{
+	return this->shards[hash<string>{}(sceneID) % ShardCount];
+}
+
+shared_ptr<SessionContent> SessionTable::Find(const string & sceneID) const
+{
+	const Shard &shard = this->GetShard(sceneID);
+	shared_lock<shared_mutex> guard(shard.lock);
+
+	auto it = shard.sessions.find(sceneID);
+	if (it == shard.sessions.end())
+		return nullptr;
+
+	it->second->lastAccess.store(time(0), memory_order_relaxed);
+	return it->second;
+}
+
+shared_ptr<SessionContent> SessionTable::Insert(const string & sceneID, shared_ptr<SessionContent> sessionContent, bool & inserted)
+{
+	Shard &shard = this->GetShard(sceneID);
+	unique_lock<shared_mutex> guard(shard.lock);
+
+	auto result = shard.sessions.emplace(sceneID, move(sessionContent));
+	inserted = result.second;
+	if (inserted)
+		this->count.fetch_add(1, memory_order_relaxed);
+	return result.first->second;
+}
+
+shared_ptr<SessionContent> SessionTable::Remove(const string & sceneID, const SessionContent * expected)
+{
+	return this->RemoveIf(sceneID, [expected](const SessionContent &sessionContent)
+	{
+		return expected == nullptr || &sessionContent == expected;
+	});
+}
+
+shared_ptr<SessionContent> SessionTable::RemoveExpired(const string & sceneID, const SessionContent * expected, time_t unusedSince)
+{
+	return this->RemoveIf(sceneID, [expected, unusedSince](const SessionContent &sessionContent)
+	{
+		return &sessionContent == expected && sessionContent.lastAccess.load(memory_order_relaxed) <= unusedSince;
+	});
+}
+
+shared_ptr<SessionContent> SessionTable::RemoveIf(const string & sceneID, const function<bool(const SessionContent&)>& predicate)
+{
+	shared_ptr<SessionContent> removed;
+	{
+		Shard &shard = this->GetShard(sceneID);
+		unique_lock<shared_mutex> guard(shard.lock);
+
+		auto it = shard.sessions.find(sceneID);
+		if (it == shard.sessions.end() || !predicate(*it->second))
+			return nullptr;
+
+		removed = move(it->second);
+		shard.sessions.erase(it);
+		this->count.fetch_sub(1, memory_order_relaxed);
+	}
+	// the session is destroyed outside of the lock if this was the last handle
+	return removed;
+}
+
+size_t SessionTable::Size() const
+{
+	return this->count.load(memory_order_relaxed);
+}
+
+vector<shared_ptr<SessionContent>> SessionTable::GetAll() const
+{
+	vector<shared_ptr<SessionContent>> sessions;
+	sessions.reserve(this->Size());
+	for (const Shard &shard : this->shards)
+	{
+		shared_lock<shared_mutex> guard(shard.lock);
+		for (const auto &session : shard.sessions)
+			sessions.emplace_back(session.second);
+	}
+	return sessions;
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <array>
+#include <atomic>
+#include <shared_mutex>
+#include <functional>
+#include <ctime>
+
+using namespace std;
+namespace MMIStandard {
+	class SessionContent;
+
+	//	Keeps a session content alive while it is used, also if the session is removed in the meantime
+	typedef shared_ptr<const SessionContent> SessionHandle;
+
+	class SessionTable
+	{
+		/*
+			Concurrent map of the session contents structured by the scene id.
+			The sessions are distributed over shards by the hash of the scene id, each shard has its own reader/writer lock,
+			so lookups of different sessions do not contend and only creating or removing a session locks a shard exclusively.
+			The lookups return reference counted handles: a removed session is destroyed once the last call which uses it has finished.
+		*/
+	private:
+		static const size_t ShardCount = 16;
+
+		//	Aligned to a cache line, so the locks of neighbouring shards do not share a cache line
+		struct alignas(64) Shard
+		{
+			mutable shared_mutex lock;
+			unordered_map<string, shared_ptr<SessionContent>> sessions;
+		};
+
+		array<Shard, ShardCount> shards;
+
+		//	The number of sessions of all shards
+		atomic<size_t> count;
+
+	private:
+		//	Returns the shard of the scene id
+		Shard &GetShard(const string &sceneID);
+		const Shard &GetShard(const string &sceneID) const;
+
+		//	Removes the session of the scene id if the predicate holds, the predicate is evaluated under the lock of the shard
+		shared_ptr<SessionContent> RemoveIf(const string &sceneID, const function<bool(const SessionContent&)> &predicate);
+
+	public:
+		//	Basic constructor
+		SessionTable();
+
+		SessionTable(const SessionTable&) = delete;
+		SessionTable& operator=(const SessionTable&) = delete;
+
+		//	Returns the session of the scene id, nullptr if there is none
+		//	The last access of the session is updated under the lock of the shard (see RemoveExpired)
+		shared_ptr<SessionContent> Find(const string &sceneID) const;
+
+		//	Adds the session if there is no session with the scene id
+		//	Returns the session of the scene id, inserted is false if an existing session is returned
+		//	<param name="sceneID">The scene id of the session</param>
+		//	<param name="sessionContent">The session which is added</param>
+		//	<param name="inserted">Whether the session was added</param>
+		shared_ptr<SessionContent> Insert(const string &sceneID, shared_ptr<SessionContent> sessionContent, bool &inserted);
+
+		//	Removes the session of the scene id, returns the removed session or nullptr if there is none
+		//	<param name="sceneID">The scene id of the session</param>
+		//	<param name="expected">If set, the session is only removed if it is the expected one</param>
+		shared_ptr<SessionContent> Remove(const string &sceneID, const SessionContent *expected = nullptr);
+
+		//	Removes the session of the scene id if it is the expected one and has not been used since unusedSince
+		//	The last access is checked under the lock of the shard, so a lookup with Find either keeps the session or fails
+		//	Returns the removed session or nullptr if it has been used or replaced in the meantime
+		shared_ptr<SessionContent> RemoveExpired(const string &sceneID, const SessionContent *expected, time_t unusedSince);
+
+		//	Returns the number of sessions
+		size_t Size() const;
+
+		//	Returns a snapshot of all sessions, the sessions may be removed while the snapshot is used
+		vector<shared_ptr<SessionContent>> GetAll() const;
+	};
+}
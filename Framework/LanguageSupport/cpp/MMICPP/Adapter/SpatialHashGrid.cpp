@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "SpatialHashGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+//	cell coordinates are clamped to 21 bit per axis so that they fit into a single 64 bit key
+static const int64_t maxCellCoordinate = (1 << 20) - 1;
+
+//	marks handles which are not indexed, no valid key has the sign bit set
+static const int64_t noCell = -1;
+
+SpatialHashGrid::SpatialHashGrid(const TransformStore &transforms, double cellSize) :transforms{ transforms }, cellSize{ cellSize }, count{ 0 }
+{
+	if (!(cellSize > 0))
+	{
+		throw runtime_error("Can not create SpatialHashGrid: cell size has to be greater than 0");
+	}
+}
+
+int64_t SpatialHashGrid::CellCoordinate(double value) const
+{
+	double coordinate = std::floor(value / this->cellSize);
+	if (!(coordinate > -maxCellCoordinate)) // also catches NaN
+		return -maxCellCoordinate;
+	if (coordinate > maxCellCoordinate)
+		return maxCellCoordinate;
+	return static_cast<int64_t>(coordinate);
+}
+
+int64_t SpatialHashGrid::CellKey(int64_t x, int64_t y, int64_t z)
+{
+	const int64_t mask = (int64_t{ 1 } << 21) - 1;
+	return ((x & mask) << 42) | ((y & mask) << 21) | (z & mask);
+}
+
+void SpatialHashGrid::RemoveFromCell(int64_t cellKey, Handle handle)
+{
+	auto cellIter = this->cells.find(cellKey);
+	if (cellIter == this->cells.end())
+		return;
+
+	vector<Handle> &handles = cellIter->second;
+	auto handleIter = std::find(handles.begin(), handles.end(), handle);
+	if (handleIter != handles.end())
+	{
+		// order inside a cell is irrelevant, swap with the last element to avoid shifting
+		*handleIter = handles.back();
+		handles.pop_back();
+	}
+
+	if (handles.empty())
+		this->cells.erase(cellIter);
+}
+
+void SpatialHashGrid::Insert(Handle handle)
+{
+	const double *x = this->transforms.PositionX();
+	const double *y = this->transforms.PositionY();
+	const double *z = this->transforms.PositionZ();
+	int64_t cellKey = CellKey(this->CellCoordinate(x[handle]), this->CellCoordinate(y[handle]), this->CellCoordinate(z[handle]));
+
+	if (handle >= this->cellKeys.size())
+		this->cellKeys.resize(handle + 1, noCell);
+
+	int64_t &currentKey = this->cellKeys[handle];
+	if (currentKey == cellKey) // the entry stays in its cell as long as it does not cross a cell border
+		return;
+
+	if (currentKey == noCell)
+		this->count++;
+	else
+		this->RemoveFromCell(currentKey, handle);
+
+	currentKey = cellKey;
+	this->cells[cellKey].emplace_back(handle);
+}
+
+void SpatialHashGrid::Remove(Handle handle)
+{
+	if (handle >= this->cellKeys.size() || this->cellKeys[handle] == noCell)
+		return;
+
+	this->RemoveFromCell(this->cellKeys[handle], handle);
+	this->cellKeys[handle] = noCell;
+	this->count--;
+}
+
+void SpatialHashGrid::Clear()
+{
+	this->cells.clear();
+	this->cellKeys.clear();
+	this->count = 0;
+}
+
+size_t SpatialHashGrid::Size() const
+{
+	return this->count;
+}
+
+void SpatialHashGrid::Query(const MVector3 & position, double range, const function<void(Handle)>& visitor) const
+{
+	if (range < 0 || this->count == 0)
+		return;
+
+	const double rangeSquared = range * range;
+	auto visitCell = [&](const vector<Handle> &handles)
+	{
+		for (Handle handle : handles)
+		{
+			if (this->transforms.DistanceSquared(handle, position) <= rangeSquared)
+				visitor(handle);
+		}
+	};
+
+	int64_t minX = this->CellCoordinate(position.X - range), maxX = this->CellCoordinate(position.X + range);
+	int64_t minY = this->CellCoordinate(position.Y - range), maxY = this->CellCoordinate(position.Y + range);
+	int64_t minZ = this->CellCoordinate(position.Z - range), maxZ = this->CellCoordinate(position.Z + range);
+
+	// for large ranges it is cheaper to scan the occupied cells than to probe every overlapped cell
+	double overlappedCells = double(maxX - minX + 1) * double(maxY - minY + 1) * double(maxZ - minZ + 1);
+	if (overlappedCells >= double(this->cells.size()))
+	{
+		for (const auto &cell : this->cells)
+			visitCell(cell.second);
+		return;
+	}
+
+	for (int64_t x = minX; x <= maxX; x++)
+	{
+		for (int64_t y = minY; y <= maxY; y++)
+		{
+			for (int64_t z = minZ; z <= maxZ; z++)
+			{
+				auto cellIter = this->cells.find(CellKey(x, y, z));
+				if (cellIter != this->cells.end())
+					visitCell(cellIter->second);
+			}
+		}
+	}
+}
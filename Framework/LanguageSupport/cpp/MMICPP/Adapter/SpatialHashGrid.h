@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "gen-cpp/math_types.h"
+#include "TransformStore.h"
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+
+using namespace MMIStandard;
+using namespace std;
+
+namespace MMIStandard {
+	class SpatialHashGrid
+	{
+		/*
+			Uniform grid which is hashed by the cell coordinates and indexes the transforms of a TransformStore by their position,
+			range queries only visit the cells which overlap the query sphere
+		*/
+	private:
+		typedef TransformStore::Handle Handle;
+
+		//	The transforms which are indexed, positions are always read from the store
+		const TransformStore &transforms;
+
+		//	The edge length of a cell
+		double cellSize;
+
+		//	The handles of the entries structured by the key of the cell they are located in
+		unordered_map<int64_t, vector<Handle>> cells;
+
+		//	The key of the cell of every indexed handle, noCell if the handle is not indexed
+		vector<int64_t> cellKeys;
+
+		//	The number of indexed handles
+		size_t count;
+
+	private:
+		//	Returns the cell coordinate of a single axis
+		int64_t CellCoordinate(double value) const;
+
+		//	Packs the three cell coordinates into a single key
+		static int64_t CellKey(int64_t x, int64_t y, int64_t z);
+
+		//	Removes the handle from the given cell
+		void RemoveFromCell(int64_t cellKey, Handle handle);
+
+	public:
+		//	Basic constructor
+		//	<param name="transforms">The store which contains the positions of the indexed handles</param>
+		//	<param name="cellSize">The edge length of a cell, should be in the order of the typical query range</param>
+		SpatialHashGrid(const TransformStore &transforms, double cellSize = 2.0);
+
+		//	Adds the handle or updates its cell after the position in the store has changed
+		//	<param name="handle">The handle of the transform</param>
+		void Insert(Handle handle);
+
+		//	Removes a handle, handles which are not indexed are ignored
+		//	<param name="handle">The handle of the transform</param>
+		void Remove(Handle handle);
+
+		//	Removes all entries
+		void Clear();
+
+		//	Returns the number of indexed entries
+		size_t Size() const;
+
+		//	Calls the visitor for every entry whose distance to the position is less or equal than range
+		//	<param name="position">The center of the query</param>
+		//	<param name="range">The radius of the query</param>
+		//	<param name="visitor">Is called with the handle of each hit</param>
+		void Query(const MVector3 &position, double range, const function<void(Handle)> &visitor) const;
+	};
+}
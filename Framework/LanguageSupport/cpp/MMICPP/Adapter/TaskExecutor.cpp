@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "TaskExecutor.h"
+
+using namespace MMIStandard;
+
+TaskExecutor::TaskExecutor(size_t threadCount) :pending{ 0 }, stopping{ false }, nextQueue{ 0 }
+{
+	for (size_t i = 0; i < threadCount; i++)
+		this->queues.emplace_back(make_unique<Queue>());
+
+	// the threads are started once all queues exist, since they steal from each other
+	for (size_t i = 0; i < threadCount; i++)
+		this->threads.emplace_back(&TaskExecutor::Work, this, i);
+}
+
+TaskExecutor::~TaskExecutor()
+{
+	{
+		lock_guard<mutex> lock(this->sleepLock);
+		this->stopping = true;
+	}
+	this->wake.notify_all();
+
+	for (thread &worker : this->threads)
+		worker.join();
+}
+
+size_t TaskExecutor::ThreadCount() const
+{
+	return this->threads.size();
+}
+
+bool TaskExecutor::TryPop(size_t queueIndex, Task & task)
+{
+	Queue &queue = *this->queues[queueIndex];
+	lock_guard<mutex> lock(queue.lock);
+	if (queue.tasks.empty())
+		return false;
+
+	task = queue.tasks.back();
+	queue.tasks.pop_back();
+	this->pending--;
+	return true;
+}
+
+bool TaskExecutor::TrySteal(size_t queueIndex, Task & task)
+{
+	for (size_t i = 1; i <= this->queues.size(); i++)
+	{
+		Queue &queue = *this->queues[(queueIndex + i) % this->queues.size()];
+		lock_guard<mutex> lock(queue.lock);
+		if (queue.tasks.empty())
+			continue;
+
+		task = queue.tasks.front();
+		queue.tasks.pop_front();
+		this->pending--;
+		return true;
+	}
+	return false;
+}
+
+void TaskExecutor::Execute(const Task & task)
+{
+	Batch &batch = *task.batch;
+	exception_ptr error;
+	try
+	{
+		(*batch.task)(task.index);
+	}
+	catch (...)
+	{
+		error = current_exception();
+	}
+
+	// the batch is owned by the thread waiting in Run, it may be destroyed as soon as the lock is released
+	lock_guard<mutex> lock(batch.lock);
+	if (error && !batch.error)
+		batch.error = error;
+	if (--batch.remaining == 0)
+		batch.done.notify_all();
+}
+
+void TaskExecutor::Work(size_t queueIndex)
+{
+	while (true)
+	{
+		Task task;
+		if (this->TryPop(queueIndex, task) || this->TrySteal(queueIndex, task))
+		{
+			Execute(task);
+			continue;
+		}
+
+		unique_lock<mutex> lock(this->sleepLock);
+		this->wake.wait(lock, [this] { return this->stopping || this->pending > 0; });
+		if (this->stopping && this->pending == 0)
+			return;
+	}
+}
+
+void TaskExecutor::Run(size_t count, const function<void(size_t)>& task)
+{
+	if (count == 0)
+		return;
+
+	// without threads or with a single task the queues only add overhead
+	if (this->queues.empty() || count == 1)
+	{
+		for (size_t i = 0; i < count; i++)
+			task(i);
+		return;
+	}
+
+	Batch batch;
+	batch.task = &task;
+	batch.remaining = count;
+
+	// the tasks are distributed round robin, the start rotates so concurrent batches do not pile up on the first queue
+	// pending is incremented under the lock of the queue, so a thread taking the task can not decrement it before
+	size_t start = this->nextQueue++;
+	for (size_t i = 0; i < count; i++)
+	{
+		Queue &queue = *this->queues[(start + i) % this->queues.size()];
+		lock_guard<mutex> lock(queue.lock);
+		queue.tasks.push_back(Task{ &batch, i });
+		this->pending++;
+	}
+
+	// taking the lock orders the increment before the sleeping threads check it
+	{
+		lock_guard<mutex> lock(this->sleepLock);
+	}
+	this->wake.notify_all();
+
+	// the calling thread steals until the queues are empty, the remaining tasks are being executed by the pool
+	Task stolen;
+	while (this->TrySteal(start, stolen))
+		Execute(stolen);
+
+	unique_lock<mutex> lock(batch.lock);
+	batch.done.wait(lock, [&batch] { return batch.remaining == 0; });
+	if (batch.error)
+		rethrow_exception(batch.error);
+}
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+using namespace std;
+
+namespace MMIStandard {
+	class TaskExecutor
+	{
+		/*
+			Fixed pool of threads which executes independent tasks, e.g. the MMUs of different avatars.
+			Each thread owns a queue, the tasks of a Run call are distributed over the queues and a thread which ran out of tasks steals from the queues of the others.
+			The thread calling Run helps executing until all of its tasks are done, so nested or concurrent Run calls can not starve.
+		*/
+	private:
+		//	The tasks of one Run call
+		struct Batch
+		{
+			const function<void(size_t)> *task;
+			size_t remaining;
+			exception_ptr error;
+			mutex lock;
+			condition_variable done;
+		};
+
+		//	A single task, the index is passed to the task function of the batch
+		struct Task
+		{
+			Batch *batch;
+			size_t index;
+		};
+
+		//	The queue of a thread, the owner takes from the back, thieves take from the front
+		struct Queue
+		{
+			mutex lock;
+			deque<Task> tasks;
+		};
+
+		//	The queues of the threads
+		vector<unique_ptr<Queue>> queues;
+		vector<thread> threads;
+
+		//	The number of queued tasks, is changed under the lock of the queue, the idle threads sleep while it is 0
+		atomic<size_t> pending;
+		mutex sleepLock;
+		condition_variable wake;
+		bool stopping;
+
+		//	The queue which receives the first task of the next Run call
+		atomic<size_t> nextQueue;
+
+	private:
+		//	Takes the newest task of the queue
+		bool TryPop(size_t queueIndex, Task &task);
+
+		//	Takes the oldest task of any queue, starting with the one after the given queue
+		bool TrySteal(size_t queueIndex, Task &task);
+
+		//	Executes the task and signals the batch if it was the last one
+		static void Execute(const Task &task);
+
+		//	The loop of a pool thread
+		void Work(size_t queueIndex);
+
+	public:
+		//	Starts the pool
+		//	<param name="threadCount">The number of threads, 0 executes all tasks on the thread calling Run</param>
+		explicit TaskExecutor(size_t threadCount);
+
+		//	Stops the pool, the queued tasks are executed before
+		~TaskExecutor();
+
+		TaskExecutor(const TaskExecutor&) = delete;
+		TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+		//	Returns the number of pool threads
+		size_t ThreadCount() const;
+
+		//	Executes the task for each index in [0, count) and returns once all are done
+		//	The order of execution is undefined, results have to be written to the slot of the index
+		//	The first exception thrown by a task is rethrown after all tasks are done
+		void Run(size_t count, const function<void(size_t)> &task);
+	};
+}
@@ -12,23 +12,47 @@
 #include "CPPMMUInstantiator.h"
 #include "boost/exception/diagnostic_information.hpp"
 #include <chrono>
+#include <algorithm>
+#include <unordered_set>
 #include "Utils/Logger.h"
 #include "Extensions/MBoolResponseExtensions.h"
+#include "Utils/ThriftSerialization.h"
+#include "RpcMetrics.h"
+#include "SessionCleaner.h"
+#include "Access/ServiceDirectory.h"
+#include <nlohmann/json.hpp>
 
 using namespace std;
+using json = nlohmann::json;
+
+const std::string ThriftAdapterImplementation::DoStepBatchFunction = "MMIAdapter.DoStepBatch";
+const std::string ThriftAdapterImplementation::DoStepAvatarsFunction = "MMIAdapter.DoStepAvatars";
+const std::string ThriftAdapterImplementation::RefreshServicesFunction = "MMIAdapter.RefreshServices";
+const std::string ThriftAdapterImplementation::QueryCollisionsFunction = "MMIAdapter.QueryCollisions";
+const std::string ThriftAdapterImplementation::QueryRegionCollisionsFunction = "MMIAdapter.QueryRegionCollisions";
+const std::string ThriftAdapterImplementation::SceneChangesFunction = "MMIAdapter.GetSceneChanges";
+
+shared_ptr<MotionModelUnitBaseIf> ThriftAdapterImplementation::GetMMU(RpcMetrics::Scope & metrics, const std::string & sessionID, const std::string & mmuID)
+{
+	shared_ptr<MotionModelUnitBaseIf> mmu = this->sessions.GetMMUbyId(sessionID, mmuID);
+	metrics.SetMMU(mmuID);
+	return mmu;
+}
 
 void ThriftAdapterImplementation::Initialize(::MMIStandard::MBoolResponse & _return, const::MMIStandard::MAvatarDescription & avatarDescription, const std::map<std::string, std::string>& properties, const std::string & mmuID, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG,"Initialize");
-	SessionData::lastAccess = std::time(0);
+	MMI_LOG(L_DEBUG, "Initialize");
+	RpcMetrics::Scope metrics(R_INITIALIZE);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 	_return.__set_Successful(true);
 
 	try
 	{
-		SessionHandling::GetMMUbyId(sessionID,mmuID).Initialize(_return, avatarDescription, properties);
+		this->GetMMU(metrics, sessionID, mmuID)->Initialize(_return, avatarDescription, properties);
 	}
 	catch (...)
 	{		
+		metrics.Failed();
 		string message = boost::current_exception_diagnostic_information();
 		Logger::printLog(L_ERROR, message);
 		MBoolResponseExtensions::Update(_return, message,false);
@@ -37,15 +61,17 @@ void ThriftAdapterImplementation::Initialize(::MMIStandard::MBoolResponse & _ret
 
 void ThriftAdapterImplementation::AssignInstruction(::MMIStandard::MBoolResponse & _return, const MInstruction & instruction, const MSimulationState & simulationState, const std::string & mmuID, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "AssignInstruction");	
-	SessionData::lastAccess = std::time(0);
+	MMI_LOG(L_DEBUG, "AssignInstruction");	
+	RpcMetrics::Scope metrics(R_ASSIGN_INSTRUCTION);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 
 	try
 	{
-		SessionHandling::GetMMUbyId(sessionID, mmuID).AssignInstruction(_return, instruction, simulationState);
+		this->GetMMU(metrics, sessionID, mmuID)->AssignInstruction(_return, instruction, simulationState);
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		string message = boost::current_exception_diagnostic_information();
 		Logger::printLog(L_ERROR, message);
 		MBoolResponseExtensions::Update(_return, message,false);
@@ -54,45 +80,156 @@ void ThriftAdapterImplementation::AssignInstruction(::MMIStandard::MBoolResponse
 
 void ThriftAdapterImplementation::DoStep(MSimulationResult & _return, const double time, const MSimulationState & simulationState, const std::string & mmuID, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "DoStep");	
-	SessionData::lastAccess = std::time(0);
+	MMI_LOG(L_DEBUG, "DoStep");	
+	RpcMetrics::Scope metrics(R_DO_STEP);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 
 	try
 	{
-		SessionHandling::GetMMUbyId(sessionID, mmuID).DoStep(_return, time, simulationState);
+		this->GetMMU(metrics, sessionID, mmuID)->DoStep(_return, time, simulationState);
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		Logger::printLog(L_ERROR, boost::current_exception_diagnostic_information());
 	}
 }
 
+void ThriftAdapterImplementation::DoStepBatch(std::vector<MSimulationResult>& _return, const double time, const MSimulationState & simulationState, const std::vector<std::string>& mmuIDs, const std::string & sessionID)
+{
+	MMI_LOG(L_DEBUG, "DoStepBatch");
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
+
+	try
+	{
+		// the session is resolved once for all MMUs
+		StepMMUs(_return, time, simulationState, mmuIDs, *this->sessions.GetAvatarContent(sessionID));
+	}
+	catch (...)
+	{
+		string message = boost::current_exception_diagnostic_information();
+		Logger::printLog(L_ERROR, message);
+		SetError(_return, mmuIDs.size(), message);
+	}
+}
+
+void ThriftAdapterImplementation::DoStepBatch(std::vector<std::vector<MSimulationResult>>& _return, const double time, const std::vector<AvatarStep>& avatarSteps)
+{
+	MMI_LOG(L_DEBUG, "DoStepBatch");
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
+
+	_return.clear();
+	_return.resize(avatarSteps.size());
+
+	// the sessions are resolved up front, the cache of the connection must not be used by the executor threads
+	vector<shared_ptr<const AvatarContent>> avatarContents(avatarSteps.size());
+	for (size_t i = 0; i < avatarSteps.size(); i++)
+	{
+		try
+		{
+			avatarContents[i] = this->sessions.GetAvatarContent(avatarSteps[i].sessionID);
+		}
+		catch (...)
+		{
+			string message = boost::current_exception_diagnostic_information();
+			Logger::printLog(L_ERROR, message);
+			SetError(_return[i], avatarSteps[i].mmuIDs.size(), message);
+		}
+	}
+
+	// steps of the same avatar share the MMU instances, they are grouped into one task and executed in their order
+	vector<vector<size_t>> groups;
+	unordered_map<const AvatarContent*, size_t> groupByAvatar;
+	for (size_t i = 0; i < avatarSteps.size(); i++)
+	{
+		if (avatarContents[i] == nullptr)
+			continue;
+
+		auto group = groupByAvatar.emplace(avatarContents[i].get(), groups.size());
+		if (group.second)
+			groups.emplace_back();
+		groups[group.first->second].emplace_back(i);
+	}
+
+	auto step = [&](size_t group)
+	{
+		for (size_t i : groups[group])
+			StepMMUs(_return[i], time, avatarSteps[i].simulationState, avatarSteps[i].mmuIDs, *avatarContents[i]);
+	};
+
+	if (SessionData::stepExecutor)
+		SessionData::stepExecutor->Run(groups.size(), step);
+	else
+	{
+		for (size_t group = 0; group < groups.size(); group++)
+			step(group);
+	}
+}
+
+void ThriftAdapterImplementation::StepMMUs(std::vector<MSimulationResult>& _return, const double time, const MSimulationState & simulationState, const std::vector<std::string>& mmuIDs, const AvatarContent & avatarContent)
+{
+	_return.clear();
+	_return.resize(mmuIDs.size());
+
+	for (size_t i = 0; i < mmuIDs.size(); i++)
+	{
+		// the steps of a batch are recorded like single DoStep calls, so the MMUs can be compared
+		RpcMetrics::Scope metrics(R_DO_STEP);
+		try
+		{
+			shared_ptr<MotionModelUnitBaseIf> mmu = avatarContent.GetMMUbyId(mmuIDs[i]);
+			metrics.SetMMU(mmuIDs[i]);
+			mmu->DoStep(_return[i], time, simulationState);
+		}
+		catch (...)
+		{
+			metrics.Failed();
+			string message = boost::current_exception_diagnostic_information();
+			Logger::printLog(L_ERROR, message);
+			_return[i] = MSimulationResult();
+			_return[i].__set_LogData(vector<string>{message});
+		}
+	}
+}
+
+void ThriftAdapterImplementation::SetError(std::vector<MSimulationResult>& _return, size_t count, const std::string & message)
+{
+	_return.clear();
+	_return.resize(count);
+	for (MSimulationResult &result : _return)
+		result.__set_LogData(vector<string>{message});
+}
+
 void ThriftAdapterImplementation::GetBoundaryConstraints(std::vector<MConstraint>& _return, const MInstruction & instruction, const std::string & mmuID, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "GetBoundaryConstraints");
-	SessionData::lastAccess = std::time(0);
+	MMI_LOG(L_DEBUG, "GetBoundaryConstraints");
+	RpcMetrics::Scope metrics(R_GET_BOUNDARY_CONSTRAINTS);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 
 	try
 	{
-		SessionHandling::GetMMUbyId(sessionID, mmuID).GetBoundaryConstraints(_return, instruction);
+		this->GetMMU(metrics, sessionID, mmuID)->GetBoundaryConstraints(_return, instruction);
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		Logger::printLog(L_ERROR, boost::current_exception_diagnostic_information());
 	}
 }
 
 void ThriftAdapterImplementation::CheckPrerequisites(::MMIStandard::MBoolResponse & _return, const MInstruction & instruction, const std::string & mmuID, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "CheckPrerequisites");
-	SessionData::lastAccess = std::time(0);
+	MMI_LOG(L_DEBUG, "CheckPrerequisites");
+	RpcMetrics::Scope metrics(R_CHECK_PREREQUISITES);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 
 	try
 	{
-		SessionHandling::GetMMUbyId(sessionID, mmuID).CheckPrerequisites(_return, instruction);
+		this->GetMMU(metrics, sessionID, mmuID)->CheckPrerequisites(_return, instruction);
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		string message = boost::current_exception_diagnostic_information();
 		Logger::printLog(L_ERROR, message);
 		MBoolResponseExtensions::Update(_return, message,false);
@@ -101,15 +238,17 @@ void ThriftAdapterImplementation::CheckPrerequisites(::MMIStandard::MBoolRespons
 
 void ThriftAdapterImplementation::Abort(::MMIStandard::MBoolResponse & _return, const std::string & instructionID, const std::string & mmuID, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "Abort");
-	SessionData::lastAccess = std::time(0);
+	MMI_LOG(L_DEBUG, "Abort");
+	RpcMetrics::Scope metrics(R_ABORT);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 
 	try
 	{
-		SessionHandling::GetMMUbyId(sessionID, mmuID).Abort(_return, instructionID);
+		this->GetMMU(metrics, sessionID, mmuID)->Abort(_return, instructionID);
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		string message = boost::current_exception_diagnostic_information();
 		Logger::printLog(L_ERROR, message);
 		MBoolResponseExtensions::Update(_return, message,false);
@@ -118,16 +257,18 @@ void ThriftAdapterImplementation::Abort(::MMIStandard::MBoolResponse & _return,
 
 void ThriftAdapterImplementation::Dispose(::MMIStandard::MBoolResponse & _return, const std::string & mmuID, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "Dispose");
-	SessionData::lastAccess = std::time(0);
+	MMI_LOG(L_DEBUG, "Dispose");
+	RpcMetrics::Scope metrics(R_DISPOSE);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 
 	try
 	{
 		map<string, string> parameter;
-		SessionHandling::GetMMUbyId(sessionID, mmuID).Dispose(_return, parameter);
+		this->GetMMU(metrics, sessionID, mmuID)->Dispose(_return, parameter);
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		string message = boost::current_exception_diagnostic_information();
 		Logger::printLog(L_ERROR, message);
 		MBoolResponseExtensions::Update(_return, message, false);
@@ -136,47 +277,235 @@ void ThriftAdapterImplementation::Dispose(::MMIStandard::MBoolResponse & _return
 
 void ThriftAdapterImplementation::ExecuteFunction(std::map<std::string, std::string>& _return, const std::string & name, const std::map<std::string, std::string>& parameters, const std::string & mmuID, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "ExecuteFunction");
-	SessionData::lastAccess = std::time(0);
+	MMI_LOG(L_DEBUG, "ExecuteFunction");
+	RpcMetrics::Scope metrics(R_EXECUTE_FUNCTION);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 
 	try
 	{
-		SessionHandling::GetMMUbyId(sessionID, mmuID).ExecuteFunction(_return, name,parameters);
+		if (name == DoStepBatchFunction)
+			this->ExecuteDoStepBatch(_return, parameters, sessionID);
+		else if (name == DoStepAvatarsFunction)
+			this->ExecuteDoStepAvatars(_return, parameters);
+		else if (name == RefreshServicesFunction)
+			ServiceDirectory::Refresh(SessionData::GetRegisterAddress(), sessionID);
+		else if (name == QueryCollisionsFunction)
+			this->ExecuteQueryCollisions(_return, parameters, sessionID);
+		else if (name == QueryRegionCollisionsFunction)
+			this->ExecuteQueryRegionCollisions(_return, parameters, sessionID);
+		else if (name == SceneChangesFunction)
+			this->ExecuteSceneChanges(_return, parameters, sessionID);
+		else
+			this->GetMMU(metrics, sessionID, mmuID)->ExecuteFunction(_return, name,parameters);
 	}
 	catch (...)
 	{
-		Logger::printLog(L_ERROR, boost::current_exception_diagnostic_information()); Logger::printLog(L_ERROR, boost::current_exception_diagnostic_information());
+		metrics.Failed();
+		string message = boost::current_exception_diagnostic_information();
+		Logger::printLog(L_ERROR, message);
+		// partial results are dropped, the caller only receives the error
+		_return.clear();
+		_return["Error"] = message;
+	}
+}
+
+namespace
+{
+	//	Adds the MMU ids to the ids, throws a runtime_error if an id is contained twice, as the results are returned by MMU id
+	void AddUniqueIDs(unordered_set<string> &ids, const vector<string> &mmuIDs, const string &function)
+	{
+		for (const string &mmuID : mmuIDs)
+		{
+			if (!ids.insert(mmuID).second)
+				throw runtime_error(function + " contains the MMU id " + mmuID + " twice");
+		}
+	}
+}
+
+void ThriftAdapterImplementation::ExecuteDoStepBatch(std::map<std::string, std::string>& _return, const std::map<std::string, std::string>& parameters, const std::string & sessionID)
+{
+	auto time = parameters.find("Time");
+	auto simulationState = parameters.find("SimulationState");
+	auto mmuIDs = parameters.find("MMUIDs");
+	if (time == parameters.end() || simulationState == parameters.end() || mmuIDs == parameters.end())
+		throw runtime_error(DoStepBatchFunction + " requires the parameters Time, SimulationState and MMUIDs");
+
+	MSimulationState state;
+	ThriftSerialization::FromJson(state, simulationState->second);
+	vector<string> ids = json::parse(mmuIDs->second).get<vector<string>>();
+	unordered_set<string> uniqueIDs;
+	AddUniqueIDs(uniqueIDs, ids, DoStepBatchFunction);
+
+	vector<MSimulationResult> results;
+	this->DoStepBatch(results, stod(time->second), state, ids, sessionID);
+
+	for (size_t i = 0; i < ids.size(); i++)
+		_return[ids[i]] = ThriftSerialization::ToJson(results[i]);
+}
+
+void ThriftAdapterImplementation::ExecuteDoStepAvatars(std::map<std::string, std::string>& _return, const std::map<std::string, std::string>& parameters)
+{
+	auto time = parameters.find("Time");
+	auto avatars = parameters.find("Avatars");
+	if (time == parameters.end() || avatars == parameters.end())
+		throw runtime_error(DoStepAvatarsFunction + " requires the parameters Time and Avatars");
+
+	vector<AvatarStep> avatarSteps;
+	unordered_map<string, unordered_set<string>> idsBySession;
+	for (const json &avatar : json::parse(avatars->second))
+	{
+		AvatarStep avatarStep;
+		avatarStep.sessionID = avatar.at("SessionID").get<string>();
+		ThriftSerialization::FromJson(avatarStep.simulationState, avatar.at("SimulationState").get<string>());
+		avatarStep.mmuIDs = avatar.at("MMUIDs").get<vector<string>>();
+		AddUniqueIDs(idsBySession[avatarStep.sessionID], avatarStep.mmuIDs, DoStepAvatarsFunction);
+		avatarSteps.emplace_back(move(avatarStep));
+	}
+
+	vector<vector<MSimulationResult>> results;
+	this->DoStepBatch(results, stod(time->second), avatarSteps);
+
+	map<string, json> resultsBySession;
+	for (size_t i = 0; i < avatarSteps.size(); i++)
+	{
+		json &sessionResults = resultsBySession[avatarSteps[i].sessionID];
+		for (size_t j = 0; j < avatarSteps[i].mmuIDs.size(); j++)
+			sessionResults[avatarSteps[i].mmuIDs[j]] = ThriftSerialization::ToJson(results[i][j]);
+	}
+	for (const auto &sessionResults : resultsBySession)
+		_return[sessionResults.first] = sessionResults.second.dump();
+}
+
+namespace
+{
+	bool GetPenetrationParameter(const std::map<std::string, std::string>& parameters)
+	{
+		auto penetration = parameters.find("Penetration");
+		return penetration != parameters.end() && penetration->second == "true";
+	}
+
+	Vector3d GetVectorParameter(const string &value)
+	{
+		vector<double> components = json::parse(value).get<vector<double>>();
+		if (components.size() != 3)
+			throw runtime_error("Expected a JSON array [x, y, z] instead of " + value);
+		return Vector3d(components[0], components[1], components[2]);
+	}
+
+	string ToJson(const vector<CollisionWorld::Contact> &contacts)
+	{
+		json result = json::array();
+		for (const CollisionWorld::Contact &contact : contacts)
+		{
+			result.push_back({
+				{ "A", contact.sceneObjectA },
+				{ "B", contact.sceneObjectB },
+				{ "Penetration", { contact.penetration.x, contact.penetration.y, contact.penetration.z } }
+			});
+		}
+		return result.dump();
+	}
+}
+
+void ThriftAdapterImplementation::ExecuteQueryCollisions(std::map<std::string, std::string>& _return, const std::map<std::string, std::string>& parameters, const std::string & sessionID)
+{
+	bool computePenetration = GetPenetrationParameter(parameters);
+	shared_ptr<const CollisionWorld> world = this->sessions.GetSessionContent(sessionID)->GetCollisionWorld();
+	vector<CollisionWorld::Contact> contacts;
+
+	auto sceneObjectID = parameters.find("SceneObjectID");
+	auto collider = parameters.find("Collider");
+	auto transform = parameters.find("Transform");
+	if (sceneObjectID != parameters.end())
+	{
+		if (!world->QuerySceneObject(contacts, sceneObjectID->second, computePenetration))
+			throw runtime_error(QueryCollisionsFunction + " can not find a collider of the scene object " + sceneObjectID->second);
 	}
+	else if (collider != parameters.end() && transform != parameters.end())
+	{
+		MCollider queryCollider;
+		MTransform queryTransform;
+		ThriftSerialization::FromJson(queryCollider, collider->second);
+		ThriftSerialization::FromJson(queryTransform, transform->second);
+		world->QueryCollider(contacts, CollisionShape(queryCollider), Pose3d(queryTransform), queryCollider.ID, computePenetration);
+	}
+	else
+		throw runtime_error(QueryCollisionsFunction + " requires the parameter SceneObjectID or the parameters Collider and Transform");
+
+	_return["Contacts"] = ToJson(contacts);
+}
+
+void ThriftAdapterImplementation::ExecuteQueryRegionCollisions(std::map<std::string, std::string>& _return, const std::map<std::string, std::string>& parameters, const std::string & sessionID)
+{
+	auto min = parameters.find("Min");
+	auto max = parameters.find("Max");
+	if (min == parameters.end() || max == parameters.end())
+		throw runtime_error(QueryRegionCollisionsFunction + " requires the parameters Min and Max");
+
+	// the corners may be given in any order
+	Vector3d cornerA = GetVectorParameter(min->second);
+	Vector3d cornerB = GetVectorParameter(max->second);
+	Bounds3d region;
+	region.Add(Bounds3d(cornerA, cornerA));
+	region.Add(Bounds3d(cornerB, cornerB));
+
+	vector<CollisionWorld::Contact> contacts;
+	this->sessions.GetSessionContent(sessionID)->GetCollisionWorld()->QueryRegion(contacts, region, GetPenetrationParameter(parameters));
+	_return["Contacts"] = ToJson(contacts);
+}
+
+void ThriftAdapterImplementation::ExecuteSceneChanges(std::map<std::string, std::string>& _return, const std::map<std::string, std::string>& parameters, const std::string & sessionID)
+{
+	auto sinceFrame = parameters.find("SinceFrame");
+	if (sinceFrame == parameters.end())
+		throw runtime_error(SceneChangesFunction + " requires the parameter SinceFrame");
+
+	int sinceFrameID = stoi(sinceFrame->second);
+	MSceneUpdate sceneUpdate;
+	int frameID;
+	bool merged = this->sessions.GetSessionContent(sessionID)->sceneBuffer->GetSceneChangesSince(sceneUpdate, sinceFrameID, frameID);
+	if (!merged)
+		MMI_LOG(L_DEBUG, SceneChangesFunction + ": frame " + std::to_string(sinceFrameID) + " is not available anymore, sending the full scene");
+
+	_return["FrameID"] = std::to_string(frameID);
+	_return["SceneUpdate"] = ThriftSerialization::ToJson(sceneUpdate);
+	_return["FullScene"] = merged ? "false" : "true";
 }
 
 //TODO check version
 void ThriftAdapterImplementation::GetStatus(std::map<std::string, std::string>& _return)
 {
+	RpcMetrics::Scope metrics(R_GET_STATUS);
 	_return["Version"] = "0.1";
 	_return["Running since"] = strtok(ctime(&SessionData::startTime), "\n");
-	_return["Total Sessions"] = std::to_string(SessionData::SessionContents.size()); ;
+	_return["Total Sessions"] = std::to_string(SessionData::SessionContents.Size()); ;
 	
-	if (SessionData::lastAccess == 0)
+	time_t lastAccess = SessionData::lastAccess.load(memory_order_relaxed);
+	if (lastAccess == 0)
 	{
 		_return["Last Access"] = "None";
 	}
 	else
 	{
-		_return["Last Access"] = strtok(ctime(&SessionData::lastAccess), "\n");
+		_return["Last Access"] = strtok(ctime(&lastAccess), "\n");
 	}
 	_return["Loadable MMMUs"] = std::to_string(SessionData::mmuDescriptions.size());
+	SessionCleaner::Report(_return);
+	RpcMetrics::Report(_return);
 }
 
 void ThriftAdapterImplementation::GetAdapterDescription(MAdapterDescription & _return)
 {
-	Logger::printLog(L_DEBUG, "GetAdapterDescription");
+	MMI_LOG(L_DEBUG, "GetAdapterDescription");
+	RpcMetrics::Scope metrics(R_GET_ADAPTER_DESCRIPTION);
 	_return = SessionData::adapterDescription;
 }
 
 void ThriftAdapterImplementation::CreateSession(::MMIStandard::MBoolResponse & _return, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "CreateSession");
-	SessionData::lastAccess = std::time(0);
+	MMI_LOG(L_DEBUG, "CreateSession");
+	RpcMetrics::Scope metrics(R_CREATE_SESSION);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 
 	try
 	{
@@ -186,6 +515,7 @@ void ThriftAdapterImplementation::CreateSession(::MMIStandard::MBoolResponse & _
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		string message = boost::current_exception_diagnostic_information();
 		Logger::printLog(L_ERROR, message);
 		MBoolResponseExtensions::Update(_return, message, false);
@@ -195,6 +525,7 @@ void ThriftAdapterImplementation::CreateSession(::MMIStandard::MBoolResponse & _
 void ThriftAdapterImplementation::CloseSession(::MMIStandard::MBoolResponse & _return, const std::string & sessionID)
 {
 	Logger::printLog(L_INFO, "CloseSession " + sessionID );
+	RpcMetrics::Scope metrics(R_CLOSE_SESSION);
 
 	try {
 		SessionHandling::RemoveSessionContent(sessionID);
@@ -202,6 +533,7 @@ void ThriftAdapterImplementation::CloseSession(::MMIStandard::MBoolResponse & _r
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		string message = boost::current_exception_diagnostic_information();
 		Logger::printLog(L_ERROR, message);
 		MBoolResponseExtensions::Update(_return, message, false);
@@ -210,15 +542,23 @@ void ThriftAdapterImplementation::CloseSession(::MMIStandard::MBoolResponse & _r
 
 void ThriftAdapterImplementation::PushScene(::MMIStandard::MBoolResponse & _return, const::MMIStandard::MSceneUpdate & sceneUpdates, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "PushScene");
-	SessionData::lastAccess = std::time(0);
+	// the caller keeps its update, the scene works on a copy
+	this->PushScene(_return, MSceneUpdate(sceneUpdates), sessionID);
+}
+
+void ThriftAdapterImplementation::PushScene(::MMIStandard::MBoolResponse & _return, ::MMIStandard::MSceneUpdate && sceneUpdates, const std::string & sessionID)
+{
+	MMI_LOG(L_DEBUG, "PushScene");
+	RpcMetrics::Scope metrics(R_PUSH_SCENE);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 
 	try
 	{
-		SessionHandling::GetSessionContentBySessionID(SessionTools::GetSplittedIds(sessionID)[0]).sceneBuffer->Apply(_return,sceneUpdates);	
+		this->sessions.GetSessionContent(sessionID)->sceneBuffer->Apply(_return, move(sceneUpdates));
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		string message = boost::current_exception_diagnostic_information();
 		Logger::printLog(L_ERROR, message);
 		MBoolResponseExtensions::Update(_return, message, false);
@@ -228,6 +568,7 @@ void ThriftAdapterImplementation::PushScene(::MMIStandard::MBoolResponse & _retu
 void ThriftAdapterImplementation::GetLoadableMMUs(std::vector<MMUDescription>& _return)
 {
 	//Logger::printLog(L_DEBUG, "GetLoadableMMUs");
+	RpcMetrics::Scope metrics(R_GET_LOADABLE_MMUS);
 	//SessionData::lastAccess = std::time(0);
 
 	for (const MMUDescription &description : SessionData::mmuDescriptions)
@@ -239,58 +580,63 @@ void ThriftAdapterImplementation::GetLoadableMMUs(std::vector<MMUDescription>& _
 
 void ThriftAdapterImplementation::GetMMus(std::vector<MMUDescription>& _return, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "GetMMUs");
-	SessionData::lastAccess = std::time(0);
+	MMI_LOG(L_DEBUG, "GetMMUs");
+	RpcMetrics::Scope metrics(R_GET_MMUS);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 
 	try
 	{
-		const AvatarContent *avatarContent = &SessionHandling::GetAvatarContentBySessionID(sessionID);
+		shared_ptr<const AvatarContent> avatarContent = this->sessions.GetAvatarContent(sessionID);
 
-		for(auto const& mmu : avatarContent->MMUs)
-		{
-			_return.emplace_back(SessionData::GetMMUDescription(mmu.first));
-		}	
+		for (const string &mmuID : avatarContent->GetMMUIds())
+			_return.emplace_back(SessionData::GetMMUDescription(mmuID));
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		Logger::printLog(L_ERROR, boost::current_exception_diagnostic_information());
 	}
 }
 
 void ThriftAdapterImplementation::GetDescription(MMUDescription & _return, const std::string & mmuID, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "GetDescription");
-	SessionData::lastAccess = std::time(0);
+	MMI_LOG(L_DEBUG, "GetDescription");
+	RpcMetrics::Scope metrics(R_GET_DESCRIPTION);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 	_return =SessionData::GetMMUDescription(mmuID);
+	metrics.SetMMU(mmuID);
 }
 
 void ThriftAdapterImplementation::GetScene(std::vector<::MMIStandard::MSceneObject>& _return, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "GetScene");
-	SessionData::lastAccess = std::time(0);
+	MMI_LOG(L_DEBUG, "GetScene");
+	RpcMetrics::Scope metrics(R_GET_SCENE);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 
 	try
 	{
-		SessionHandling::GetSessionContentBySessionID(SessionTools::GetSplittedIds(sessionID)[0]).sceneBuffer->GetSceneObjects(_return);
+		this->sessions.GetSessionContent(sessionID)->sceneBuffer->GetSceneObjects(_return);
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		Logger::printLog(L_ERROR, boost::current_exception_diagnostic_information());
 	}
 }
 
 void ThriftAdapterImplementation::GetSceneChanges(::MMIStandard::MSceneUpdate & _return, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "GetSceneChanges");
+	MMI_LOG(L_DEBUG, "GetSceneChanges");
+	RpcMetrics::Scope metrics(R_GET_SCENE_CHANGES);
 
 	try
 	{		
-		SessionData::lastAccess = std::time(0);
-		SessionHandling::GetSessionContentBySessionID(SessionTools::GetSplittedIds(sessionID)[0]).sceneBuffer->GetSceneChanges(_return);
-				
+		SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
+		this->sessions.GetSessionContent(sessionID)->sceneBuffer->GetSceneChanges(_return);
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		Logger::printLog(L_ERROR, boost::current_exception_diagnostic_information());
 	}	
 }
@@ -298,16 +644,11 @@ void ThriftAdapterImplementation::GetSceneChanges(::MMIStandard::MSceneUpdate &
 //TODO failure handling
 void ThriftAdapterImplementation::LoadMMUs(std::map<std::string, std::string>& _return, const std::vector<std::string>& mmus, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "LoadMMUs");
+	MMI_LOG(L_DEBUG, "LoadMMUs");
+	RpcMetrics::Scope metrics(R_LOAD_MMUS);
 	try
 	{
-		std::vector<string> splittedIds = SessionTools::GetSplittedIds(sessionID);
-		std::string sceneId = splittedIds[0];
-		std::string avatarId = splittedIds[1];
-		const SessionContent *sessionContent = &SessionHandling::GetSessionContentBySceneID(sceneId);
-		SessionData::lastAccess = std::time(0);
-		// save the session content of the id 
-		//MBoolResponse SessionResults = SessionData::GetSessionContent(sessionID, out sessionContent);
+		SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 
 		for (const std::string &mmuId : mmus)
 		{
@@ -315,32 +656,23 @@ void ThriftAdapterImplementation::LoadMMUs(std::map<std::string, std::string>& _
 			auto it = SessionData::mmuPaths.find(mmuId);
 			if (it != SessionData::mmuPaths.end())
 			{
-				CPPMMUInstantiator instantiator = AdapterController::GetMMUInstantiator();
-				mmu = move(instantiator.InstantiateMMU(it->second));
+				// the library is only loaded by the first session, further sessions reuse the cached instantiate function
+				mmu = AdapterController::GetMMUInstantiator().InstantiateMMU(it->second);
 			}
 			if (mmu != nullptr)
 			{
-				mmu->serviceAccess = &sessionContent->GetServiceAccess();
-				mmu->sceneAccess = &sessionContent->GetScene();
-
-				Logger::printLog(L_INFO, "Loaded MMU : " + mmu->name + " for session: "+ sessionID );
+				MBoolResponse response;
+				this->AddMMU(response, mmuId, move(mmu), sessionID);
 
 				// insert values into map 
-				_return.insert(std::pair<std::string, std::string>(mmuId, sessionID));  // added, sadam
-				
-				auto it = sessionContent->avatarContent.find(avatarId);
-				if (it == sessionContent->avatarContent.end())
-				{	
-					unique_ptr avatarcontent = make_unique<AvatarContent>(avatarId);
-					sessionContent->avatarContent[avatarId] = move(avatarcontent);
-					avatarcontent->MMUs[mmuId] = move(mmu);
-				}
-				sessionContent->avatarContent[avatarId]->MMUs[mmuId] = move(mmu);					
+				if (response.Successful)
+					_return.insert(std::pair<std::string, std::string>(mmuId, sessionID));  // added, sadam
 			}
 		}
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		string message = boost::current_exception_diagnostic_information();
 		Logger::printLog(L_ERROR, message);
 		//MBoolResponseExtensions::Update(_return, message, false);
@@ -348,32 +680,62 @@ void ThriftAdapterImplementation::LoadMMUs(std::map<std::string, std::string>& _
 
 }
 
+void ThriftAdapterImplementation::AddMMU(::MMIStandard::MBoolResponse & _return, const std::string & mmuID, std::unique_ptr<MotionModelUnitBaseIf> mmu, const std::string & sessionID)
+{
+	MMI_LOG(L_DEBUG, "AddMMU");
+	try
+	{
+		std::vector<string> splittedIds = SessionTools::GetSplittedIds(sessionID);
+		std::string avatarId = splittedIds[1];
+		shared_ptr<SessionContent> sessionContent = SessionHandling::GetModifiableSessionContentBySceneID(splittedIds[0]);
+
+		mmu->serviceAccess = &sessionContent->GetServiceAccess();
+		mmu->sceneAccess = &sessionContent->GetScene();
+
+		Logger::printLog(L_INFO, "Loaded MMU : " + mmu->name + " for session: " + sessionID);
+
+		bool created;
+		sessionContent->GetOrCreateAvatarContent(avatarId, created).AddMMU(mmuID, move(mmu));
+		_return.__set_Successful(true);
+	}
+	catch (...)
+	{
+		string message = boost::current_exception_diagnostic_information();
+		Logger::printLog(L_ERROR, message);
+		MBoolResponseExtensions::Update(_return, message, false);
+	}
+}
+
 void ThriftAdapterImplementation::CreateCheckpoint(std::string & _return, const std::string & mmuID, const std::string & sessionID)
 {
-	Logger::printLog(L_DEBUG, "CreateCheckPoint");
-	SessionData::lastAccess = std::time(0);
+	MMI_LOG(L_DEBUG, "CreateCheckPoint");
+	RpcMetrics::Scope metrics(R_CREATE_CHECKPOINT);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 
 	try
 	{
-		SessionHandling::GetMMUbyId(sessionID, mmuID).CreateCheckpoint(_return);
+		this->GetMMU(metrics, sessionID, mmuID)->CreateCheckpoint(_return);
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		Logger::printLog(L_ERROR, boost::current_exception_diagnostic_information());
 	}
 }
 
 void ThriftAdapterImplementation::RestoreCheckpoint(::MMIStandard::MBoolResponse & _return, const std::string & mmuID, const std::string & sessionID, const std::string & checkpointData)
 {
-	Logger::printLog(L_DEBUG, "RestoreCheckpoint");
-	SessionData::lastAccess = std::time(0);
+	MMI_LOG(L_DEBUG, "RestoreCheckpoint");
+	RpcMetrics::Scope metrics(R_RESTORE_CHECKPOINT);
+	SessionData::lastAccess.store(std::time(0), memory_order_relaxed);
 
 	try
 	{
-		SessionHandling::GetMMUbyId(sessionID, mmuID).RestoreCheckpoint(_return, checkpointData);
+		this->GetMMU(metrics, sessionID, mmuID)->RestoreCheckpoint(_return, checkpointData);
 	}
 	catch (...)
 	{
+		metrics.Failed();
 		string message = boost::current_exception_diagnostic_information();
 		Logger::printLog(L_ERROR, message);
 		MBoolResponseExtensions::Update(_return, message, false);
@@ -5,14 +5,93 @@
 #pragma once
 
 #include "gen-cpp/MMIAdapter.h"
+#include "SessionCache.h"
+#include "RpcMetrics.h"
+#include <unordered_map>
+#include <memory>
+
+class MotionModelUnitBaseIf;
 
 using namespace MMIStandard;
 namespace MMIStandard {
+	//	The MMUs of one avatar which are stepped with the same simulation state by DoStepBatch
+	struct AvatarStep
+	{
+		//	The session of the avatar
+		std::string sessionID;
+		MSimulationState simulationState;
+
+		//	The MMUs which are stepped in this order
+		std::vector<std::string> mmuIDs;
+	};
+
 	class ThriftAdapterImplementation :public MMIAdapterIf
 	{
 		/**
 			Implementation of the thrift adapter functionality
+			An instance is created for each connection (see ThriftServer), the calls of one instance are never concurrent
 		*/
+	private:
+		//	The sessions resolved by this connection
+		SessionCache sessions;
+
+		//	Returns the MMU of the session and records the call for the MMU once it has been found
+		shared_ptr<MotionModelUnitBaseIf> GetMMU(RpcMetrics::Scope &metrics, const std::string &sessionID, const std::string &mmuID);
+
+		//	Executes the DoStepBatchFunction call of ExecuteFunction, the parameters are decoded and the results encoded as described at DoStepBatchFunction
+		void ExecuteDoStepBatch(std::map<std::string, std::string> & _return, const std::map<std::string, std::string> & parameters, const std::string& sessionID);
+
+		//	Executes the DoStepAvatarsFunction call of ExecuteFunction, the parameters are decoded and the results encoded as described at DoStepAvatarsFunction
+		void ExecuteDoStepAvatars(std::map<std::string, std::string> & _return, const std::map<std::string, std::string> & parameters);
+
+		//	Executes the QueryCollisionsFunction call of ExecuteFunction, the parameters are decoded and the results encoded as described at QueryCollisionsFunction
+		void ExecuteQueryCollisions(std::map<std::string, std::string> & _return, const std::map<std::string, std::string> & parameters, const std::string& sessionID);
+
+		//	Executes the QueryRegionCollisionsFunction call of ExecuteFunction, the parameters are decoded and the results encoded as described at QueryRegionCollisionsFunction
+		void ExecuteQueryRegionCollisions(std::map<std::string, std::string> & _return, const std::map<std::string, std::string> & parameters, const std::string& sessionID);
+
+		//	Executes the SceneChangesFunction call of ExecuteFunction, the parameters are decoded and the results encoded as described at SceneChangesFunction
+		void ExecuteSceneChanges(std::map<std::string, std::string> & _return, const std::map<std::string, std::string> & parameters, const std::string& sessionID);
+
+		//	Steps the MMUs of one avatar sequentially, the errors are written to the LogData of the results
+		static void StepMMUs(std::vector<MSimulationResult>& _return, const double time, const MSimulationState& simulationState, const std::vector<std::string>& mmuIDs, const AvatarContent& avatarContent);
+
+		//	Returns count results which only contain the error message in their LogData
+		static void SetError(std::vector<MSimulationResult>& _return, size_t count, const std::string& message);
+
+	public:
+		//	The name of the ExecuteFunction call which executes DoStepBatch, the mmuID of the call is ignored
+		//	Parameters: "Time", "SimulationState" (thrift JSON) and "MMUIDs" (JSON array of the MMU ids)
+		//	Returns the thrift JSON of each MSimulationResult structured by the MMU id, an MMU id must not be contained twice
+		static const std::string DoStepBatchFunction;
+
+		//	The name of the ExecuteFunction call which executes DoStepBatch for several avatars, the mmuID and sessionID of the call are ignored
+		//	Parameters: "Time" and "Avatars" (JSON array of objects with "SessionID", "SimulationState" (thrift JSON) and "MMUIDs")
+		//	Returns a JSON object for each session id, which contains the thrift JSON of each MSimulationResult structured by the MMU id
+		//	An MMU id must not be contained twice for the same session
+		static const std::string DoStepAvatarsFunction;
+
+		//	The name of the ExecuteFunction call which fetches the service descriptions from the register again, e.g. after a service has been registered
+		//	The descriptions are shared by all sessions (see ServiceDirectory), the mmuID of the call is ignored
+		static const std::string RefreshServicesFunction;
+
+		//	The name of the ExecuteFunction call which tests one collider against all colliders of the scene of the session, the mmuID of the call is ignored
+		//	Parameters: either "SceneObjectID" (the stored collider of the scene object) or "Collider" and "Transform" (thrift JSON), optional "Penetration" ("true" computes the penetrations)
+		//	A scene object with the id of the given collider is skipped, so a scene object can be tested at another transform
+		//	Returns "Contacts": JSON array of objects with "A", "B" (the ids of the colliding scene objects) and "Penetration" ([x, y, z], translation of A which separates the colliders)
+		static const std::string QueryCollisionsFunction;
+
+		//	The name of the ExecuteFunction call which tests all pairs of colliders of the scene of the session within a region, the mmuID of the call is ignored
+		//	Parameters: "Min" and "Max" (JSON arrays [x, y, z] of the corners of the region), optional "Penetration"
+		//	Returns "Contacts" as described at QueryCollisionsFunction
+		static const std::string QueryRegionCollisionsFunction;
+
+		//	The name of the ExecuteFunction call which returns the merged scene changes since a frame of the scene of the session, the mmuID of the call is ignored
+		//	Parameters: "SinceFrame" (the frame id returned by the previous call, 0 for the empty scene)
+		//	Returns "FrameID" (the frame of the returned changes), "SceneUpdate" (thrift JSON of the MSceneUpdate) and "FullScene"
+		//	"FullScene" is "true" if the frame is not in the history anymore, then the update contains the complete scene and the caller has to resynchronize
+		static const std::string SceneChangesFunction;
+
 	public:
 		//	Basic initialization of a MMMU
 		void Initialize(::MMIStandard::MBoolResponse& _return, const  ::MMIStandard::MAvatarDescription& avatarDescription, const std::map<std::string, std::string> & properties, const std::string& mmuID, const std::string& sessionID);
@@ -23,6 +102,15 @@ namespace MMIStandard {
 		//	Basic do step routine which triggers the simulation update of the repsective MMU
 		void DoStep(MSimulationResult& _return, const double time, const MSimulationState& simulationState, const std::string& mmuID, const std::string& sessionID);
 
+		//	Executes DoStep for several MMUs of the session with the same simulation state, replaces one DoStep call per MMU
+		//	The results are returned in the order of the MMU ids, the result of a failed MMU only contains the error in its LogData
+		void DoStepBatch(std::vector<MSimulationResult>& _return, const double time, const MSimulationState& simulationState, const std::vector<std::string>& mmuIDs, const std::string& sessionID);
+
+		//	Executes DoStep for the MMUs of several avatars, the avatars are stepped in parallel by the step executor (see SessionData)
+		//	The MMUs of one avatar are stepped sequentially in the given order, steps with the same session id are never executed concurrently
+		//	The results are returned in the order of the steps and MMU ids, independent of the execution order
+		void DoStepBatch(std::vector<std::vector<MSimulationResult>>& _return, const double time, const std::vector<AvatarStep>& avatarSteps);
+
 		//	Returns constraints which are relevant for the transition
 		void GetBoundaryConstraints(std::vector<MConstraint> & _return, const MInstruction& instruction, const std::string& mmuID, const std::string& sessionID);
 
@@ -35,7 +123,8 @@ namespace MMIStandard {
 		//	Method diposes the MMU
 		void Dispose(::MMIStandard::MBoolResponse& _return, const std::string& mmuID, const std::string& sessionID);
 
-		//	Method for executing an arbitrary function (optionally)
+		//	Method for executing an arbitrary function (optionally), the functions of the adapter (e.g. DoStepBatchFunction) are executed by the adapter itself
+		//	If the call fails, only the error message is returned as "Error"
 		void ExecuteFunction(std::map<std::string, std::string> & _return, const std::string& name, const std::map<std::string, std::string> & parameters, const std::string& mmuID, const std::string& sessionID);
 
 		//	Returns the status of the adapter
@@ -53,6 +142,10 @@ namespace MMIStandard {
 		//	Method to synchronize the scene
 		void PushScene(::MMIStandard::MBoolResponse& _return, const  ::MMIStandard::MSceneUpdate& sceneUpdates, const std::string& sessionID);
 
+		//	Method to synchronize the scene, the scene takes over the content of the update instead of copying it
+		//	Is called by the MMIAdapterSceneProcessor with the deserialized arguments of the request
+		void PushScene(::MMIStandard::MBoolResponse& _return, ::MMIStandard::MSceneUpdate&& sceneUpdates, const std::string& sessionID);
+
 		//	Returns despritions of all MMUs which can be loaded
 		void GetLoadableMMUs(std::vector<MMUDescription> & _return);
 
@@ -65,12 +158,17 @@ namespace MMIStandard {
 		//	Returns the whole scene
 		void GetScene(std::vector< ::MMIStandard::MSceneObject> & _return, const std::string& sessionID);
 
-		//	Returns the scene changes of the current frame
+		//	Returns the scene changes of the current frame, the changes since an older frame are returned by the SceneChangesFunction
 		void GetSceneChanges(::MMIStandard::MSceneUpdate& _return, const std::string& sessionID);
 
 		//	Method loads MMUs for the specific session
 		void LoadMMUs(std::map<std::string, std::string>& _return, const std::vector<std::string> & mmus, const std::string& sessionID);
 
+		//	Adds an already instantiated MMU to the session, e.g. an MMU which is linked into the adapter process
+		//	<param name="mmuID">The id of the MMU</param>
+		//	<param name="mmu">The MMU, the scene and service access of the session are assigned to it</param>
+		void AddMMU(::MMIStandard::MBoolResponse& _return, const std::string& mmuID, std::unique_ptr<MotionModelUnitBaseIf> mmu, const std::string& sessionID);
+
 		//	Method creates checkpoint of the given MMU
 		void CreateCheckpoint(std::string& _return, const std::string& mmuID, const std::string& sessionID);
 
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "TransformStore.h"
+#include <stdexcept>
+
+TransformStore::TransformStore() :count{ 0 }
+{
+}
+
+void TransformStore::Insert(Handle handle, const MTransform & transform)
+{
+	if (handle >= this->used.size())
+	{
+		size_t size = size_t(handle) + 1;
+		this->x.resize(size, 0); this->y.resize(size, 0); this->z.resize(size, 0);
+		this->qx.resize(size, 0); this->qy.resize(size, 0); this->qz.resize(size, 0); this->qw.resize(size, 1);
+		this->ids.resize(size);
+		this->parents.resize(size);
+		this->used.resize(size, 0);
+	}
+
+	if (!this->used[handle])
+	{
+		this->used[handle] = 1;
+		this->count++;
+	}
+	this->ids[handle] = transform.ID;
+	this->parents[handle] = transform.Parent;
+	this->SetPosition(handle, transform.Position);
+	this->SetRotation(handle, transform.Rotation);
+}
+
+void TransformStore::Remove(Handle handle)
+{
+	if (!this->IsValid(handle))
+		return;
+
+	this->used[handle] = 0;
+	this->ids[handle].clear();
+	this->parents[handle].clear();
+	this->count--;
+}
+
+void TransformStore::Clear()
+{
+	this->x.clear(); this->y.clear(); this->z.clear();
+	this->qx.clear(); this->qy.clear(); this->qz.clear(); this->qw.clear();
+	this->ids.clear();
+	this->parents.clear();
+	this->used.clear();
+	this->count = 0;
+}
+
+bool TransformStore::IsValid(Handle handle) const
+{
+	return handle < this->used.size() && this->used[handle];
+}
+
+size_t TransformStore::Size() const
+{
+	return this->count;
+}
+
+size_t TransformStore::Capacity() const
+{
+	return this->used.size();
+}
+
+void TransformStore::SetPosition(Handle handle, const MVector3 & position)
+{
+	this->x[handle] = position.X;
+	this->y[handle] = position.Y;
+	this->z[handle] = position.Z;
+}
+
+void TransformStore::SetPosition(Handle handle, const vector<double>& position)
+{
+	if (position.size() < 3)
+	{
+		throw runtime_error("Can not set position: input has less than 3 values");
+	}
+	this->x[handle] = position[0];
+	this->y[handle] = position[1];
+	this->z[handle] = position[2];
+}
+
+void TransformStore::SetRotation(Handle handle, const MQuaternion & rotation)
+{
+	this->qx[handle] = rotation.X;
+	this->qy[handle] = rotation.Y;
+	this->qz[handle] = rotation.Z;
+	this->qw[handle] = rotation.W;
+}
+
+void TransformStore::SetRotation(Handle handle, const vector<double>& rotation)
+{
+	if (rotation.size() < 4)
+	{
+		throw runtime_error("Can not set rotation: input has less than 4 values");
+	}
+	this->qx[handle] = rotation[0];
+	this->qy[handle] = rotation[1];
+	this->qz[handle] = rotation[2];
+	this->qw[handle] = rotation[3];
+}
+
+void TransformStore::SetParent(Handle handle, const string & parent)
+{
+	this->parents[handle] = parent;
+}
+
+void TransformStore::GetPosition(MVector3 & _return, Handle handle) const
+{
+	_return.__set_X(this->x[handle]);
+	_return.__set_Y(this->y[handle]);
+	_return.__set_Z(this->z[handle]);
+}
+
+void TransformStore::GetRotation(MQuaternion & _return, Handle handle) const
+{
+	_return.__set_X(this->qx[handle]);
+	_return.__set_Y(this->qy[handle]);
+	_return.__set_Z(this->qz[handle]);
+	_return.__set_W(this->qw[handle]);
+}
+
+void TransformStore::GetTransform(MTransform & _return, Handle handle) const
+{
+	_return.__set_ID(this->ids[handle]);
+	this->GetPosition(_return.Position, handle);
+	this->GetRotation(_return.Rotation, handle);
+	if (!this->parents[handle].empty())
+		_return.__set_Parent(this->parents[handle]);
+}
+
+double TransformStore::DistanceSquared(Handle handle, const MVector3 & position) const
+{
+	double dx = this->x[handle] - position.X;
+	double dy = this->y[handle] - position.Y;
+	double dz = this->z[handle] - position.Z;
+	return dx * dx + dy * dy + dz * dz;
+}
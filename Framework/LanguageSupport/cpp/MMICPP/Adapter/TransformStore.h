@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "gen-cpp/math_types.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+using namespace MMIStandard;
+using namespace std;
+
+namespace MMIStandard {
+	class TransformStore
+	{
+		/*
+			Dense struct-of-arrays storage of transforms, addressed by an integer handle (see IdInterner).
+			Every component is kept in its own contiguous array so that scans over all positions
+			(e.g. distance checks) are linear and do not touch the remaining scene object data.
+		*/
+	public:
+		typedef uint32_t Handle;
+
+	private:
+		//	The position components
+		vector<double> x, y, z;
+
+		//	The rotation components
+		vector<double> qx, qy, qz, qw;
+
+		//	The ids and parents of the transforms
+		vector<string> ids;
+		vector<string> parents;
+
+		//	Marks the handles which are in use
+		vector<uint8_t> used;
+
+		//	The number of handles in use
+		size_t count;
+
+	public:
+		//	Basic constructor
+		TransformStore();
+
+		//	Stores a transform at the given handle, the arrays grow if required
+		//	<param name="handle">The handle of the owner of the transform</param>
+		//	<param name="transform">The transform which should be stored</param>
+		void Insert(Handle handle, const MTransform &transform);
+
+		//	Removes the transform of the handle
+		void Remove(Handle handle);
+
+		//	Removes all transforms
+		void Clear();
+
+		//	Returns true if the handle addresses a stored transform
+		bool IsValid(Handle handle) const;
+
+		//	Returns the number of stored transforms
+		size_t Size() const;
+
+		//	Returns the upper bound of all handles, the arrays can be scanned from 0 to Capacity
+		size_t Capacity() const;
+
+		//	Setters for the single parts of a transform
+		void SetPosition(Handle handle, const MVector3 &position);
+		void SetPosition(Handle handle, const vector<double> &position);
+		void SetRotation(Handle handle, const MQuaternion &rotation);
+		void SetRotation(Handle handle, const vector<double> &rotation);
+		void SetParent(Handle handle, const string &parent);
+
+		//	Getters for the single parts of a transform
+		void GetPosition(MVector3 &_return, Handle handle) const;
+		void GetRotation(MQuaternion &_return, Handle handle) const;
+
+		//	Returns the complete transform including its id and parent
+		void GetTransform(MTransform &_return, Handle handle) const;
+
+		//	Returns the squared distance between the stored position and the given position
+		double DistanceSquared(Handle handle, const MVector3 &position) const;
+
+		//	Raw access to the contiguous component arrays, unused handles contain stale values
+		const double *PositionX() const { return x.data(); }
+		const double *PositionY() const { return y.data(); }
+		const double *PositionZ() const { return z.data(); }
+		const uint8_t *Used() const { return used.data(); }
+	};
+}
@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "BenchmarkTools.h"
+#include "Adapter/ThriftAdapterImplementation.h"
+#include "Adapter/MotionModelUnitBaseIf.h"
+#include "Adapter/SessionData.h"
+#include "gen-cpp/MMIAdapter.h"
+#include "Utils/TransportSettings.h"
+#include <thrift/transport/TBufferTransports.h>
+
+using namespace MMIStandard;
+using namespace apache::thrift::protocol;
+using namespace apache::thrift::transport;
+
+namespace
+{
+	//	MMU which returns the current posture of the simulation state, measures the overhead of the adapter only
+	class DummyMMU : public MotionModelUnitBaseIf
+	{
+	private:
+		//	The number of additional posture copies per step, simulates the computation of a real MMU
+		int workload;
+
+	public:
+		DummyMMU(int workload = 0) :MotionModelUnitBaseIf("DummyMMU", 0), workload{ workload } {}
+
+		void Initialize(MBoolResponse & _return, const MAvatarDescription &, const std::map<std::string, std::string>&) override { _return.__set_Successful(true); }
+		void AssignInstruction(MBoolResponse & _return, const MInstruction &, const MSimulationState &) override { _return.__set_Successful(true); }
+		void DoStep(MSimulationResult & _return, const double, const MSimulationState & simulationState) override
+		{
+			for (int i = 0; i < this->workload; i++)
+				benchmark::DoNotOptimize(MAvatarPostureValues(simulationState.Current).PostureData.data());
+			_return.__set_Posture(simulationState.Current);
+		}
+		void GetBoundaryConstraints(std::vector<MConstraint>&, const MInstruction &) override {}
+		void CheckPrerequisites(MBoolResponse & _return, const MInstruction &) override { _return.__set_Successful(true); }
+		void Abort(MBoolResponse & _return, const std::string &) override { _return.__set_Successful(true); }
+		void Dispose(MBoolResponse & _return, const std::map<std::string, std::string>&) override { _return.__set_Successful(true); }
+		void CreateCheckpoint(std::string &) override {}
+		void RestoreCheckpoint(MBoolResponse & _return, const std::string &) override { _return.__set_Successful(true); }
+		void ExecuteFunction(std::map<std::string, std::string>&, const std::string &, const std::map<std::string, std::string>&) override {}
+	};
+
+	const string sessionID = "benchmarkScene:avatar0";
+	const string mmuID = "DummyMMU";
+
+	//	Creates the session with the dummy MMU and a scene of the given size
+	void CreateSession(ThriftAdapterImplementation &adapter, int sceneObjectCount, int avatarCount)
+	{
+		MBoolResponse response;
+		adapter.CreateSession(response, sessionID);
+		adapter.AddMMU(response, mmuID, make_unique<DummyMMU>(), sessionID);
+		adapter.PushScene(response, BenchmarkTools::CreateScene(sceneObjectCount, avatarCount), sessionID);
+	}
+
+	//	Creates a simulation state of an avatar with the default number of joints
+	MSimulationState CreateSimulationState()
+	{
+		MSimulationState simulationState;
+		simulationState.Initial.__set_AvatarID("avatar0");
+		simulationState.Initial.__set_PostureData(vector<double>(7 + 4 * BenchmarkTools::JointCount, 0.0));
+		simulationState.__set_Current(simulationState.Initial);
+		return simulationState;
+	}
+}
+
+//	Calls DoStep of the adapter implementation directly, includes the session and MMU lookup
+static void BM_AdapterDoStep(benchmark::State &state)
+{
+	ThriftAdapterImplementation adapter;
+	CreateSession(adapter, static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+	const MSimulationState simulationState = CreateSimulationState();
+
+	size_t allocations = 0;
+	for (auto _ : state)
+	{
+		AllocationScope scope(allocations);
+		MSimulationResult result;
+		adapter.DoStep(result, 0.01, simulationState, mmuID, sessionID);
+		benchmark::DoNotOptimize(result.Posture.PostureData.data());
+	}
+	BenchmarkTools::ReportAllocations(state, allocations);
+
+	MBoolResponse response;
+	adapter.CloseSession(response, sessionID);
+}
+BENCHMARK(BM_AdapterDoStep)->Apply(BenchmarkTools::SceneSizes);
+
+//	Calls DoStep through the generated client and processor over in-memory transports, includes the serialization of request and result
+//	The argument selects the protocol (see Protocol_type)
+static void BM_AdapterDoStepRoundTrip(benchmark::State &state)
+{
+	auto adapter = make_shared<ThriftAdapterImplementation>();
+	CreateSession(*adapter, 100, 2);
+	const MSimulationState simulationState = CreateSimulationState();
+
+	TransportSettings settings;
+	settings.protocol = static_cast<Protocol_type>(state.range(0));
+	state.SetLabel(TransportSettings::ToString(settings.protocol));
+
+	auto requests = make_shared<TMemoryBuffer>();
+	auto responses = make_shared<TMemoryBuffer>();
+	auto serverInput = settings.CreateProtocol(requests);
+	auto serverOutput = settings.CreateProtocol(responses);
+	MMIAdapterClient client(settings.CreateProtocol(responses), settings.CreateProtocol(requests));
+	MMIAdapterProcessor processor(adapter);
+
+	size_t allocations = 0;
+	for (auto _ : state)
+	{
+		AllocationScope scope(allocations);
+		MSimulationResult result;
+		client.send_DoStep(0.01, simulationState, mmuID, sessionID);
+		processor.process(serverInput, serverOutput, nullptr);
+		client.recv_DoStep(result);
+		benchmark::DoNotOptimize(result.Posture.PostureData.data());
+	}
+	BenchmarkTools::ReportAllocations(state, allocations);
+
+	MBoolResponse response;
+	adapter->CloseSession(response, sessionID);
+}
+BENCHMARK(BM_AdapterDoStepRoundTrip)->Arg(P_COMPACT)->Arg(P_BINARY);
+
+//	Calls DoStepBatch of the adapter implementation for several MMUs of the session, the argument is the number of MMUs
+static void BM_AdapterDoStepBatch(benchmark::State &state)
+{
+	ThriftAdapterImplementation adapter;
+	CreateSession(adapter, 100, 2);
+	const MSimulationState simulationState = CreateSimulationState();
+
+	vector<string> mmuIDs{ mmuID };
+	MBoolResponse response;
+	for (int64_t i = 1; i < state.range(0); i++)
+	{
+		mmuIDs.emplace_back(mmuID + std::to_string(i));
+		adapter.AddMMU(response, mmuIDs.back(), make_unique<DummyMMU>(), sessionID);
+	}
+
+	size_t allocations = 0;
+	for (auto _ : state)
+	{
+		AllocationScope scope(allocations);
+		vector<MSimulationResult> results;
+		adapter.DoStepBatch(results, 0.01, simulationState, mmuIDs, sessionID);
+		benchmark::DoNotOptimize(results.data());
+	}
+	BenchmarkTools::ReportAllocations(state, allocations);
+
+	adapter.CloseSession(response, sessionID);
+}
+BENCHMARK(BM_AdapterDoStepBatch)->Arg(1)->Arg(8)->Arg(32);
+
+//	Calls DoStepBatch for several avatars of one scene with one MMU each, the avatars are stepped in parallel by the step executor
+//	The first argument is the number of avatars, the second the workload of the MMUs
+static void BM_AdapterDoStepAvatars(benchmark::State &state)
+{
+	SessionData::CreateStepExecutor(0);
+
+	ThriftAdapterImplementation adapter;
+	CreateSession(adapter, 100, 2);
+
+	vector<AvatarStep> avatarSteps(static_cast<size_t>(state.range(0)));
+	MBoolResponse response;
+	for (size_t i = 0; i < avatarSteps.size(); i++)
+	{
+		avatarSteps[i].sessionID = "benchmarkScene:stepAvatar" + std::to_string(i);
+		avatarSteps[i].simulationState = CreateSimulationState();
+		avatarSteps[i].mmuIDs = { mmuID };
+		adapter.CreateSession(response, avatarSteps[i].sessionID);
+		adapter.AddMMU(response, mmuID, make_unique<DummyMMU>(static_cast<int>(state.range(1))), avatarSteps[i].sessionID);
+	}
+
+	for (auto _ : state)
+	{
+		vector<vector<MSimulationResult>> results;
+		adapter.DoStepBatch(results, 0.01, avatarSteps);
+		benchmark::DoNotOptimize(results.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+
+	adapter.CloseSession(response, sessionID);
+}
+BENCHMARK(BM_AdapterDoStepAvatars)->Args({ 1, 100 })->Args({ 8, 100 })->Args({ 32, 100 })->UseRealTime();
+
+//	Creates a session, steps its MMU and closes it again, each thread uses its own connection and scene
+//	Measures the contention of the session table under create / close churn while the other threads step their sessions
+static void BM_AdapterSessionChurn(benchmark::State &state)
+{
+	ThriftAdapterImplementation adapter;
+	const string churnSessionID = "churnScene" + std::to_string(state.thread_index()) + ":avatar0";
+	const MSimulationState simulationState = CreateSimulationState();
+
+	MBoolResponse response;
+	for (auto _ : state)
+	{
+		adapter.CreateSession(response, churnSessionID);
+		adapter.AddMMU(response, mmuID, make_unique<DummyMMU>(), churnSessionID);
+		MSimulationResult result;
+		adapter.DoStep(result, 0.01, simulationState, mmuID, churnSessionID);
+		adapter.CloseSession(response, churnSessionID);
+		benchmark::DoNotOptimize(result.Posture.PostureData.data());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AdapterSessionChurn)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "BenchmarkTools.h"
+#include "Utils/Logger.h"
+#include <cstdlib>
+#include <new>
+
+//	The global allocation functions count the heap allocations of all benchmarks
+void *operator new(size_t size)
+{
+	BenchmarkTools::allocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (void *ptr = std::malloc(size == 0 ? 1 : size))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+	std::free(ptr);
+}
+
+int main(int argc, char **argv)
+{
+	// the adapter logs every call on debug level, only errors are printed during the measurements
+	Logger::logLevel = L_ERROR;
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+	benchmark::RunSpecifiedBenchmarks();
+	return 0;
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "BenchmarkTools.h"
+#include <cstdlib>
+#include <cstdio>
+
+atomic<size_t> BenchmarkTools::allocationCount{ 0 };
+
+void BenchmarkTools::SceneSizes(benchmark::internal::Benchmark * benchmark)
+{
+	benchmark->Args({ 100, 2 })->Args({ 1000, 10 });
+
+	int sceneObjectCount = 0, avatarCount = 0;
+	const char *scene = std::getenv("MMICPP_BENCHMARK_SCENE");
+	if (scene != nullptr && std::sscanf(scene, "%d,%d", &sceneObjectCount, &avatarCount) == 2 && sceneObjectCount >= 0 && avatarCount >= 0)
+		benchmark->Args({ sceneObjectCount, avatarCount });
+}
+
+MSceneUpdate BenchmarkTools::CreateScene(int sceneObjectCount, int avatarCount)
+{
+	MSceneUpdate sceneUpdate;
+	vector<MSceneObject> sceneObjects(sceneObjectCount);
+	for (int i = 0; i < sceneObjectCount; i++)
+	{
+		sceneObjects[i].__set_ID("object" + std::to_string(i));
+		sceneObjects[i].__set_Name("object" + std::to_string(i % 10));
+		sceneObjects[i].Transform.__set_ID(sceneObjects[i].ID);
+		sceneObjects[i].Transform.Position.__set_X(i % 50);
+		sceneObjects[i].Transform.Position.__set_Z(i / 50);
+		sceneObjects[i].Transform.Rotation.__set_W(1);
+	}
+	sceneUpdate.__set_AddedSceneObjects(sceneObjects);
+
+	vector<MAvatar> avatars(avatarCount);
+	for (int i = 0; i < avatarCount; i++)
+	{
+		avatars[i].__set_ID("avatar" + std::to_string(i));
+		avatars[i].__set_Name("avatar" + std::to_string(i));
+		avatars[i].PostureValues.__set_AvatarID(avatars[i].ID);
+		avatars[i].PostureValues.__set_PostureData(vector<double>(7 + 4 * JointCount, 0.0));
+	}
+	sceneUpdate.__set_AddedAvatars(avatars);
+	return sceneUpdate;
+}
+
+MSceneUpdate BenchmarkTools::CreateFrame(int sceneObjectCount, int avatarCount, int frame)
+{
+	MSceneUpdate sceneUpdate;
+	vector<MSceneObjectUpdate> sceneObjects(sceneObjectCount);
+	for (int i = 0; i < sceneObjectCount; i++)
+	{
+		sceneObjects[i].__set_ID("object" + std::to_string(i));
+		MTransformUpdate transform;
+		transform.__set_Position(vector<double>{ double(i % 50), 0.01 * frame, double(i / 50) });
+		transform.__set_Rotation(vector<double>{ 0, 0, 0, 1 });
+		sceneObjects[i].__set_Transform(transform);
+	}
+	sceneUpdate.__set_ChangedSceneObjects(sceneObjects);
+
+	vector<MAvatarUpdate> avatars(avatarCount);
+	for (int i = 0; i < avatarCount; i++)
+	{
+		avatars[i].__set_ID("avatar" + std::to_string(i));
+		MAvatarPostureValues postureValues;
+		postureValues.__set_AvatarID(avatars[i].ID);
+		postureValues.__set_PostureData(vector<double>(7 + 4 * JointCount, 0.01 * frame));
+		avatars[i].__set_PostureValues(postureValues);
+	}
+	sceneUpdate.__set_ChangedAvatars(avatars);
+	return sceneUpdate;
+}
+
+MAvatarPosture BenchmarkTools::CreatePosture(const string & avatarID, int jointCount)
+{
+	MAvatarPosture posture;
+	posture.__set_AvatarID(avatarID);
+	posture.Joints.resize(jointCount);
+	for (int i = 0; i < jointCount; i++)
+	{
+		posture.Joints[i].__set_ID("joint" + std::to_string(i));
+		posture.Joints[i].Position.__set_Y(0.1 * i);
+		posture.Joints[i].Rotation.__set_W(1);
+		if (i > 0)
+			posture.Joints[i].__set_Parent(posture.Joints[i - 1].ID);
+	}
+	return posture;
+}
+
+void BenchmarkTools::ReportAllocations(benchmark::State & state, size_t allocations)
+{
+	state.counters["allocs/iter"] = benchmark::Counter(double(allocations), benchmark::Counter::kAvgIterations);
+}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "gen-cpp/scene_types.h"
+#include "gen-cpp/avatar_types.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+
+using namespace MMIStandard;
+using namespace std;
+
+namespace MMIStandard {
+	class BenchmarkTools
+	{
+		/*
+			Synthetic scenes and helpers which are shared by the benchmarks.
+			The default scene sizes can be extended with the environment variable MMICPP_BENCHMARK_SCENE,
+			e.g. MMICPP_BENCHMARK_SCENE=20000,100 adds a scene with 20000 scene objects and 100 avatars.
+		*/
+	public:
+		//	The number of heap allocations of the process, is incremented by the global operator new (see BenchmarkMain.cpp)
+		static atomic<size_t> allocationCount;
+
+		//	The number of joints of the synthetic avatars
+		static const int JointCount = 20;
+
+		//	Registers the scene sizes as arguments (scene objects, avatars) of a benchmark
+		static void SceneSizes(benchmark::internal::Benchmark *benchmark);
+
+		//	Creates a scene update which adds the given number of scene objects and avatars
+		//	The scene objects are placed on a grid with a distance of 1 along x and z
+		static MSceneUpdate CreateScene(int sceneObjectCount, int avatarCount);
+
+		//	Creates a scene update which moves every scene object and changes the posture of every avatar
+		static MSceneUpdate CreateFrame(int sceneObjectCount, int avatarCount, int frame);
+
+		//	Creates a posture with the given number of joints
+		static MAvatarPosture CreatePosture(const string &avatarID, int jointCount);
+
+		//	Reports the average number of allocations per iteration
+		static void ReportAllocations(benchmark::State &state, size_t allocations);
+	};
+
+	//	Counts the allocations of a scope
+	class AllocationScope
+	{
+		size_t &allocations;
+		size_t start;
+	public:
+		AllocationScope(size_t &allocations) :allocations{ allocations }, start{ BenchmarkTools::allocationCount.load(memory_order_relaxed) } {}
+		~AllocationScope() { allocations += BenchmarkTools::allocationCount.load(memory_order_relaxed) - start; }
+	};
+}
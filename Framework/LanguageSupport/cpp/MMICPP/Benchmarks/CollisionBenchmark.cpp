@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "BenchmarkTools.h"
+#include "Collision/CollisionWorld.h"
+#include "Collision/LocalCollisionDetection.h"
+
+using namespace MMIStandard;
+
+namespace
+{
+	MCollider CreateBoxCollider(double size)
+	{
+		MCollider collider;
+		collider.__set_ID("box");
+		collider.__set_Type(MColliderType::Box);
+		MBoxColliderProperties properties;
+		properties.Size.__set_X(size);
+		properties.Size.__set_Y(size);
+		properties.Size.__set_Z(size);
+		collider.__set_BoxColliderProperties(properties);
+		return collider;
+	}
+
+	MCollider CreateCapsuleCollider(double radius, double height)
+	{
+		MCollider collider;
+		collider.__set_ID("capsule");
+		collider.__set_Type(MColliderType::Capsule);
+		MCapsuleColliderProperties properties;
+		properties.__set_Radius(radius);
+		properties.__set_Height(height);
+		collider.__set_CapsuleColliderProperties(properties);
+		return collider;
+	}
+
+	MTransform CreateTransform(double x, double y, double z, double angle)
+	{
+		MTransform transform;
+		transform.Position.__set_X(x);
+		transform.Position.__set_Y(y);
+		transform.Position.__set_Z(z);
+		transform.Rotation.__set_Y(sin(angle / 2));
+		transform.Rotation.__set_W(cos(angle / 2));
+		return transform;
+	}
+
+	//	The scene of BenchmarkTools with boxes which overlap their neighbours on the grid
+	MSceneUpdate CreateCollisionScene(int sceneObjectCount, int avatarCount)
+	{
+		MSceneUpdate sceneUpdate = BenchmarkTools::CreateScene(sceneObjectCount, avatarCount);
+		MCollider collider = CreateBoxCollider(1.2);
+		for (MSceneObject &sceneObject : sceneUpdate.AddedSceneObjects)
+		{
+			// the clients use the id of the scene object as id of its collider
+			collider.__set_ID(sceneObject.ID);
+			sceneObject.__set_Collider(collider);
+		}
+		return sceneUpdate;
+	}
+}
+
+//	Computes the penetration of two rotated boxes (GJK and EPA)
+static void BM_CollisionBoxPenetration(benchmark::State &state)
+{
+	CollisionShape box(CreateBoxCollider(1));
+	Pose3d poseA(CreateTransform(0, 0, 0, 0.3));
+	Pose3d poseB(CreateTransform(0.9, 0.2, 0.1, 0.7));
+	for (auto _ : state)
+	{
+		Vector3d penetration;
+		bool colliding = LocalCollisionDetection::ComputePenetration(penetration, box, poseA, box, poseB);
+		benchmark::DoNotOptimize(colliding);
+	}
+}
+BENCHMARK(BM_CollisionBoxPenetration);
+
+//	Tests a capsule against a box without computing the penetration (GJK only)
+static void BM_CollisionCapsuleBox(benchmark::State &state)
+{
+	CollisionShape capsule(CreateCapsuleCollider(0.3, 1.8));
+	CollisionShape box(CreateBoxCollider(1));
+	Pose3d poseA(CreateTransform(0.7, 0, 0, 0));
+	Pose3d poseB(CreateTransform(0, 0, 0, 0.5));
+	for (auto _ : state)
+	{
+		bool colliding = LocalCollisionDetection::CausesCollision(capsule, poseA, box, poseB);
+		benchmark::DoNotOptimize(colliding);
+	}
+}
+BENCHMARK(BM_CollisionCapsuleBox);
+
+//	Tests two colliders through the thrift interface, both colliders are compiled by every call
+static void BM_CollisionServiceCall(benchmark::State &state)
+{
+	LocalCollisionDetection collisionDetection;
+	MCollider box = CreateBoxCollider(1);
+	MTransform transformA = CreateTransform(0, 0, 0, 0.3);
+	MTransform transformB = CreateTransform(0.9, 0.2, 0.1, 0.7);
+	for (auto _ : state)
+	{
+		MVector3 penetration;
+		collisionDetection.ComputePenetration(penetration, box, transformA, box, transformB);
+		benchmark::DoNotOptimize(penetration.X);
+	}
+}
+BENCHMARK(BM_CollisionServiceCall);
+
+//	Builds the broad phase from the colliders of the scene
+static void BM_CollisionWorldBuild(benchmark::State &state)
+{
+	MMIScene scene;
+	MBoolResponse response;
+	scene.Apply(response, CreateCollisionScene(static_cast<int>(state.range(0)), static_cast<int>(state.range(1))));
+
+	CollisionWorld world;
+	for (auto _ : state)
+	{
+		world.Build(scene);
+		benchmark::DoNotOptimize(world.Size());
+	}
+}
+BENCHMARK(BM_CollisionWorldBuild)->Apply(BenchmarkTools::SceneSizes);
+
+//	Tests all pairs of colliders whose bounds overlap, every box overlaps its neighbours
+static void BM_CollisionWorldAllPairs(benchmark::State &state)
+{
+	MMIScene scene;
+	MBoolResponse response;
+	scene.Apply(response, CreateCollisionScene(static_cast<int>(state.range(0)), static_cast<int>(state.range(1))));
+
+	CollisionWorld world;
+	world.Build(scene);
+	size_t pairs = 0;
+	for (auto _ : state)
+	{
+		world.VisitOverlappingPairs([&](size_t a, size_t b)
+		{
+			if (world.Intersect(a, b))
+				pairs++;
+		});
+	}
+	state.counters["Pairs"] = benchmark::Counter(static_cast<double>(pairs), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_CollisionWorldAllPairs)->Apply(BenchmarkTools::SceneSizes);
+
+//	Tests the stored collider of one scene object against all colliders of the scene in a single batch query
+static void BM_CollisionWorldQuerySceneObject(benchmark::State &state)
+{
+	MMIScene scene;
+	MBoolResponse response;
+	MSceneUpdate sceneUpdate = CreateCollisionScene(static_cast<int>(state.range(0)), static_cast<int>(state.range(1)));
+	string sceneObjectID = sceneUpdate.AddedSceneObjects[sceneUpdate.AddedSceneObjects.size() / 2].ID;
+	scene.Apply(response, sceneUpdate);
+
+	CollisionWorld world;
+	world.Build(scene);
+	vector<CollisionWorld::Contact> contacts;
+	for (auto _ : state)
+	{
+		contacts.clear();
+		world.QuerySceneObject(contacts, sceneObjectID, true);
+		benchmark::DoNotOptimize(contacts.data());
+	}
+	state.counters["Contacts"] = static_cast<double>(contacts.size());
+}
+BENCHMARK(BM_CollisionWorldQuerySceneObject)->Apply(BenchmarkTools::SceneSizes);
+
+//	Tests all pairs of colliders within a region which covers about a quarter of the scene
+static void BM_CollisionWorldQueryRegion(benchmark::State &state)
+{
+	MMIScene scene;
+	MBoolResponse response;
+	scene.Apply(response, CreateCollisionScene(static_cast<int>(state.range(0)), static_cast<int>(state.range(1))));
+
+	CollisionWorld world;
+	world.Build(scene);
+	Bounds3d sceneBounds;
+	for (size_t i = 0; i < world.Size(); i++)
+		sceneBounds.Add(world.GetEntry(i).bounds);
+	Bounds3d region(sceneBounds.min, sceneBounds.min + (sceneBounds.max - sceneBounds.min) * 0.5);
+
+	vector<CollisionWorld::Contact> contacts;
+	for (auto _ : state)
+	{
+		contacts.clear();
+		world.QueryRegion(contacts, region, false);
+		benchmark::DoNotOptimize(contacts.data());
+	}
+	state.counters["Contacts"] = static_cast<double>(contacts.size());
+}
+BENCHMARK(BM_CollisionWorldQueryRegion)->Apply(BenchmarkTools::SceneSizes);
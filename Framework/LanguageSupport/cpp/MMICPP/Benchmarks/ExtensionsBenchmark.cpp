@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "BenchmarkTools.h"
+#include "Extensions/MAvatarPostureExtensions.h"
+#include "Adapter/SessionTools.h"
+
+using namespace MMIStandard;
+
+//	Converts a posture with the given number of joints into posture values
+static void BM_GetPostureValues(benchmark::State &state)
+{
+	const MAvatarPosture posture = BenchmarkTools::CreatePosture("avatar", static_cast<int>(state.range(0)));
+
+	size_t allocations = 0;
+	for (auto _ : state)
+	{
+		AllocationScope scope(allocations);
+		MAvatarPostureValues postureValues;
+		MavatarPostureExtensions::GetPostureValues(postureValues, posture);
+		benchmark::DoNotOptimize(postureValues.PostureData.data());
+	}
+	BenchmarkTools::ReportAllocations(state, allocations);
+}
+BENCHMARK(BM_GetPostureValues)->Arg(BenchmarkTools::JointCount)->Arg(100);
+
+//	Assigns posture values to a posture with the given number of joints
+static void BM_AssignPostureValues(benchmark::State &state)
+{
+	MAvatarPosture posture = BenchmarkTools::CreatePosture("avatar", static_cast<int>(state.range(0)));
+	MAvatarPostureValues postureValues;
+	MavatarPostureExtensions::GetPostureValues(postureValues, posture);
+
+	size_t allocations = 0;
+	for (auto _ : state)
+	{
+		AllocationScope scope(allocations);
+		MavatarPostureExtensions::AssignPostureValues(posture, postureValues);
+		benchmark::DoNotOptimize(posture.Joints.data());
+	}
+	BenchmarkTools::ReportAllocations(state, allocations);
+}
+BENCHMARK(BM_AssignPostureValues)->Arg(BenchmarkTools::JointCount)->Arg(100);
+
+//	Splits a session id into the scene id and the avatar id, is done by every adapter call
+static void BM_GetSplittedIds(benchmark::State &state)
+{
+	const string sessionID = "7f4b2c1e-3d5a-4e8b-9c0f-1a2b3c4d5e6f:avatar0";
+
+	size_t allocations = 0;
+	for (auto _ : state)
+	{
+		AllocationScope scope(allocations);
+		vector<string> ids = SessionTools::GetSplittedIds(sessionID);
+		benchmark::DoNotOptimize(ids.data());
+	}
+	BenchmarkTools::ReportAllocations(state, allocations);
+}
+BENCHMARK(BM_GetSplittedIds);
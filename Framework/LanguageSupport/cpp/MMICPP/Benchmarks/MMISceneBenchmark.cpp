@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "BenchmarkTools.h"
+#include "Adapter/MMIScene.h"
+
+using namespace MMIStandard;
+
+//	Applies a frame which is passed by const reference, the scene has to copy the update
+static void BM_ApplyCopy(benchmark::State &state)
+{
+	const int sceneObjectCount = static_cast<int>(state.range(0));
+	const int avatarCount = static_cast<int>(state.range(1));
+	MMIScene scene;
+	MBoolResponse response;
+	scene.Apply(response, BenchmarkTools::CreateScene(sceneObjectCount, avatarCount));
+	const MSceneUpdate frame = BenchmarkTools::CreateFrame(sceneObjectCount, avatarCount, 1);
+
+	size_t allocations = 0;
+	for (auto _ : state)
+	{
+		AllocationScope scope(allocations);
+		scene.Apply(response, frame);
+	}
+	BenchmarkTools::ReportAllocations(state, allocations);
+}
+BENCHMARK(BM_ApplyCopy)->Apply(BenchmarkTools::SceneSizes);
+
+//	Applies a frame which is passed by rvalue reference, the scene takes over the update
+static void BM_ApplyMove(benchmark::State &state)
+{
+	const int sceneObjectCount = static_cast<int>(state.range(0));
+	const int avatarCount = static_cast<int>(state.range(1));
+	MMIScene scene;
+	MBoolResponse response;
+	scene.Apply(response, BenchmarkTools::CreateScene(sceneObjectCount, avatarCount));
+	const MSceneUpdate frame = BenchmarkTools::CreateFrame(sceneObjectCount, avatarCount, 1);
+
+	size_t allocations = 0;
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		MSceneUpdate update = frame;
+		state.ResumeTiming();
+
+		AllocationScope scope(allocations);
+		scene.Apply(response, std::move(update));
+	}
+	BenchmarkTools::ReportAllocations(state, allocations);
+}
+BENCHMARK(BM_ApplyMove)->Apply(BenchmarkTools::SceneSizes);
+
+//	Returns the scene objects within a range which covers about 5x5 scene objects of the grid
+static void BM_GetSceneObjectsInRange(benchmark::State &state)
+{
+	const int sceneObjectCount = static_cast<int>(state.range(0));
+	MMIScene scene;
+	MBoolResponse response;
+	scene.Apply(response, BenchmarkTools::CreateScene(sceneObjectCount, static_cast<int>(state.range(1))));
+
+	MVector3 position;
+	position.__set_X(25);
+	position.__set_Z(sceneObjectCount / 100);
+
+	size_t allocations = 0;
+	for (auto _ : state)
+	{
+		AllocationScope scope(allocations);
+		vector<MSceneObject> sceneObjects;
+		scene.GetSceneObjectsInRange(sceneObjects, position, 2.5);
+		benchmark::DoNotOptimize(sceneObjects.data());
+	}
+	BenchmarkTools::ReportAllocations(state, allocations);
+}
+BENCHMARK(BM_GetSceneObjectsInRange)->Apply(BenchmarkTools::SceneSizes);
+
+//	Visits the scene objects within the same range without copying them
+static void BM_VisitSceneObjectsInRange(benchmark::State &state)
+{
+	const int sceneObjectCount = static_cast<int>(state.range(0));
+	MMIScene scene;
+	MBoolResponse response;
+	scene.Apply(response, BenchmarkTools::CreateScene(sceneObjectCount, static_cast<int>(state.range(1))));
+
+	MVector3 position;
+	position.__set_X(25);
+	position.__set_Z(sceneObjectCount / 100);
+
+	size_t allocations = 0;
+	for (auto _ : state)
+	{
+		AllocationScope scope(allocations);
+		size_t count = 0;
+		scene.VisitSceneObjectsInRange(position, 2.5, [&](const SceneObjectEntry &)
+		{
+			count++;
+		});
+		benchmark::DoNotOptimize(count);
+	}
+	BenchmarkTools::ReportAllocations(state, allocations);
+}
+BENCHMARK(BM_VisitSceneObjectsInRange)->Apply(BenchmarkTools::SceneSizes);
+
+//	Returns the avatars within a range around the origin
+static void BM_GetAvatarsInRange(benchmark::State &state)
+{
+	MMIScene scene;
+	MBoolResponse response;
+	scene.Apply(response, BenchmarkTools::CreateScene(static_cast<int>(state.range(0)), static_cast<int>(state.range(1))));
+
+	MVector3 position;
+	for (auto _ : state)
+	{
+		vector<MAvatar> avatars;
+		scene.GetAvatarsInRange(avatars, position, 1.0);
+		benchmark::DoNotOptimize(avatars.data());
+	}
+}
+BENCHMARK(BM_GetAvatarsInRange)->Apply(BenchmarkTools::SceneSizes);
+
+//	Copies the whole scene into a scene update
+static void BM_GetFullScene(benchmark::State &state)
+{
+	MMIScene scene;
+	MBoolResponse response;
+	scene.Apply(response, BenchmarkTools::CreateScene(static_cast<int>(state.range(0)), static_cast<int>(state.range(1))));
+
+	size_t allocations = 0;
+	for (auto _ : state)
+	{
+		AllocationScope scope(allocations);
+		MSceneUpdate fullScene;
+		scene.GetFullScene(fullScene);
+		benchmark::DoNotOptimize(fullScene.AddedSceneObjects.data());
+	}
+	BenchmarkTools::ReportAllocations(state, allocations);
+}
+BENCHMARK(BM_GetFullScene)->Apply(BenchmarkTools::SceneSizes);
+
+//	Merges the changes of the last 10 frames into a single update
+static void BM_GetSceneChanges(benchmark::State &state)
+{
+	const int sceneObjectCount = static_cast<int>(state.range(0));
+	const int avatarCount = static_cast<int>(state.range(1));
+	MMIScene scene;
+	MBoolResponse response;
+	scene.Apply(response, BenchmarkTools::CreateScene(sceneObjectCount, avatarCount));
+	for (int frame = 1; frame <= 10; frame++)
+		scene.Apply(response, BenchmarkTools::CreateFrame(sceneObjectCount, avatarCount, frame));
+
+	const int toFrameID = scene.GetFrameID();
+	for (auto _ : state)
+	{
+		MSceneUpdate changes;
+		bool merged = scene.GetSceneChanges(changes, toFrameID - 10, toFrameID);
+		benchmark::DoNotOptimize(merged);
+	}
+}
+BENCHMARK(BM_GetSceneChanges)->Apply(BenchmarkTools::SceneSizes);
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "Checks.h"
+#include "Utils/Logger.h"
+#include <cstdio>
+#include <vector>
+#include <utility>
+
+using namespace MMIStandard;
+
+namespace
+{
+	//	The registered checks, is a function static so the registration does not depend on the initialization order of the files
+	vector<pair<const char*, void(*)()>> &GetChecks()
+	{
+		static vector<pair<const char*, void(*)()>> checks;
+		return checks;
+	}
+
+	//	The number of failed conditions of the running check
+	int failures = 0;
+}
+
+int Checks::Register(const char * name, void(*check)())
+{
+	GetChecks().emplace_back(name, check);
+	return 0;
+}
+
+void Checks::Fail(const char * file, int line, const string & condition)
+{
+	printf("%s:%d: CHECK(%s) failed\n", file, line, condition.c_str());
+	failures++;
+}
+
+int Checks::RunAll()
+{
+	int failedChecks = 0;
+	for (const auto &check : GetChecks())
+	{
+		failures = 0;
+		check.second();
+		printf("%s %s\n", failures == 0 ? "passed" : "FAILED", check.first);
+		if (failures != 0)
+			failedChecks++;
+	}
+	printf("%d of %zu checks failed\n", failedChecks, GetChecks().size());
+	return failedChecks;
+}
+
+int main(int argc, char **argv)
+{
+	Logger::logLevel = L_ERROR;
+	return Checks::RunAll() == 0 ? 0 : 1;
+}
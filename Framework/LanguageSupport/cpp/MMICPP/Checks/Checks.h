@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include <string>
+#include <cmath>
+
+using namespace std;
+
+namespace MMIStandard {
+	class Checks
+	{
+		/*
+			Known answer checks of the adapter internals, are built with MMICPP_BUILD_CHECKS and run by ctest.
+			A check is a function which is registered with MMICPP_CHECK, failed conditions are reported with CHECK / CHECK_NEAR.
+		*/
+	public:
+		//	Registers the check, is called by MMICPP_CHECK during the static initialization
+		static int Register(const char *name, void(*check)());
+
+		//	Reports a failed condition of the running check
+		static void Fail(const char *file, int line, const string &condition);
+
+		//	Runs all checks, returns the number of failed checks
+		static int RunAll();
+	};
+}
+
+#define MMICPP_CHECK(name) \
+	static void name(); \
+	static const int name##Registration = MMIStandard::Checks::Register(#name, name); \
+	static void name()
+
+#define CHECK(condition) \
+	do { if (!(condition)) MMIStandard::Checks::Fail(__FILE__, __LINE__, #condition); } while (0)
+
+#define CHECK_NEAR(value, expected, tolerance) \
+	CHECK(std::fabs((value) - (expected)) <= (tolerance))
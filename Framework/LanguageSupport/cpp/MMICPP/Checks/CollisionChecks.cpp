@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "Checks.h"
+#include "Collision/GjkEpa.h"
+
+using namespace MMIStandard;
+
+namespace
+{
+	const double tolerance = 1e-6;
+	const double pi = 3.14159265358979323846;
+
+	//	Returns the pose at the position, rotated by the angle (radians) around the unit axis
+	Pose3d At(double x, double y, double z, const Vector3d &axis = Vector3d(0, 0, 1), double angle = 0)
+	{
+		MQuaternion rotation;
+		rotation.__set_X(axis.x * sin(angle / 2));
+		rotation.__set_Y(axis.y * sin(angle / 2));
+		rotation.__set_Z(axis.z * sin(angle / 2));
+		rotation.__set_W(cos(angle / 2));
+		return Pose3d(Vector3d(x, y, z), Rotation3d(rotation));
+	}
+
+	ConvexShape Box(const Vector3d &halfExtents, const Pose3d &pose)
+	{
+		ConvexShape shape;
+		shape.type = MColliderType::Box;
+		shape.halfExtents = halfExtents;
+		return shape.Place(pose);
+	}
+
+	ConvexShape Sphere(double radius, const Pose3d &pose)
+	{
+		ConvexShape shape;
+		shape.type = MColliderType::Sphere;
+		shape.radius = radius;
+		return shape.Place(pose);
+	}
+
+	//	The segment of the capsule is along the local y axis
+	ConvexShape Capsule(double radius, double halfHeight, const Pose3d &pose)
+	{
+		ConvexShape shape;
+		shape.type = MColliderType::Capsule;
+		shape.radius = radius;
+		shape.halfHeight = halfHeight;
+		shape.axis = Vector3d(0, 1, 0);
+		return shape.Place(pose);
+	}
+
+	//	The convex hull of the vertices, like a mesh collider
+	ConvexShape Hull(const vector<Vector3d> &vertices, const Pose3d &pose)
+	{
+		ConvexShape shape;
+		shape.type = MColliderType::Mesh;
+		shape.vertices = make_shared<const vector<Vector3d>>(vertices);
+		return shape.Place(pose);
+	}
+
+	const Vector3d unit(1, 1, 1);
+}
+
+MMICPP_CHECK(BoxBoxSeparated)
+{
+	Vector3d penetration(1, 1, 1);
+	CHECK(!GjkEpa::Intersect(Box(unit, At(0, 0, 0)), Box(unit, At(2.1, 0, 0))));
+	CHECK(!GjkEpa::Penetration(penetration, Box(unit, At(0, 0, 0)), Box(unit, At(1.5, 1.5, 2.01))));
+	CHECK(penetration.Length() == 0);
+}
+
+MMICPP_CHECK(BoxBoxTouching)
+{
+	// the faces touch, the boxes intersect without penetration
+	Vector3d penetration(1, 1, 1);
+	CHECK(GjkEpa::Penetration(penetration, Box(unit, At(0, 0, 0)), Box(unit, At(2, 0.5, 0))));
+	CHECK_NEAR(penetration.Length(), 0, tolerance);
+}
+
+MMICPP_CHECK(BoxBoxOverlapping)
+{
+	// the overlap is smallest along x, a is moved back by it
+	Vector3d penetration;
+	CHECK(GjkEpa::Penetration(penetration, Box(unit, At(0, 0, 0)), Box(unit, At(1.8, 0.3, 0.1))));
+	CHECK_NEAR(penetration.x, -0.2, tolerance);
+	CHECK_NEAR(penetration.y, 0, tolerance);
+	CHECK_NEAR(penetration.z, 0, tolerance);
+
+	CHECK(GjkEpa::Penetration(penetration, Box(Vector3d(2, 0.5, 1), At(0, 0, 0)), Box(unit, At(0.5, -1.2, 0.5))));
+	CHECK_NEAR(penetration.x, 0, tolerance);
+	CHECK_NEAR(penetration.y, 0.3, tolerance);
+	CHECK_NEAR(penetration.z, 0, tolerance);
+}
+
+MMICPP_CHECK(RotatedBoxOverlapping)
+{
+	// rotated by 45 degrees around z, the edge of a reaches sqrt(2) along x
+	Vector3d penetration;
+	CHECK(GjkEpa::Penetration(penetration, Box(unit, At(0, 0, 0, Vector3d(0, 0, 1), pi / 4)), Box(unit, At(2.3, 0, 0))));
+	CHECK_NEAR(penetration.x, 1.3 - sqrt(2.0), tolerance);
+	CHECK_NEAR(penetration.y, 0, tolerance);
+	CHECK_NEAR(penetration.z, 0, tolerance);
+	CHECK(!GjkEpa::Intersect(Box(unit, At(0, 0, 0, Vector3d(0, 0, 1), pi / 4)), Box(unit, At(2.5, 0, 0))));
+}
+
+MMICPP_CHECK(SphereSphereDepth)
+{
+	Vector3d penetration;
+	CHECK(GjkEpa::Penetration(penetration, Sphere(1, At(0, 0, 0)), Sphere(0.5, At(0, 0, 1.2))));
+	CHECK_NEAR(penetration.x, 0, tolerance);
+	CHECK_NEAR(penetration.y, 0, tolerance);
+	CHECK_NEAR(penetration.z, -0.3, tolerance);
+	CHECK(!GjkEpa::Intersect(Sphere(1, At(0, 0, 0)), Sphere(0.5, At(1.2, 1.2, 0))));
+}
+
+MMICPP_CHECK(CapsuleCapsuleDepth)
+{
+	// crossing capsules, the closest points of the segments are 0.8 apart along z
+	Vector3d penetration;
+	CHECK(GjkEpa::Penetration(penetration, Capsule(0.5, 1, At(0, 0, 0)), Capsule(0.5, 1, At(0, 0, 0.8, Vector3d(0, 0, 1), pi / 2))));
+	CHECK_NEAR(penetration.x, 0, tolerance);
+	CHECK_NEAR(penetration.y, 0, tolerance);
+	CHECK_NEAR(penetration.z, -0.2, tolerance);
+
+	// parallel capsules whose caps overlap along their axis
+	CHECK(GjkEpa::Penetration(penetration, Capsule(0.5, 1, At(0, 0, 0)), Capsule(0.25, 1, At(0, 2.5, 0))));
+	CHECK_NEAR(penetration.y, -0.25, tolerance);
+	CHECK(!GjkEpa::Intersect(Capsule(0.5, 1, At(0, 0, 0)), Capsule(0.25, 1, At(0.8, 0, 0))));
+}
+
+MMICPP_CHECK(MeshHullOverlapping)
+{
+	// a tetrahedron whose apex reaches 0.25 into the top face of the box
+	vector<Vector3d> vertices = { Vector3d(0, 0, 0), Vector3d(1, 1, 0), Vector3d(-1, 1, 0), Vector3d(0, 1, 1) };
+	Vector3d penetration;
+	CHECK(GjkEpa::Penetration(penetration, Hull(vertices, At(0, 0.75, 0)), Box(unit, At(0, 0, 0))));
+	CHECK_NEAR(penetration.x, 0, tolerance);
+	CHECK_NEAR(penetration.y, 0.25, tolerance);
+	CHECK_NEAR(penetration.z, 0, tolerance);
+	CHECK(!GjkEpa::Intersect(Hull(vertices, At(0, 1.1, 0)), Box(unit, At(0, 0, 0))));
+}
+
+MMICPP_CHECK(DegenerateSimplex)
+{
+	// concentric boxes, GJK ends with the origin on its first support point
+	Vector3d penetration;
+	CHECK(GjkEpa::Penetration(penetration, Box(unit, At(0, 0, 0)), Box(Vector3d(0.5, 0.5, 0.5), At(0, 0, 0))));
+	CHECK_NEAR(penetration.Length(), 1.5, tolerance);
+
+	// flat boxes in the same plane, the Minkowski difference has no volume and the penetration is zero
+	penetration = Vector3d(1, 1, 1);
+	CHECK(GjkEpa::Penetration(penetration, Box(Vector3d(1, 1, 0), At(0, 0, 0)), Box(Vector3d(1, 1, 0), At(0.5, 0.5, 0))));
+	CHECK_NEAR(penetration.Length(), 0, tolerance);
+}
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "Checks.h"
+#include "Adapter/GeometryStore.h"
+#include "Adapter/MMIScene.h"
+
+using namespace MMIStandard;
+
+namespace
+{
+	//	A mesh and a box collider with the id of the scene object, like the clients create them
+	MSceneObject CreateBolt(const string &id, double x)
+	{
+		MSceneObject sceneObject;
+		sceneObject.__set_ID(id);
+		sceneObject.__set_Name("Bolt");
+		sceneObject.Transform.__set_ID(id);
+		sceneObject.Transform.Position.__set_X(x);
+		sceneObject.Transform.Rotation.__set_W(1);
+
+		MMesh mesh;
+		mesh.__set_ID(id);
+		for (int i = 0; i < 3; i++)
+		{
+			MVector3 vertex;
+			vertex.__set_X(i);
+			vertex.__set_Y(i * 2);
+			mesh.Vertices.push_back(vertex);
+			mesh.Triangles.push_back(i);
+		}
+		sceneObject.__set_Mesh(mesh);
+
+		MCollider collider;
+		collider.__set_ID(id);
+		collider.__set_Type(MColliderType::Box);
+		MBoxColliderProperties properties;
+		properties.Size.__set_X(1);
+		properties.Size.__set_Y(1);
+		properties.Size.__set_Z(1);
+		collider.__set_BoxColliderProperties(properties);
+		sceneObject.__set_Collider(collider);
+		return sceneObject;
+	}
+}
+
+//	Geometry which only differs in the ID is stored once
+MMICPP_CHECK(GeometryStoreSharesGeometryWithDifferentIDs)
+{
+	GeometryStore store;
+	MSceneObject boltA = CreateBolt("boltA", 0);
+	MSceneObject boltB = CreateBolt("boltB", 1);
+
+	shared_ptr<const MMesh> meshA = store.Share(boltA.Mesh);
+	shared_ptr<const MMesh> meshB = store.Share(boltB.Mesh);
+	CHECK(meshA == meshB);
+	CHECK(store.MeshCount() == 1);
+	CHECK(meshA->ID.empty());
+
+	shared_ptr<const MCollider> colliderA = store.Share(boltA.Collider);
+	shared_ptr<const MCollider> colliderB = store.Share(boltB.Collider);
+	CHECK(colliderA == colliderB);
+	CHECK(store.ColliderCount() == 1);
+
+	// different geometry is not shared
+	boltB.Mesh.Vertices[0].__set_Z(1);
+	shared_ptr<const MMesh> meshC = store.Share(boltB.Mesh);
+	CHECK(meshC != meshA);
+	CHECK(store.MeshCount() == 2);
+}
+
+//	The scene shares the geometry of the scene objects and returns it with the ID of each scene object
+MMICPP_CHECK(SceneRestoresGeometryIDs)
+{
+	MMIScene scene;
+	MSceneUpdate sceneUpdate;
+	sceneUpdate.__set_AddedSceneObjects({ CreateBolt("boltA", 0), CreateBolt("boltB", 1) });
+	MBoolResponse response;
+	scene.Apply(response, sceneUpdate);
+	CHECK(response.Successful);
+
+	CHECK(scene.GetSharedMeshByID("boltA") == scene.GetSharedMeshByID("boltB"));
+	CHECK(scene.GetSharedColliderByID("boltA") == scene.GetSharedColliderByID("boltB"));
+
+	MMesh mesh;
+	scene.GetMeshByID(mesh, "boltB");
+	CHECK(mesh.ID == "boltB");
+	CHECK(mesh.Vertices.size() == 3);
+
+	MCollider collider;
+	scene.GetColliderById(collider, "boltA");
+	CHECK(collider.ID == "boltA");
+
+	MSceneObject sceneObject;
+	scene.GetSceneObjectByID(sceneObject, "boltB");
+	CHECK(sceneObject.__isset.Mesh && sceneObject.Mesh.ID == "boltB");
+	CHECK(sceneObject.__isset.Collider && sceneObject.Collider.ID == "boltB");
+
+	vector<MCollider> colliders;
+	scene.GetColliders(colliders);
+	CHECK(colliders.size() == 2 && colliders[0].ID != colliders[1].ID);
+}
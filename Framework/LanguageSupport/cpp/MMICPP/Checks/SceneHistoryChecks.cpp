@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "Checks.h"
+#include "Adapter/SceneHistory.h"
+#include "Adapter/SceneUpdateMerger.h"
+#include "Adapter/MMIScene.h"
+
+using namespace MMIStandard;
+
+namespace
+{
+	MSceneObject CreateSceneObject(const string &id, double x)
+	{
+		MSceneObject sceneObject;
+		sceneObject.__set_ID(id);
+		sceneObject.__set_Name(id);
+		sceneObject.Transform.__set_ID(id);
+		sceneObject.Transform.Position.__set_X(x);
+		sceneObject.Transform.Rotation.__set_W(1);
+		return sceneObject;
+	}
+
+	MSceneUpdate Added(const string &id, double x)
+	{
+		MSceneUpdate sceneUpdate;
+		sceneUpdate.__set_AddedSceneObjects({ CreateSceneObject(id, x) });
+		return sceneUpdate;
+	}
+
+	MSceneUpdate Moved(const string &id, double x)
+	{
+		MSceneObjectUpdate sceneObjectUpdate;
+		sceneObjectUpdate.__set_ID(id);
+		MTransformUpdate transformUpdate;
+		transformUpdate.__set_Position({ x, 0, 0 });
+		sceneObjectUpdate.__set_Transform(transformUpdate);
+
+		MSceneUpdate sceneUpdate;
+		sceneUpdate.__set_ChangedSceneObjects({ sceneObjectUpdate });
+		return sceneUpdate;
+	}
+
+	MSceneUpdate Removed(const string &id)
+	{
+		MSceneUpdate sceneUpdate;
+		sceneUpdate.__set_RemovedSceneObjects({ id });
+		return sceneUpdate;
+	}
+
+	//	Appends the updates to the history, returns them in the order of application
+	vector<shared_ptr<const MSceneUpdate>> Append(SceneHistory &history, int count)
+	{
+		vector<shared_ptr<const MSceneUpdate>> updates;
+		for (int i = 0; i < count; i++)
+		{
+			updates.emplace_back(make_shared<const MSceneUpdate>(Moved("table", i)));
+			history.Append(updates.back());
+		}
+		return updates;
+	}
+}
+
+//	An object which is added and removed again does not appear in the merged update
+MMICPP_CHECK(MergerCancelsAddAndRemove)
+{
+	SceneUpdateMerger merger;
+	merger.Append(Added("table", 0));
+	merger.Append(Moved("table", 1));
+	merger.Append(Removed("table"));
+	merger.Append(Added("chair", 2));
+
+	MSceneUpdate result;
+	CHECK(merger.GetResult(result));
+	CHECK(result.RemovedSceneObjects.empty());
+	CHECK(result.ChangedSceneObjects.empty());
+	CHECK(result.AddedSceneObjects.size() == 1 && result.AddedSceneObjects[0].ID == "chair");
+}
+
+//	The changes of an added object are folded into the added object
+MMICPP_CHECK(MergerFoldsChangesIntoAdd)
+{
+	SceneUpdateMerger merger;
+	merger.Append(Added("table", 0));
+	merger.Append(Moved("table", 1));
+	merger.Append(Moved("table", 2));
+
+	MSceneUpdate result;
+	CHECK(merger.GetResult(result));
+	CHECK(result.ChangedSceneObjects.empty());
+	CHECK(result.AddedSceneObjects.size() == 1 && result.AddedSceneObjects[0].Transform.Position.X == 2);
+}
+
+//	An object which is removed and added again can not be expressed by a single update
+MMICPP_CHECK(MergerRejectsRemoveAndReadd)
+{
+	SceneUpdateMerger merger;
+	merger.Append(Removed("table"));
+	merger.Append(Added("table", 1));
+
+	MSceneUpdate result;
+	CHECK(!merger.GetResult(result));
+}
+
+//	The scene falls back to the full scene if the changes can not be merged
+MMICPP_CHECK(SceneSendsFullSceneForUnmergeableChanges)
+{
+	MMIScene scene;
+	MBoolResponse response;
+	scene.Apply(response, Added("table", 0));
+	scene.Apply(response, Removed("table"));
+	scene.Apply(response, Added("table", 3));
+
+	MSceneUpdate changes;
+	int frameID = -1;
+	CHECK(!scene.GetSceneChangesSince(changes, 1, frameID));
+	CHECK(frameID == 3);
+	CHECK(changes.AddedSceneObjects.size() == 1 && changes.AddedSceneObjects[0].Transform.Position.X == 3);
+	CHECK(changes.RemovedSceneObjects.empty());
+}
+
+//	A frame which is not retained anymore falls back to the full scene
+MMICPP_CHECK(SceneSendsFullSceneForAgedOutFrame)
+{
+	MMIScene scene(2);
+	MBoolResponse response;
+	scene.Apply(response, Added("table", 0));
+	scene.Apply(response, Moved("table", 1));
+	scene.Apply(response, Added("chair", 2));
+	CHECK(scene.GetOldestFrameID() == 1);
+
+	MSceneUpdate changes;
+	int frameID = -1;
+	CHECK(scene.GetSceneChangesSince(changes, 1, frameID));
+	CHECK(frameID == 3);
+	CHECK(changes.ChangedSceneObjects.size() == 1 && changes.AddedSceneObjects.size() == 1);
+
+	changes = MSceneUpdate();
+	CHECK(!scene.GetSceneChangesSince(changes, 0, frameID));
+	CHECK(frameID == 3);
+	CHECK(changes.AddedSceneObjects.size() == 2);
+	CHECK(changes.ChangedSceneObjects.empty());
+}
+
+//	Without capacity only the frame id is counted, only the current frame can be requested
+MMICPP_CHECK(SceneHistoryWithoutCapacity)
+{
+	SceneHistory history(0);
+	Append(history, 3);
+	CHECK(history.NewestFrameID() == 3);
+	CHECK(history.OldestFrameID() == 3);
+	CHECK(history.Size() == 0);
+
+	vector<shared_ptr<const MSceneUpdate>> updates;
+	CHECK(history.GetUpdates(updates, 3, 3));
+	CHECK(updates.empty());
+	CHECK(!history.GetUpdates(updates, 2, 3));
+}
+
+//	The ring buffer evicts the oldest updates and returns the retained ones in the order of application
+MMICPP_CHECK(SceneHistoryWrapsAround)
+{
+	SceneHistory history(3);
+	vector<shared_ptr<const MSceneUpdate>> appended = Append(history, 5);
+	CHECK(history.NewestFrameID() == 5);
+	CHECK(history.OldestFrameID() == 2);
+	CHECK(history.Size() == 3);
+
+	vector<shared_ptr<const MSceneUpdate>> updates;
+	CHECK(!history.GetUpdates(updates, 1, 5));
+	CHECK(history.GetUpdates(updates, 2, 5));
+	CHECK(updates.size() == 3 && updates[0] == appended[2] && updates[1] == appended[3] && updates[2] == appended[4]);
+
+	// shrinking keeps the newest updates
+	history.SetCapacity(2);
+	CHECK(history.OldestFrameID() == 3);
+	updates.clear();
+	CHECK(history.GetUpdates(updates, 3, 5));
+	CHECK(updates.size() == 2 && updates[0] == appended[3] && updates[1] == appended[4]);
+}
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "Checks.h"
+#include "Adapter/MMIScene.h"
+
+using namespace MMIStandard;
+
+namespace
+{
+	//	A scene object whose transform has its own id, like the transforms of the Unity clients
+	MSceneObject CreateSceneObject(const string &id, const string &transformID, double x)
+	{
+		MSceneObject sceneObject;
+		sceneObject.__set_ID(id);
+		sceneObject.__set_Name(id);
+		sceneObject.Transform.__set_ID(transformID);
+		sceneObject.Transform.Position.__set_X(x);
+		sceneObject.Transform.Rotation.__set_W(1);
+		return sceneObject;
+	}
+}
+
+//	The transforms are returned with their own id, which may differ from the id of the scene object
+MMICPP_CHECK(SceneReturnsTransformIDs)
+{
+	MMIScene scene;
+	MSceneUpdate sceneUpdate;
+	sceneUpdate.__set_AddedSceneObjects({ CreateSceneObject("table", "tableTransform", 0), CreateSceneObject("chair", "chairTransform", 1) });
+	MBoolResponse response;
+	scene.Apply(response, sceneUpdate);
+	CHECK(response.Successful);
+
+	MTransform transform;
+	scene.GetTransformByID(transform, "chair");
+	CHECK(transform.ID == "chairTransform");
+	CHECK(transform.Position.X == 1);
+
+	vector<MTransform> transforms;
+	scene.GetTransforms(transforms);
+	CHECK(transforms.size() == 2);
+	for (const MTransform &stored : transforms)
+		CHECK(stored.ID == (stored.Position.X == 0 ? "tableTransform" : "chairTransform"));
+
+	MSceneObject sceneObject;
+	scene.GetSceneObjectByID(sceneObject, "table");
+	CHECK(sceneObject.Transform.ID == "tableTransform");
+}
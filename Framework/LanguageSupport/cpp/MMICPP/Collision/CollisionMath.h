@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "gen-cpp/math_types.h"
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+namespace MMIStandard {
+
+	struct Vector3d
+	{
+		/*
+			Plain vector which is used by the collision detection instead of MVector3 (no isset flags, no virtual functions)
+		*/
+		double x, y, z;
+
+		Vector3d() :x{ 0 }, y{ 0 }, z{ 0 } {}
+		Vector3d(double x, double y, double z) :x{ x }, y{ y }, z{ z } {}
+		explicit Vector3d(const MVector3 &vector) :x{ vector.X }, y{ vector.Y }, z{ vector.Z } {}
+
+		Vector3d operator+(const Vector3d &other) const { return Vector3d(x + other.x, y + other.y, z + other.z); }
+		Vector3d operator-(const Vector3d &other) const { return Vector3d(x - other.x, y - other.y, z - other.z); }
+		Vector3d operator-() const { return Vector3d(-x, -y, -z); }
+		Vector3d operator*(double scalar) const { return Vector3d(x * scalar, y * scalar, z * scalar); }
+		Vector3d &operator+=(const Vector3d &other) { x += other.x; y += other.y; z += other.z; return *this; }
+
+		double Dot(const Vector3d &other) const { return x * other.x + y * other.y + z * other.z; }
+		Vector3d Cross(const Vector3d &other) const { return Vector3d(y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x); }
+		double LengthSquared() const { return Dot(*this); }
+		double Length() const { return std::sqrt(LengthSquared()); }
+
+		//	Returns the vector with length 1, the zero vector is returned unchanged
+		Vector3d Normalized() const
+		{
+			double length = Length();
+			return length > 0 ? *this * (1.0 / length) : *this;
+		}
+
+		MVector3 ToMVector3() const
+		{
+			MVector3 result;
+			result.X = x;
+			result.Y = y;
+			result.Z = z;
+			return result;
+		}
+	};
+
+	struct Rotation3d
+	{
+		/*
+			Rotation as 3x3 matrix, the columns are the rotated unit axes
+			The matrix is computed once from the quaternion, so rotating the support directions only costs a few multiplications
+		*/
+		Vector3d axes[3];
+
+		Rotation3d() :axes{ Vector3d(1, 0, 0), Vector3d(0, 1, 0), Vector3d(0, 0, 1) } {}
+
+		explicit Rotation3d(const MQuaternion &rotation)
+		{
+			double x = rotation.X, y = rotation.Y, z = rotation.Z, w = rotation.W;
+			double length = x * x + y * y + z * z + w * w;
+			// not normalized quaternions are scaled, a zero quaternion (e.g. the default constructed one) is the identity
+			double s = length > 0 ? 2.0 / length : 0;
+			axes[0] = Vector3d(1 - s * (y * y + z * z), s * (x * y + w * z), s * (x * z - w * y));
+			axes[1] = Vector3d(s * (x * y - w * z), 1 - s * (x * x + z * z), s * (y * z + w * x));
+			axes[2] = Vector3d(s * (x * z + w * y), s * (y * z - w * x), 1 - s * (x * x + y * y));
+		}
+
+		//	Rotates a vector from the local into the parent space
+		Vector3d Rotate(const Vector3d &vector) const
+		{
+			return axes[0] * vector.x + axes[1] * vector.y + axes[2] * vector.z;
+		}
+
+		//	Rotates a vector from the parent into the local space
+		Vector3d InverseRotate(const Vector3d &vector) const
+		{
+			return Vector3d(axes[0].Dot(vector), axes[1].Dot(vector), axes[2].Dot(vector));
+		}
+
+		//	Returns the rotation which applies other first and this afterwards
+		Rotation3d operator*(const Rotation3d &other) const
+		{
+			Rotation3d result;
+			for (int i = 0; i < 3; i++)
+				result.axes[i] = Rotate(other.axes[i]);
+			return result;
+		}
+	};
+
+	struct Pose3d
+	{
+		/*
+			Position and rotation of a collision shape
+		*/
+		Vector3d position;
+		Rotation3d rotation;
+
+		Pose3d() {}
+		Pose3d(const Vector3d &position, const Rotation3d &rotation) :position{ position }, rotation{ rotation } {}
+		explicit Pose3d(const MTransform &transform) :position{ transform.Position }, rotation{ transform.Rotation } {}
+
+		//	Transforms a point from the local into the parent space
+		Vector3d Apply(const Vector3d &point) const { return position + rotation.Rotate(point); }
+
+		//	Returns the pose of a child which is given relative to this pose
+		Pose3d operator*(const Pose3d &child) const { return Pose3d(Apply(child.position), rotation * child.rotation); }
+	};
+
+	struct Bounds3d
+	{
+		/*
+			Axis aligned bounding box
+		*/
+		Vector3d min, max;
+
+		Bounds3d() :min{ HUGE_VAL, HUGE_VAL, HUGE_VAL }, max{ -HUGE_VAL, -HUGE_VAL, -HUGE_VAL } {}
+		Bounds3d(const Vector3d &min, const Vector3d &max) :min{ min }, max{ max } {}
+
+		//	Returns true if no point has been added
+		bool IsEmpty() const { return min.x > max.x; }
+
+		void Add(const Bounds3d &other)
+		{
+			min = Vector3d(std::min(min.x, other.min.x), std::min(min.y, other.min.y), std::min(min.z, other.min.z));
+			max = Vector3d(std::max(max.x, other.max.x), std::max(max.y, other.max.y), std::max(max.z, other.max.z));
+		}
+
+		bool Overlaps(const Bounds3d &other) const
+		{
+			return min.x <= other.max.x && other.min.x <= max.x
+				&& min.y <= other.max.y && other.min.y <= max.y
+				&& min.z <= other.max.z && other.min.z <= max.z;
+		}
+	};
+}
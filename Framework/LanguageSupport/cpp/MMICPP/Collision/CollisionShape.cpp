@@ -0,0 +1,282 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "CollisionShape.h"
+#include <mutex>
+
+using namespace MMIStandard;
+
+unordered_map<const MCollider *, CollisionShape::CacheEntry> CollisionShape::cache;
+shared_mutex CollisionShape::cacheLock;
+size_t CollisionShape::addedSincePurge = 0;
+
+namespace
+{
+	//	Returns the component of the radial part of the direction with the length of the radius, zero if the direction is parallel to the axis
+	Vector3d RadialSupport(const Vector3d &direction, const Vector3d &axis, double radius)
+	{
+		Vector3d radial = direction - axis * direction.Dot(axis);
+		double length = radial.Length();
+		return length > 0 ? radial * (radius / length) : Vector3d();
+	}
+}
+
+ConvexShape::ConvexShape() :type{ MColliderType::Custom }, radius{ 0 }, halfHeight{ 0 }, axis{ 0, 1, 0 }
+{
+}
+
+Vector3d ConvexShape::LocalSupport(const Vector3d & direction) const
+{
+	switch (this->type)
+	{
+	case MColliderType::Box:
+		return Vector3d(direction.x >= 0 ? this->halfExtents.x : -this->halfExtents.x,
+			direction.y >= 0 ? this->halfExtents.y : -this->halfExtents.y,
+			direction.z >= 0 ? this->halfExtents.z : -this->halfExtents.z);
+
+	case MColliderType::Sphere:
+		return direction.Normalized() * this->radius;
+
+	case MColliderType::Capsule:
+		return this->axis * (direction.Dot(this->axis) >= 0 ? this->halfHeight : -this->halfHeight) + direction.Normalized() * this->radius;
+
+	case MColliderType::Cylinder:
+		return this->axis * (direction.Dot(this->axis) >= 0 ? this->halfHeight : -this->halfHeight) + RadialSupport(direction, this->axis, this->radius);
+
+	case MColliderType::Cone:
+	{
+		Vector3d apex = this->axis * this->halfHeight;
+		Vector3d base = this->axis * -this->halfHeight + RadialSupport(direction, this->axis, this->radius);
+		return apex.Dot(direction) >= base.Dot(direction) ? apex : base;
+	}
+
+	case MColliderType::Mesh:
+	{
+		Vector3d best;
+		double bestDistance = -HUGE_VAL;
+		for (const Vector3d &vertex : *this->vertices)
+		{
+			double distance = vertex.Dot(direction);
+			if (distance > bestDistance)
+			{
+				bestDistance = distance;
+				best = vertex;
+			}
+		}
+		return best;
+	}
+
+	default:
+		return Vector3d();
+	}
+}
+
+Vector3d ConvexShape::Support(const Vector3d & direction) const
+{
+	return this->pose.Apply(this->LocalSupport(this->pose.rotation.InverseRotate(direction)));
+}
+
+ConvexShape ConvexShape::Place(const Pose3d & parent) const
+{
+	ConvexShape placed = *this;
+	placed.pose = parent * this->pose;
+
+	const Vector3d &center = placed.pose.position;
+	if (this->type == MColliderType::Sphere)
+	{
+		Vector3d extent(this->radius, this->radius, this->radius);
+		placed.bounds = Bounds3d(center - extent, center + extent);
+	}
+	else if (this->type == MColliderType::Box)
+	{
+		// the extent along each world axis is the sum of the projected half sizes
+		const Vector3d *axes = placed.pose.rotation.axes;
+		Vector3d extent;
+		extent.x = fabs(axes[0].x) * this->halfExtents.x + fabs(axes[1].x) * this->halfExtents.y + fabs(axes[2].x) * this->halfExtents.z;
+		extent.y = fabs(axes[0].y) * this->halfExtents.x + fabs(axes[1].y) * this->halfExtents.y + fabs(axes[2].y) * this->halfExtents.z;
+		extent.z = fabs(axes[0].z) * this->halfExtents.x + fabs(axes[1].z) * this->halfExtents.y + fabs(axes[2].z) * this->halfExtents.z;
+		placed.bounds = Bounds3d(center - extent, center + extent);
+	}
+	else
+	{
+		placed.bounds = Bounds3d(Vector3d(placed.Support(Vector3d(-1, 0, 0)).x, placed.Support(Vector3d(0, -1, 0)).y, placed.Support(Vector3d(0, 0, -1)).z),
+			Vector3d(placed.Support(Vector3d(1, 0, 0)).x, placed.Support(Vector3d(0, 1, 0)).y, placed.Support(Vector3d(0, 0, 1)).z));
+	}
+	return placed;
+}
+
+bool ConvexShape::IsRounded() const
+{
+	return this->type == MColliderType::Sphere || this->type == MColliderType::Capsule;
+}
+
+void ConvexShape::GetSegment(Vector3d & start, Vector3d & end) const
+{
+	if (this->type == MColliderType::Capsule)
+	{
+		Vector3d offset = this->pose.rotation.Rotate(this->axis * this->halfHeight);
+		start = this->pose.position - offset;
+		end = this->pose.position + offset;
+	}
+	else
+	{
+		start = this->pose.position;
+		end = this->pose.position;
+	}
+}
+
+CollisionShape::CollisionShape(const MCollider & collider)
+{
+	this->Compile(collider, Pose3d());
+}
+
+void CollisionShape::Compile(const MCollider & collider, const Pose3d & parent)
+{
+	Pose3d offset;
+	if (collider.__isset.PositionOffset)
+		offset.position = Vector3d(collider.PositionOffset);
+	if (collider.__isset.RotationOffset)
+		offset.rotation = Rotation3d(collider.RotationOffset);
+	Pose3d pose = parent * offset;
+
+	ConvexShape part;
+	part.type = collider.Type;
+	part.pose = pose;
+	bool valid = false;
+	switch (collider.Type)
+	{
+	case MColliderType::Box:
+		if (collider.__isset.BoxColliderProperties)
+		{
+			const MVector3 &size = collider.BoxColliderProperties.Size;
+			part.halfExtents = Vector3d(fabs(size.X) / 2, fabs(size.Y) / 2, fabs(size.Z) / 2);
+			valid = true;
+		}
+		break;
+
+	case MColliderType::Sphere:
+		if (collider.__isset.SphereColliderProperties)
+		{
+			part.radius = fabs(collider.SphereColliderProperties.Radius);
+			valid = true;
+		}
+		break;
+
+	case MColliderType::Capsule:
+		if (collider.__isset.CapsuleColliderProperties)
+		{
+			// the height includes both caps
+			const MCapsuleColliderProperties &properties = collider.CapsuleColliderProperties;
+			part.radius = fabs(properties.Radius);
+			part.halfHeight = max(fabs(properties.Height) / 2 - part.radius, 0.0);
+			if (properties.__isset.MainAxis && Vector3d(properties.MainAxis).LengthSquared() > 0)
+				part.axis = Vector3d(properties.MainAxis).Normalized();
+			valid = true;
+		}
+		break;
+
+	case MColliderType::Cylinder:
+		if (collider.__isset.CylinderColliderProperties)
+		{
+			part.radius = fabs(collider.CylinderColliderProperties.Radius);
+			part.halfHeight = fabs(collider.CylinderColliderProperties.Height) / 2;
+			valid = true;
+		}
+		break;
+
+	case MColliderType::Cone:
+		if (collider.__isset.ConeColliderProperties)
+		{
+			part.radius = fabs(collider.ConeColliderProperties.Radius);
+			part.halfHeight = fabs(collider.ConeColliderProperties.Height) / 2;
+			valid = true;
+		}
+		break;
+
+	case MColliderType::Mesh:
+		if (collider.__isset.MeshColliderProperties && !collider.MeshColliderProperties.Vertices.empty())
+		{
+			auto vertices = make_shared<vector<Vector3d>>();
+			vertices->reserve(collider.MeshColliderProperties.Vertices.size());
+			for (const MVector3 &vertex : collider.MeshColliderProperties.Vertices)
+				vertices->emplace_back(vertex);
+			part.vertices = move(vertices);
+			valid = true;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	if (valid)
+		this->parts.push_back(move(part));
+
+	if (collider.__isset.Colliders)
+	{
+		for (const MCollider &child : collider.Colliders)
+			this->Compile(child, pose);
+	}
+}
+
+const vector<ConvexShape>& CollisionShape::Parts() const
+{
+	return this->parts;
+}
+
+bool CollisionShape::IsEmpty() const
+{
+	return this->parts.empty();
+}
+
+Bounds3d CollisionShape::Place(vector<ConvexShape>& _return, const Pose3d & pose) const
+{
+	Bounds3d bounds;
+	for (const ConvexShape &part : this->parts)
+	{
+		_return.push_back(part.Place(pose));
+		bounds.Add(_return.back().bounds);
+	}
+	return bounds;
+}
+
+shared_ptr<const CollisionShape> CollisionShape::Get(const shared_ptr<const MCollider>& collider)
+{
+	if (collider == nullptr)
+		return nullptr;
+
+	{
+		shared_lock<shared_mutex> guard(cacheLock);
+		auto iter = cache.find(collider.get());
+		// the owner comparison does not touch the reference counts, a reused address belongs to another owner
+		if (iter != cache.end() && !iter->second.collider.owner_before(collider) && !collider.owner_before(iter->second.collider))
+			return iter->second.shape;
+	}
+
+	// compiled outside of the lock, concurrent callers may compile the same collider, the last one is kept
+	auto shape = make_shared<const CollisionShape>(*collider);
+
+	unique_lock<shared_mutex> guard(cacheLock);
+	cache[collider.get()] = CacheEntry{ collider, shape };
+
+	// the released colliders are removed once the cache has grown by half, so the costs are amortized over the added shapes
+	if (++addedSincePurge >= max<size_t>(cache.size() / 2, 64))
+	{
+		for (auto iter = cache.begin(); iter != cache.end();)
+		{
+			if (iter->second.collider.expired())
+				iter = cache.erase(iter);
+			else
+				++iter;
+		}
+		addedSincePurge = 0;
+	}
+	return shape;
+}
+
+size_t CollisionShape::CacheSize()
+{
+	shared_lock<shared_mutex> guard(cacheLock);
+	return cache.size();
+}
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "gen-cpp/scene_types.h"
+#include "CollisionMath.h"
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <shared_mutex>
+
+using namespace MMIStandard;
+using namespace std;
+
+namespace MMIStandard {
+
+	struct ConvexShape
+	{
+		/*
+			A single convex primitive of a collider, described by its support function (see GjkEpa).
+			Meshes are treated as the convex hull of their vertices.
+		*/
+
+		//	The primitive, Box, Sphere, Capsule, Cone, Cylinder or Mesh
+		MColliderType::type type;
+
+		//	The pose of the primitive, relative to the owner of the collider or in world space once the shape is placed
+		Pose3d pose;
+
+		//	The half size of a box
+		Vector3d halfExtents;
+
+		//	The radius of a sphere, capsule, cylinder or cone
+		double radius;
+
+		//	The half length of the segment of a capsule (without the caps), the half height of a cylinder or cone
+		double halfHeight;
+
+		//	The local axis of a capsule, cylinder or cone, the apex of a cone points along the axis
+		Vector3d axis;
+
+		//	The vertices of a mesh in the local space, shared by all placed instances
+		shared_ptr<const vector<Vector3d>> vertices;
+
+		//	The bounding box of the placed primitive, is computed by Place
+		Bounds3d bounds;
+
+		ConvexShape();
+
+		//	Returns the point of the primitive which is farthest in the direction, both in the space of the pose
+		Vector3d Support(const Vector3d &direction) const;
+
+		//	Returns the same primitive at the pose relative to the given one and computes its bounds
+		ConvexShape Place(const Pose3d &parent) const;
+
+		//	Returns true for the primitives which are a segment with a radius (sphere and capsule), they are tested analytically
+		bool IsRounded() const;
+
+		//	Returns the end points of the segment of a sphere or capsule in the space of the pose
+		void GetSegment(Vector3d &start, Vector3d &end) const;
+
+	private:
+		//	Returns the farthest point in the local space of the primitive
+		Vector3d LocalSupport(const Vector3d &direction) const;
+	};
+
+	class CollisionShape
+	{
+		/*
+			The convex primitives of an MCollider, compiled once and reused for every test.
+			The offsets and child colliders are resolved, the primitives are relative to the transform of the owner of the collider.
+			Colliders of the type Custom, colliders without their properties and mesh colliders without vertices only contribute their children.
+		*/
+	private:
+		//	The primitives relative to the owner of the collider
+		vector<ConvexShape> parts;
+
+		//	Compiled shapes of the shared colliders of the scene (see GeometryStore), structured by the address of the collider
+		//	The weak reference detects a collider which has been released and whose address has been reused
+		struct CacheEntry
+		{
+			weak_ptr<const MCollider> collider;
+			shared_ptr<const CollisionShape> shape;
+		};
+		static unordered_map<const MCollider *, CacheEntry> cache;
+		static shared_mutex cacheLock;
+
+		//	The number of compiled shapes since the released colliders were removed from the cache
+		static size_t addedSincePurge;
+
+	private:
+		//	Adds the primitives of the collider and its children
+		void Compile(const MCollider &collider, const Pose3d &parent);
+
+	public:
+		//	Compiles the collider
+		explicit CollisionShape(const MCollider &collider);
+
+		//	Returns the primitives relative to the owner of the collider
+		const vector<ConvexShape> &Parts() const;
+
+		//	Returns true if the collider does not contain any primitive
+		bool IsEmpty() const;
+
+		//	Appends the primitives placed at the transform of the owner
+		//	<param name="_return">The placed primitives, the shape is appended</param>
+		//	<param name="pose">The transform of the owner</param>
+		//	Returns the bounds of the appended primitives
+		Bounds3d Place(vector<ConvexShape> &_return, const Pose3d &pose) const;
+
+		//	Returns the compiled shape of a shared collider, the shape is compiled once per collider instance
+		//	Is used for the colliders of the scene, which are shared immutable instances
+		static shared_ptr<const CollisionShape> Get(const shared_ptr<const MCollider> &collider);
+
+		//	Returns the number of compiled shapes in the cache
+		static size_t CacheSize();
+	};
+}
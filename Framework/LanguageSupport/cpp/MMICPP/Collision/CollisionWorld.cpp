@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "CollisionWorld.h"
+#include <algorithm>
+
+using namespace MMIStandard;
+
+//	colliders which are longer along x than this factor times the median extent are not sorted
+static const double longExtentFactor = 8.0;
+
+CollisionWorld::CollisionWorld() :sortedCount{ 0 }, maxExtent{ 0 }, frameID{ -1 }
+{
+}
+
+bool CollisionWorld::Update(const MMIScene & scene)
+{
+	if (scene.GetVisibleFrameID() == this->frameID)
+		return false;
+
+	this->Build(scene);
+	return true;
+}
+
+void CollisionWorld::Build(const MMIScene & scene)
+{
+	this->entries.clear();
+	this->parts.clear();
+	this->indices.clear();
+
+	// the frame is read from the same instance as the scene objects, so the world is never labeled with a newer frame
+	scene.VisitSceneObjects([this](const SceneObjectEntry &sceneObject)
+	{
+		shared_ptr<const CollisionShape> shape = CollisionShape::Get(sceneObject.collider);
+		if (shape == nullptr || shape->IsEmpty())
+			return;
+
+		Entry entry;
+		entry.sceneObjectID = sceneObject.sceneObject.ID;
+		entry.firstPart = this->parts.size();
+		entry.bounds = shape->Place(this->parts, Pose3d(sceneObject.sceneObject.Transform));
+		entry.partCount = this->parts.size() - entry.firstPart;
+		entry.shape = move(shape);
+		this->entries.push_back(move(entry));
+	}, this->frameID);
+
+	// the long colliders are moved behind the sorted ones
+	this->sortedCount = this->entries.size();
+	this->maxExtent = 0;
+	if (this->entries.empty())
+		return;
+
+	vector<double> extents;
+	extents.reserve(this->entries.size());
+	for (const Entry &entry : this->entries)
+		extents.push_back(entry.bounds.max.x - entry.bounds.min.x);
+	nth_element(extents.begin(), extents.begin() + extents.size() / 2, extents.end());
+	double longExtent = extents[extents.size() / 2] * longExtentFactor;
+
+	auto longBegin = stable_partition(this->entries.begin(), this->entries.end(), [longExtent](const Entry &entry)
+	{
+		return entry.bounds.max.x - entry.bounds.min.x <= longExtent;
+	});
+	this->sortedCount = static_cast<size_t>(longBegin - this->entries.begin());
+
+	sort(this->entries.begin(), longBegin, [](const Entry &a, const Entry &b)
+	{
+		return a.bounds.min.x < b.bounds.min.x;
+	});
+	for (auto iter = this->entries.begin(); iter != longBegin; ++iter)
+		this->maxExtent = max(this->maxExtent, iter->bounds.max.x - iter->bounds.min.x);
+
+	// the entries are not moved anymore, so the index can reference their ids
+	this->indices.reserve(this->entries.size());
+	for (size_t i = 0; i < this->entries.size(); i++)
+		this->indices.emplace(this->entries[i].sceneObjectID, i);
+}
+
+int CollisionWorld::GetFrameID() const
+{
+	return this->frameID;
+}
+
+size_t CollisionWorld::Size() const
+{
+	return this->entries.size();
+}
+
+const CollisionWorld::Entry & CollisionWorld::GetEntry(size_t index) const
+{
+	return this->entries[index];
+}
+
+const ConvexShape * CollisionWorld::PartsBegin(size_t index) const
+{
+	return this->parts.data() + this->entries[index].firstPart;
+}
+
+const ConvexShape * CollisionWorld::PartsEnd(size_t index) const
+{
+	const Entry &entry = this->entries[index];
+	return this->parts.data() + entry.firstPart + entry.partCount;
+}
+
+void CollisionWorld::QueryBounds(const Bounds3d & bounds, const function<void(size_t)>& visitor) const
+{
+	if (bounds.IsEmpty())
+		return;
+
+	// a sorted collider can only overlap if its lower bound is within the largest extent in front of the query
+	auto sortedEnd = this->entries.begin() + this->sortedCount;
+	auto iter = lower_bound(this->entries.begin(), sortedEnd, bounds.min.x - this->maxExtent, [](const Entry &entry, double value)
+	{
+		return entry.bounds.min.x < value;
+	});
+	for (; iter != sortedEnd && iter->bounds.min.x <= bounds.max.x; ++iter)
+	{
+		if (iter->bounds.Overlaps(bounds))
+			visitor(static_cast<size_t>(iter - this->entries.begin()));
+	}
+
+	for (size_t i = this->sortedCount; i < this->entries.size(); i++)
+	{
+		if (this->entries[i].bounds.Overlaps(bounds))
+			visitor(i);
+	}
+}
+
+void CollisionWorld::VisitOverlappingPairs(const function<void(size_t, size_t)>& visitor) const
+{
+	// sweep along x, every collider is compared with the following ones which start within its extent
+	for (size_t i = 0; i < this->sortedCount; i++)
+	{
+		const Bounds3d &bounds = this->entries[i].bounds;
+		for (size_t j = i + 1; j < this->sortedCount && this->entries[j].bounds.min.x <= bounds.max.x; j++)
+		{
+			if (bounds.Overlaps(this->entries[j].bounds))
+				visitor(i, j);
+		}
+	}
+
+	// the long colliders are compared with all colliders in front of them
+	for (size_t i = this->sortedCount; i < this->entries.size(); i++)
+	{
+		const Bounds3d &bounds = this->entries[i].bounds;
+		for (size_t j = 0; j < i; j++)
+		{
+			if (bounds.Overlaps(this->entries[j].bounds))
+				visitor(j, i);
+		}
+	}
+}
+
+bool CollisionWorld::Intersect(size_t indexA, size_t indexB) const
+{
+	if (!this->entries[indexA].bounds.Overlaps(this->entries[indexB].bounds))
+		return false;
+	return GjkEpa::Intersect(this->PartsBegin(indexA), this->PartsEnd(indexA), this->PartsBegin(indexB), this->PartsEnd(indexB));
+}
+
+bool CollisionWorld::Penetration(Vector3d & _return, size_t indexA, size_t indexB) const
+{
+	_return = Vector3d();
+	if (!this->entries[indexA].bounds.Overlaps(this->entries[indexB].bounds))
+		return false;
+	return GjkEpa::Penetration(_return, this->PartsBegin(indexA), this->PartsEnd(indexA), this->PartsBegin(indexB), this->PartsEnd(indexB));
+}
+
+bool CollisionWorld::Find(size_t & _return, const string & sceneObjectID) const
+{
+	auto iter = this->indices.find(sceneObjectID);
+	if (iter == this->indices.end())
+		return false;
+
+	_return = iter->second;
+	return true;
+}
+
+void CollisionWorld::AddContact(vector<Contact>& _return, size_t indexA, size_t indexB, bool computePenetration) const
+{
+	Vector3d penetration;
+	bool intersecting = computePenetration ? this->Penetration(penetration, indexA, indexB) : this->Intersect(indexA, indexB);
+	if (intersecting)
+		_return.push_back(Contact{ this->entries[indexA].sceneObjectID, this->entries[indexB].sceneObjectID, penetration });
+}
+
+void CollisionWorld::QueryCollider(vector<Contact>& _return, const CollisionShape & shape, const Pose3d & pose, const string & id, bool computePenetration) const
+{
+	// the placed primitives are reused by the queries of a thread
+	thread_local vector<ConvexShape> placed;
+	placed.clear();
+	Bounds3d bounds = shape.Place(placed, pose);
+	const ConvexShape *begin = placed.data();
+	const ConvexShape *end = placed.data() + placed.size();
+
+	this->QueryBounds(bounds, [&](size_t index)
+	{
+		const Entry &entry = this->entries[index];
+		if (entry.sceneObjectID == id)
+			return;
+
+		Vector3d penetration;
+		bool intersecting = computePenetration
+			? GjkEpa::Penetration(penetration, begin, end, this->PartsBegin(index), this->PartsEnd(index))
+			: GjkEpa::Intersect(begin, end, this->PartsBegin(index), this->PartsEnd(index));
+		if (intersecting)
+			_return.push_back(Contact{ id, entry.sceneObjectID, penetration });
+	});
+}
+
+bool CollisionWorld::QuerySceneObject(vector<Contact>& _return, const string & sceneObjectID, bool computePenetration) const
+{
+	size_t index;
+	if (!this->Find(index, sceneObjectID))
+		return false;
+
+	this->QueryBounds(this->entries[index].bounds, [&](size_t other)
+	{
+		if (other != index)
+			this->AddContact(_return, index, other, computePenetration);
+	});
+	return true;
+}
+
+void CollisionWorld::QueryRegion(vector<Contact>& _return, const Bounds3d & region, bool computePenetration) const
+{
+	vector<size_t> candidates;
+	this->QueryBounds(region, [&candidates](size_t index)
+	{
+		candidates.push_back(index);
+	});
+
+	// sweep along x over the candidates, the long colliders are visited after the sorted ones and have to be sorted in
+	sort(candidates.begin(), candidates.end(), [this](size_t a, size_t b)
+	{
+		return this->entries[a].bounds.min.x < this->entries[b].bounds.min.x;
+	});
+	for (size_t i = 0; i < candidates.size(); i++)
+	{
+		const Bounds3d &bounds = this->entries[candidates[i]].bounds;
+		for (size_t j = i + 1; j < candidates.size() && this->entries[candidates[j]].bounds.min.x <= bounds.max.x; j++)
+		{
+			if (bounds.Overlaps(this->entries[candidates[j]].bounds))
+				this->AddContact(_return, candidates[i], candidates[j], computePenetration);
+		}
+	}
+}
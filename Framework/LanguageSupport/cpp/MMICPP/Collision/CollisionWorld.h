@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "CollisionShape.h"
+#include "GjkEpa.h"
+#include "Adapter/MMIScene.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+using namespace MMIStandard;
+using namespace std;
+
+namespace MMIStandard {
+	class CollisionWorld
+	{
+		/*
+			Broad phase over the colliders of the scene objects of an MMIScene.
+			The colliders are placed at the transforms of their scene objects and sorted by the lower bound of their extent along x (sort and sweep),
+			a query only visits the colliders whose extent along x can overlap the query, the remaining axes are compared on the bounds.
+			Colliders which are much longer along x than the others (e.g. a floor) are kept aside and are compared with every query.
+			The world is a snapshot of one frame of the scene and is rebuilt by Update once the frame has changed.
+			Queries can be made concurrently, but not during Update.
+		*/
+	public:
+		struct Entry
+		{
+			//	The id of the scene object
+			string sceneObjectID;
+
+			//	The compiled collider, is shared with all scene objects using the same collider
+			shared_ptr<const CollisionShape> shape;
+
+			//	The bounds of the placed collider
+			Bounds3d bounds;
+
+			//	The placed primitives of the collider in the primitives of the world
+			size_t firstPart, partCount;
+		};
+
+		struct Contact
+		{
+			//	The ids of the colliding scene objects, sceneObjectA is the id given to QueryCollider for a collider which is not part of the world
+			string sceneObjectA, sceneObjectB;
+
+			//	The shortest translation of the first collider which separates the colliders, zero if the penetration has not been requested
+			Vector3d penetration;
+		};
+
+	private:
+		//	The colliders sorted by bounds.min.x, followed by the long colliders
+		vector<Entry> entries;
+
+		//	The number of entries which are sorted, the long colliders start behind them
+		size_t sortedCount;
+
+		//	The placed primitives of all colliders
+		vector<ConvexShape> parts;
+
+		//	The largest extent along x of the sorted entries, limits the range which is searched by a query
+		double maxExtent;
+
+		//	The index of the entry of each scene object, the keys reference the ids of the entries
+		unordered_map<string_view, size_t> indices;
+
+		//	The frame of the scene the world was built from, -1 if it has not been built yet
+		int frameID;
+
+		//	Tests the colliders at the indices and appends a contact if they intersect
+		void AddContact(vector<Contact> &_return, size_t indexA, size_t indexB, bool computePenetration) const;
+
+	public:
+		//	Basic constructor, the world is empty until Update is called
+		CollisionWorld();
+
+		//	Rebuilds the world if the frame of the scene has changed
+		//	Returns true if the world was rebuilt
+		bool Update(const MMIScene &scene);
+
+		//	Rebuilds the world from the colliders of the scene
+		void Build(const MMIScene &scene);
+
+		//	Returns the frame of the scene the world was built from
+		int GetFrameID() const;
+
+		//	Returns the number of colliders
+		size_t Size() const;
+
+		//	Returns the collider at the index, the indices are only valid until the next update
+		const Entry &GetEntry(size_t index) const;
+
+		//	Returns the placed primitives of the collider at the index
+		const ConvexShape *PartsBegin(size_t index) const;
+		const ConvexShape *PartsEnd(size_t index) const;
+
+		//	Calls the visitor with the index of every collider whose bounds overlap the given bounds
+		void QueryBounds(const Bounds3d &bounds, const function<void(size_t)> &visitor) const;
+
+		//	Calls the visitor once for every pair of colliders whose bounds overlap
+		void VisitOverlappingPairs(const function<void(size_t, size_t)> &visitor) const;
+
+		//	Returns true if the colliders at the indices intersect
+		bool Intersect(size_t indexA, size_t indexB) const;
+
+		//	Returns true if the colliders at the indices intersect
+		//	<param name="_return">The deepest penetration, as translation of the collider at indexA</param>
+		bool Penetration(Vector3d &_return, size_t indexA, size_t indexB) const;
+
+		//	Returns the index of the collider of the scene object, false if the scene object is unknown or has no collider
+		bool Find(size_t &_return, const string &sceneObjectID) const;
+
+		//	Tests a collider against all colliders of the world and appends the contacts
+		//	<param name="shape">The collider, e.g. compiled by CollisionShape::Get</param>
+		//	<param name="pose">The transform of the owner of the collider</param>
+		//	<param name="id">The id which is written to the contacts, a collider of the world with the same id is skipped (e.g. the scene object itself at its stored transform)</param>
+		//	<param name="computePenetration">Whether the penetration of each contact is computed (EPA), otherwise only the intersection is tested</param>
+		void QueryCollider(vector<Contact> &_return, const CollisionShape &shape, const Pose3d &pose, const string &id, bool computePenetration) const;
+
+		//	Tests the stored collider of the scene object against all other colliders of the world and appends the contacts
+		//	Returns false if the scene object is unknown or has no collider
+		bool QuerySceneObject(vector<Contact> &_return, const string &sceneObjectID, bool computePenetration) const;
+
+		//	Tests all pairs of colliders whose bounds overlap the region and appends the contacts
+		void QueryRegion(vector<Contact> &_return, const Bounds3d &region, bool computePenetration) const;
+	};
+}
@@ -0,0 +1,484 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "GjkEpa.h"
+#include <vector>
+
+using namespace MMIStandard;
+
+//	squared lengths below are regarded as zero
+static const double epsilon = 1e-20;
+
+namespace
+{
+	//	The simplex of GJK, the newest point is at index 0
+	struct Simplex
+	{
+		Vector3d points[4];
+		int count = 0;
+
+		void Push(const Vector3d &point)
+		{
+			for (int i = min(this->count, 3); i > 0; i--)
+				this->points[i] = this->points[i - 1];
+			this->points[0] = point;
+			this->count = min(this->count + 1, 4);
+		}
+
+		void Set(const Vector3d &a, const Vector3d &b)
+		{
+			this->points[0] = a;
+			this->points[1] = b;
+			this->count = 2;
+		}
+
+		void Set(const Vector3d &a, const Vector3d &b, const Vector3d &c)
+		{
+			this->points[0] = a;
+			this->points[1] = b;
+			this->points[2] = c;
+			this->count = 3;
+		}
+	};
+
+	//	Support function of the Minkowski difference a - b
+	Vector3d Support(const ConvexShape &a, const ConvexShape &b, const Vector3d &direction)
+	{
+		return a.Support(direction) - b.Support(-direction);
+	}
+
+	Vector3d TripleCross(const Vector3d &a, const Vector3d &b, const Vector3d &c)
+	{
+		return a.Cross(b).Cross(c);
+	}
+
+	//	The simplex cases reduce the simplex to the feature which is closest to the origin and return the next search direction
+	//	They return true if the origin is contained in the simplex
+	bool Line(Simplex &simplex, Vector3d &direction)
+	{
+		Vector3d a = simplex.points[0], b = simplex.points[1];
+		Vector3d ab = b - a, ao = -a;
+		if (ab.Dot(ao) > 0)
+			direction = TripleCross(ab, ao, ab);
+		else
+		{
+			simplex.count = 1;
+			direction = ao;
+		}
+		return direction.LengthSquared() < epsilon;
+	}
+
+	bool Triangle(Simplex &simplex, Vector3d &direction)
+	{
+		Vector3d a = simplex.points[0], b = simplex.points[1], c = simplex.points[2];
+		Vector3d ab = b - a, ac = c - a, ao = -a;
+		Vector3d abc = ab.Cross(ac);
+
+		if (abc.Cross(ac).Dot(ao) > 0)
+		{
+			if (ac.Dot(ao) > 0)
+			{
+				simplex.Set(a, c);
+				direction = TripleCross(ac, ao, ac);
+				return direction.LengthSquared() < epsilon;
+			}
+			simplex.Set(a, b);
+			return Line(simplex, direction);
+		}
+
+		if (ab.Cross(abc).Dot(ao) > 0)
+		{
+			simplex.Set(a, b);
+			return Line(simplex, direction);
+		}
+
+		// the origin is above or below the triangle, the winding is kept so that the normal points to the origin
+		double side = abc.Dot(ao);
+		if (side > 0)
+			direction = abc;
+		else
+		{
+			simplex.Set(a, c, b);
+			direction = -abc;
+		}
+		return side == 0;
+	}
+
+	bool Tetrahedron(Simplex &simplex, Vector3d &direction)
+	{
+		Vector3d a = simplex.points[0], b = simplex.points[1], c = simplex.points[2], d = simplex.points[3];
+		Vector3d ab = b - a, ac = c - a, ad = d - a, ao = -a;
+
+		// the face bcd has already been tested by the previous triangle, the remaining faces point away from d, c and b
+		if (ab.Cross(ac).Dot(ao) > 0)
+		{
+			simplex.Set(a, b, c);
+			return Triangle(simplex, direction);
+		}
+		if (ac.Cross(ad).Dot(ao) > 0)
+		{
+			simplex.Set(a, c, d);
+			return Triangle(simplex, direction);
+		}
+		if (ad.Cross(ab).Dot(ao) > 0)
+		{
+			simplex.Set(a, d, b);
+			return Triangle(simplex, direction);
+		}
+		return true;
+	}
+
+	bool DoSimplex(Simplex &simplex, Vector3d &direction)
+	{
+		switch (simplex.count)
+		{
+		case 2: return Line(simplex, direction);
+		case 3: return Triangle(simplex, direction);
+		default: return Tetrahedron(simplex, direction);
+		}
+	}
+
+	//	Returns true if the Minkowski difference contains the origin, the final simplex is kept for EPA
+	bool Gjk(Simplex &simplex, const ConvexShape &a, const ConvexShape &b)
+	{
+		Vector3d direction = a.pose.position - b.pose.position;
+		if (direction.LengthSquared() < epsilon)
+			direction = Vector3d(1, 0, 0);
+
+		simplex.count = 0;
+		simplex.Push(Support(a, b, direction));
+		direction = -simplex.points[0];
+
+		for (int i = 0; i < GjkEpa::MaxIterations; i++)
+		{
+			// the origin is located on the simplex
+			if (direction.LengthSquared() < epsilon)
+				return true;
+
+			Vector3d point = Support(a, b, direction);
+			if (point.Dot(direction) <= 0)
+				return false;
+
+			simplex.Push(point);
+			if (DoSimplex(simplex, direction))
+				return true;
+		}
+		return false;
+	}
+
+	//	Returns the closest points of two segments
+	void ClosestPoints(Vector3d &closestA, Vector3d &closestB, const Vector3d &startA, const Vector3d &endA, const Vector3d &startB, const Vector3d &endB)
+	{
+		Vector3d d1 = endA - startA, d2 = endB - startB, r = startA - startB;
+		double a = d1.LengthSquared(), e = d2.LengthSquared(), f = d2.Dot(r);
+		double s = 0, t = 0;
+		if (a <= epsilon && e <= epsilon)
+		{
+		}
+		else if (a <= epsilon)
+			t = clamp(f / e, 0.0, 1.0);
+		else
+		{
+			double c = d1.Dot(r);
+			if (e <= epsilon)
+				s = clamp(-c / a, 0.0, 1.0);
+			else
+			{
+				double b = d1.Dot(d2);
+				double denominator = a * e - b * b;
+				s = denominator > 0 ? clamp((b * f - c * e) / denominator, 0.0, 1.0) : 0;
+				t = (b * s + f) / e;
+				if (t < 0)
+				{
+					t = 0;
+					s = clamp(-c / a, 0.0, 1.0);
+				}
+				else if (t > 1)
+				{
+					t = 1;
+					s = clamp((b - c) / a, 0.0, 1.0);
+				}
+			}
+		}
+		closestA = startA + d1 * s;
+		closestB = startB + d2 * t;
+	}
+
+	//	Tests spheres and capsules by the distance of their segments
+	bool RoundedPenetration(Vector3d &_return, const ConvexShape &a, const ConvexShape &b)
+	{
+		Vector3d startA, endA, startB, endB, closestA, closestB;
+		a.GetSegment(startA, endA);
+		b.GetSegment(startB, endB);
+		ClosestPoints(closestA, closestB, startA, endA, startB, endB);
+
+		Vector3d delta = closestA - closestB;
+		double distance = delta.Length();
+		double depth = a.radius + b.radius - distance;
+		if (depth <= 0)
+		{
+			_return = Vector3d();
+			return false;
+		}
+
+		if (distance * distance > epsilon)
+		{
+			_return = delta * (depth / distance);
+			return true;
+		}
+
+		// the segments intersect, they are separated perpendicular to both segments
+		Vector3d axisA = endA - startA, axisB = endB - startB;
+		Vector3d normal = axisA.Cross(axisB);
+		if (normal.LengthSquared() < epsilon)
+		{
+			// parallel segments or spheres, the direction between the centers without the part along the segments is used
+			Vector3d axis = axisA.LengthSquared() > epsilon ? axisA.Normalized() : axisB.Normalized();
+			normal = a.pose.position - b.pose.position;
+			normal = normal - axis * normal.Dot(axis);
+			if (normal.LengthSquared() < epsilon)
+				normal = axis.LengthSquared() > 0 ? axis.Cross(fabs(axis.x) < 0.9 ? Vector3d(1, 0, 0) : Vector3d(0, 1, 0)) : Vector3d(0, 1, 0);
+		}
+		normal = normal.Normalized();
+		if (normal.Dot(a.pose.position - b.pose.position) < 0)
+			normal = -normal;
+		_return = normal * depth;
+		return true;
+	}
+
+	//	Extends a degenerated simplex of GJK (the origin is located on a point, segment or triangle) to a tetrahedron
+	//	Returns false if the Minkowski difference is flat
+	bool CompleteSimplex(Simplex &simplex, const ConvexShape &a, const ConvexShape &b)
+	{
+		static const Vector3d axes[3] = { Vector3d(1, 0, 0), Vector3d(0, 1, 0), Vector3d(0, 0, 1) };
+
+		while (simplex.count < 4)
+		{
+			const Vector3d *points = simplex.points;
+			Vector3d candidates[8];
+			int candidateCount = 0;
+			if (simplex.count == 3)
+			{
+				Vector3d normal = (points[1] - points[0]).Cross(points[2] - points[0]);
+				candidates[candidateCount++] = normal;
+				candidates[candidateCount++] = -normal;
+			}
+			else if (simplex.count == 2)
+			{
+				// the directions perpendicular to the segment
+				Vector3d line = points[1] - points[0];
+				for (const Vector3d &axis : axes)
+				{
+					candidates[candidateCount++] = line.Cross(axis);
+					candidates[candidateCount++] = -line.Cross(axis);
+				}
+			}
+			else
+			{
+				for (const Vector3d &axis : axes)
+				{
+					candidates[candidateCount++] = axis;
+					candidates[candidateCount++] = -axis;
+				}
+			}
+
+			bool extended = false;
+			for (int i = 0; i < candidateCount && !extended; i++)
+			{
+				if (candidates[i].LengthSquared() < epsilon)
+					continue;
+
+				Vector3d point = Support(a, b, candidates[i]);
+				double extent;
+				if (simplex.count == 1)
+					extent = (point - points[0]).LengthSquared();
+				else if (simplex.count == 2)
+					extent = (point - points[0]).Cross(points[1] - points[0]).LengthSquared();
+				else
+				{
+					double volume = (points[1] - points[0]).Cross(points[2] - points[0]).Dot(point - points[0]);
+					extent = volume * volume;
+				}
+
+				if (extent > epsilon)
+				{
+					simplex.points[simplex.count++] = point;
+					extended = true;
+				}
+			}
+			if (!extended)
+				return false;
+		}
+		return true;
+	}
+
+	struct Face
+	{
+		int a, b, c;
+		Vector3d normal;
+		double distance;
+	};
+
+	//	The polytope of EPA, the buffers are reused by the calls of a thread
+	struct Polytope
+	{
+		vector<Vector3d> vertices;
+		vector<Face> faces;
+		vector<pair<int, int>> edges;
+		Vector3d interior;
+
+		//	Adds the face with the normal pointing away from the interior point
+		void AddFace(int a, int b, int c)
+		{
+			Vector3d normal = (this->vertices[b] - this->vertices[a]).Cross(this->vertices[c] - this->vertices[a]).Normalized();
+			if (normal.Dot(this->vertices[a] - this->interior) < 0)
+			{
+				swap(b, c);
+				normal = -normal;
+			}
+			this->faces.push_back(Face{ a, b, c, normal, normal.Dot(this->vertices[a]) });
+		}
+
+		//	Adds the edge of a removed face, an edge which is shared with another removed face is not part of the horizon
+		void AddEdge(int a, int b)
+		{
+			for (auto iter = this->edges.begin(); iter != this->edges.end(); ++iter)
+			{
+				if (iter->first == b && iter->second == a)
+				{
+					*iter = this->edges.back();
+					this->edges.pop_back();
+					return;
+				}
+			}
+			this->edges.emplace_back(a, b);
+		}
+	};
+
+	//	Returns the normal and distance of the face of the Minkowski difference which is closest to the origin
+	void Epa(Vector3d &_return, const Simplex &simplex, const ConvexShape &a, const ConvexShape &b)
+	{
+		thread_local Polytope polytope;
+		polytope.vertices.assign(simplex.points, simplex.points + 4);
+		polytope.faces.clear();
+		polytope.interior = (simplex.points[0] + simplex.points[1] + simplex.points[2] + simplex.points[3]) * 0.25;
+		polytope.AddFace(0, 1, 2);
+		polytope.AddFace(0, 3, 1);
+		polytope.AddFace(0, 2, 3);
+		polytope.AddFace(1, 3, 2);
+
+		Face closest = polytope.faces[0];
+		for (int i = 0; i < GjkEpa::MaxIterations; i++)
+		{
+			closest = polytope.faces[0];
+			for (const Face &face : polytope.faces)
+			{
+				if (face.distance < closest.distance)
+					closest = face;
+			}
+
+			Vector3d point = Support(a, b, closest.normal);
+			if (point.Dot(closest.normal) - closest.distance < GjkEpa::Tolerance)
+				break;
+
+			// the faces which can be seen from the new point are replaced by faces to the horizon
+			int index = static_cast<int>(polytope.vertices.size());
+			polytope.vertices.push_back(point);
+			polytope.edges.clear();
+			for (size_t j = 0; j < polytope.faces.size();)
+			{
+				const Face &face = polytope.faces[j];
+				if (face.normal.Dot(point - polytope.vertices[face.a]) > 0)
+				{
+					polytope.AddEdge(face.a, face.b);
+					polytope.AddEdge(face.b, face.c);
+					polytope.AddEdge(face.c, face.a);
+					polytope.faces[j] = polytope.faces.back();
+					polytope.faces.pop_back();
+				}
+				else
+					j++;
+			}
+
+			// no face can be seen because of the numerical precision, the closest face is the result
+			if (polytope.edges.empty())
+				break;
+
+			for (const pair<int, int> &edge : polytope.edges)
+				polytope.AddFace(edge.first, edge.second, index);
+		}
+
+		// the Minkowski difference has to be moved by the negative penetration to separate the primitives
+		_return = closest.normal * -max(closest.distance, 0.0);
+	}
+}
+
+bool GjkEpa::Intersect(const ConvexShape & a, const ConvexShape & b)
+{
+	if (!a.bounds.Overlaps(b.bounds))
+		return false;
+
+	if (a.IsRounded() && b.IsRounded())
+	{
+		Vector3d penetration;
+		return RoundedPenetration(penetration, a, b);
+	}
+
+	Simplex simplex;
+	return Gjk(simplex, a, b);
+}
+
+bool GjkEpa::Penetration(Vector3d & _return, const ConvexShape & a, const ConvexShape & b)
+{
+	_return = Vector3d();
+	if (!a.bounds.Overlaps(b.bounds))
+		return false;
+
+	if (a.IsRounded() && b.IsRounded())
+		return RoundedPenetration(_return, a, b);
+
+	Simplex simplex;
+	if (!Gjk(simplex, a, b))
+		return false;
+
+	// the origin is located on the surface of a flat Minkowski difference, the penetration is zero
+	if (!CompleteSimplex(simplex, a, b))
+		return true;
+
+	Epa(_return, simplex, a, b);
+	return true;
+}
+
+bool GjkEpa::Intersect(const ConvexShape * beginA, const ConvexShape * endA, const ConvexShape * beginB, const ConvexShape * endB)
+{
+	for (const ConvexShape *a = beginA; a != endA; ++a)
+	{
+		for (const ConvexShape *b = beginB; b != endB; ++b)
+		{
+			if (Intersect(*a, *b))
+				return true;
+		}
+	}
+	return false;
+}
+
+bool GjkEpa::Penetration(Vector3d & _return, const ConvexShape * beginA, const ConvexShape * endA, const ConvexShape * beginB, const ConvexShape * endB)
+{
+	_return = Vector3d();
+	bool intersecting = false;
+	for (const ConvexShape *a = beginA; a != endA; ++a)
+	{
+		for (const ConvexShape *b = beginB; b != endB; ++b)
+		{
+			Vector3d penetration;
+			if (!Penetration(penetration, *a, *b))
+				continue;
+
+			if (!intersecting || penetration.LengthSquared() > _return.LengthSquared())
+				_return = penetration;
+			intersecting = true;
+		}
+	}
+	return intersecting;
+}
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "CollisionShape.h"
+
+using namespace MMIStandard;
+using namespace std;
+
+namespace MMIStandard {
+	class GjkEpa
+	{
+		/*
+			Narrow phase tests between two placed convex primitives.
+			The intersection is tested with GJK on the Minkowski difference of the support functions,
+			the penetration is computed with EPA on the final simplex of GJK.
+			Pairs of spheres and capsules are tested analytically on their segments, which is exact and does not iterate.
+			The primitives have to be placed (see ConvexShape::Place), the tests start with a comparison of their bounds.
+		*/
+	public:
+		GjkEpa() = delete;
+
+		//	The maximum number of iterations of GJK and EPA
+		static const int MaxIterations = 64;
+
+		//	EPA stops once the penetration improves by less than the tolerance
+		static constexpr double Tolerance = 1e-6;
+
+		//	Returns true if the primitives intersect
+		static bool Intersect(const ConvexShape &a, const ConvexShape &b);
+
+		//	Returns true if the primitives intersect
+		//	<param name="_return">The shortest translation of a which separates the primitives, zero if they do not intersect</param>
+		static bool Penetration(Vector3d &_return, const ConvexShape &a, const ConvexShape &b);
+
+		//	Tests of compound shapes, given as ranges of placed primitives (see CollisionShape::Place)
+		//	Returns true if any primitive of a intersects any primitive of b
+		static bool Intersect(const ConvexShape *beginA, const ConvexShape *endA, const ConvexShape *beginB, const ConvexShape *endB);
+
+		//	Returns true if any primitives intersect
+		//	<param name="_return">The deepest penetration of all intersecting pairs of primitives, as translation of a</param>
+		static bool Penetration(Vector3d &_return, const ConvexShape *beginA, const ConvexShape *endA, const ConvexShape *beginB, const ConvexShape *endB);
+	};
+}
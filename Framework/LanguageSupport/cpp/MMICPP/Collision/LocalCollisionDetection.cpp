@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "LocalCollisionDetection.h"
+#include <vector>
+
+using namespace MMIStandard;
+
+const string LocalCollisionDetection::ServiceName = "collisionDetectionService";
+MServiceDescription LocalCollisionDetection::description;
+atomic<uint64_t> LocalCollisionDetection::testCount{ 0 };
+
+namespace
+{
+	//	The placed primitives of both colliders, the buffers are reused by the calls of a thread
+	struct PlacedShapes
+	{
+		vector<ConvexShape> a, b;
+		Bounds3d boundsA, boundsB;
+
+		void Place(const CollisionShape &shapeA, const Pose3d &poseA, const CollisionShape &shapeB, const Pose3d &poseB)
+		{
+			this->a.clear();
+			this->b.clear();
+			this->boundsA = shapeA.Place(this->a, poseA);
+			this->boundsB = shapeB.Place(this->b, poseB);
+		}
+	};
+
+	PlacedShapes &GetPlacedShapes()
+	{
+		thread_local PlacedShapes shapes;
+		return shapes;
+	}
+}
+
+bool LocalCollisionDetection::CausesCollision(const CollisionShape & shapeA, const Pose3d & poseA, const CollisionShape & shapeB, const Pose3d & poseB)
+{
+	testCount.fetch_add(1, memory_order_relaxed);
+	PlacedShapes &shapes = GetPlacedShapes();
+	shapes.Place(shapeA, poseA, shapeB, poseB);
+	if (!shapes.boundsA.Overlaps(shapes.boundsB))
+		return false;
+
+	return GjkEpa::Intersect(shapes.a.data(), shapes.a.data() + shapes.a.size(), shapes.b.data(), shapes.b.data() + shapes.b.size());
+}
+
+bool LocalCollisionDetection::ComputePenetration(Vector3d & _return, const CollisionShape & shapeA, const Pose3d & poseA, const CollisionShape & shapeB, const Pose3d & poseB)
+{
+	testCount.fetch_add(1, memory_order_relaxed);
+	_return = Vector3d();
+	PlacedShapes &shapes = GetPlacedShapes();
+	shapes.Place(shapeA, poseA, shapeB, poseB);
+	if (!shapes.boundsA.Overlaps(shapes.boundsB))
+		return false;
+
+	return GjkEpa::Penetration(_return, shapes.a.data(), shapes.a.data() + shapes.a.size(), shapes.b.data(), shapes.b.data() + shapes.b.size());
+}
+
+void LocalCollisionDetection::ComputePenetration(MVector3 & _return, const MCollider & colliderA, const MTransform & transformA, const MCollider & colliderB, const MTransform & transformB)
+{
+	Vector3d penetration;
+	ComputePenetration(penetration, CollisionShape(colliderA), Pose3d(transformA), CollisionShape(colliderB), Pose3d(transformB));
+	_return = penetration.ToMVector3();
+}
+
+bool LocalCollisionDetection::CausesCollision(const MCollider & colliderA, const MTransform & transformA, const MCollider & colliderB, const MTransform & transformB)
+{
+	return CausesCollision(CollisionShape(colliderA), Pose3d(transformA), CollisionShape(colliderB), Pose3d(transformB));
+}
+
+void LocalCollisionDetection::GetStatus(std::map<std::string, std::string>& _return)
+{
+	_return["Running"] = "True";
+	_return["Tests"] = std::to_string(testCount.load(memory_order_relaxed));
+	_return["Cached Colliders"] = std::to_string(CollisionShape::CacheSize());
+}
+
+void LocalCollisionDetection::GetDescription(MServiceDescription & _return)
+{
+	_return = description;
+}
+
+void LocalCollisionDetection::Setup(MBoolResponse & _return, const MAvatarDescription & avatar, const std::map<std::string, std::string>& properties)
+{
+	_return.__set_Successful(true);
+}
+
+void LocalCollisionDetection::Consume(std::map<std::string, std::string>& _return, const std::map<std::string, std::string>& properties)
+{
+}
+
+void LocalCollisionDetection::Dispose(MBoolResponse & _return, const std::map<std::string, std::string>& properties)
+{
+	_return.__set_Successful(true);
+}
+
+void LocalCollisionDetection::Restart(MBoolResponse & _return, const std::map<std::string, std::string>& properties)
+{
+	_return.__set_Successful(true);
+}
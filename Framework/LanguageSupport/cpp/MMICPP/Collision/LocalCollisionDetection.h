@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "gen-cpp/MCollisionDetectionService.h"
+#include "CollisionShape.h"
+#include "GjkEpa.h"
+#include <atomic>
+
+using namespace MMIStandard;
+using namespace std;
+
+namespace MMIStandard {
+	class LocalCollisionDetection : public MCollisionDetectionServiceIf
+	{
+		/*
+			In-process implementation of the MCollisionDetectionService (see GjkEpa).
+			C++ MMUs can call an instance directly instead of the remote service, the calls do not leave the process.
+			The class is stateless, one instance can be used by any number of threads.
+			The same implementation is served by the CollisionDetectionServer, so it can be used by the other adapters through the register.
+			Compound colliders are tested primitive by primitive, the deepest penetration of all primitives is returned.
+		*/
+	public:
+		//	The name under which the service is registered, is looked up by the ServiceAccess of the MMUs
+		static const string ServiceName;
+
+		//	The description which is returned by GetDescription, is set by the adapter if the service is served
+		static MServiceDescription description;
+
+	private:
+		//	The number of tested collider pairs, is reported by GetStatus
+		static atomic<uint64_t> testCount;
+
+	public:
+		//	Returns the shortest translation of colliderA which separates the colliders, zero if they do not intersect
+		virtual void ComputePenetration(MVector3& _return, const MCollider& colliderA, const MTransform& transformA, const MCollider& colliderB, const MTransform& transformB) override;
+
+		//	Returns true if the colliders intersect
+		virtual bool CausesCollision(const MCollider& colliderA, const MTransform& transformA, const MCollider& colliderB, const MTransform& transformB) override;
+
+		//	Tests of compiled colliders, avoids compiling the colliders on every call (see CollisionShape::Get)
+		static bool CausesCollision(const CollisionShape &shapeA, const Pose3d &poseA, const CollisionShape &shapeB, const Pose3d &poseB);
+		static bool ComputePenetration(Vector3d &_return, const CollisionShape &shapeA, const Pose3d &poseA, const CollisionShape &shapeB, const Pose3d &poseB);
+
+		//	Inherited via MMIServiceBaseIf
+		virtual void GetStatus(std::map<std::string, std::string> & _return) override;
+		virtual void GetDescription(MServiceDescription& _return) override;
+		virtual void Setup(MBoolResponse& _return, const MAvatarDescription& avatar, const std::map<std::string, std::string> & properties) override;
+		virtual void Consume(std::map<std::string, std::string> & _return, const std::map<std::string, std::string> & properties) override;
+		virtual void Dispose(MBoolResponse& _return, const std::map<std::string, std::string> & properties) override;
+		virtual void Restart(MBoolResponse& _return, const std::map<std::string, std::string> & properties) override;
+	};
+}
@@ -14,11 +14,16 @@ using namespace apache::thrift::protocol;
 using namespace MMIStandard;
 
 template<class T>
- ThriftClient<T>::ThriftClient(std::string const & address, int port, bool autoOpen) :address(address), port(port)
+ ThriftClient<T>::ThriftClient(std::string const & address, int port, bool autoOpen) :ThriftClient(address, port, TransportSettings(), autoOpen)
+{
+}
+
+template<class T>
+ ThriftClient<T>::ThriftClient(std::string const & address, int port, const TransportSettings & settings, bool autoOpen) :address(address), port(port)
 {
 	 shared_ptr<TTransport> socket(new TSocket(this->address, this->port));
-	 this->transport = shared_ptr<TTransport>(new TBufferedTransport(socket));
-	 shared_ptr<TProtocol> protocol(new TCompactProtocol{ transport });
+	 this->transport = settings.CreateTransport(socket);
+	 shared_ptr<TProtocol> protocol = settings.CreateProtocol(this->transport);
 	 this->access = shared_ptr<T>(new T{ protocol });
 
 	 if (autoOpen)
@@ -45,3 +50,22 @@ void ThriftClient<T>::Start()
 	}
 	
 }
+
+template<class T>
+void ThriftClient<T>::Open()
+{
+	if (!this->transport->isOpen())
+		this->transport->open();
+}
+
+template<class T>
+void ThriftClient<T>::Close()
+{
+	this->transport->close();
+}
+
+template<class T>
+bool ThriftClient<T>::IsOpen() const
+{
+	return this->transport->isOpen();
+}
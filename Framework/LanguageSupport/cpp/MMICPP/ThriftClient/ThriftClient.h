@@ -11,6 +11,7 @@
 
 #pragma once
 #include <thrift/transport/TTransportUtils.h>
+#include "Utils/TransportSettings.h"
 
 using namespace apache::thrift;
 using namespace apache::thrift::transport;
@@ -38,14 +39,26 @@ namespace MMIStandard {
 
 	public:
 
-		//	Basic constructor
+		//	Basic constructor, uses the default transport and protocol
 		ThriftClient(std::string const &address, int port, bool autoOpen = true);
 
+		//	Constructor which uses the given transport and protocol, e.g. the ones advertised by the server (see TransportSettings::ReadProperties)
+		ThriftClient(std::string const &address, int port, const TransportSettings &settings, bool autoOpen = true);
+
 		//	Basic destructor closes the connection
 		~ThriftClient();
 
-		//	Starts the client and opens the connection
+		//	Starts the client and opens the connection, a failed connect is only logged
 		void Start();
+
+		//	Opens the connection, throws a TTransportException if the server can not be reached
+		void Open();
+
+		//	Closes the connection
+		void Close();
+
+		//	Returns whether the connection is open
+		bool IsOpen() const;
 	};
 }
 #endif
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "CollisionDetectionServer.h"
+#include "Collision/LocalCollisionDetection.h"
+#include <thrift/transport/TServerSocket.h>
+#include <thrift/concurrency/ThreadManager.h>
+#include <thrift/concurrency/ThreadFactory.h>
+
+using namespace std;
+using namespace apache::thrift;
+using namespace apache::thrift::transport;
+using namespace apache::thrift::server;
+using namespace apache::thrift::concurrency;
+
+CollisionDetectionServer::~CollisionDetectionServer()
+{
+	if (this->server == nullptr)
+		return;
+
+	try
+	{
+		this->server->stop();
+		delete this->server;
+	}
+	catch (...)
+	{
+	}
+}
+
+void CollisionDetectionServer::Start(int port, int workerCount, const TransportSettings & transport)
+{
+	std::shared_ptr<ThreadManager> threadManager = ThreadManager::newSimpleThreadManager(workerCount);
+	threadManager->threadFactory(std::make_shared<ThreadFactory>());
+	threadManager->start();
+
+	this->server = new TThreadPoolServer(std::make_shared<MCollisionDetectionServiceProcessor>(std::make_shared<LocalCollisionDetection>()),
+		std::make_shared<TServerSocket>(port),
+		transport.CreateTransportFactory(),
+		transport.CreateProtocolFactory(),
+		threadManager);
+
+	this->server->serve();
+}
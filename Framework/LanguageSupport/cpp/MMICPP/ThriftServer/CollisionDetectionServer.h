@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include <thrift/server/TThreadPoolServer.h>
+#include "Utils/TransportSettings.h"
+
+using namespace apache::thrift::server;
+using namespace std;
+
+namespace MMIStandard {
+	class CollisionDetectionServer
+	{
+		/**
+			Serves the LocalCollisionDetection as MCollisionDetectionService, so the MMUs of other adapters can use the collision detection of this adapter
+			All connections share one stateless handler
+		*/
+
+	private:
+		//the server itself
+		TThreadPoolServer *server = nullptr;
+
+	public:
+		//Destructor which stops the server
+		~CollisionDetectionServer();
+
+		//Starts the server, blocks until the server is stopped
+		// <param name="port">The port at which the server schould listen</param>
+		// <param name="workerCount">The number of working server threads</param>
+		// <param name="transport">The transport and protocol which are used by the clients</param>
+		void Start(int port, int workerCount, const TransportSettings &transport = TransportSettings());
+	};
+}
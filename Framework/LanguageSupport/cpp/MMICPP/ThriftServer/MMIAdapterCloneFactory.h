@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "gen-cpp/MMIAdapter.h"
+#include "Adapter/ThriftAdapterImplementation.h"
+
+namespace MMIStandard {
+	class MMIAdapterCloneFactory : virtual public MMIAdapterIfFactory
+	{
+		/**
+			Creates a ThriftAdapterImplementation for each connection, is used by all server engines
+			The calls of one connection are processed one after another, so a handler is never called concurrently
+		*/
+
+		// Inherited via MMIAdapterIfFactory
+		virtual MMIAdapterIf * getHandler(const::apache::thrift::TConnectionInfo & connInfo) override
+		{
+			//TODO for debugging maybe include in debugging
+			/*std::shared_ptr<TSocket> sock = std::dynamic_pointer_cast<TSocket>(connInfo.transport);
+			cout << "Incoming connection\n";
+			cout << "\tSocketInfo: " << sock->getSocketInfo() << "\n";
+			cout << "\tPeerHost: " << sock->getPeerHost() << "\n";
+			cout << "\tPeerAddress: " << sock->getPeerAddress() << "\n";
+			cout << "\tPeerPort: " << sock->getPeerPort() << "\n";*/
+			return new ThriftAdapterImplementation{};
+		}
+
+		virtual void releaseHandler(MMIAdapterIf * handler) override
+		{
+			delete handler;
+		}
+	};
+}
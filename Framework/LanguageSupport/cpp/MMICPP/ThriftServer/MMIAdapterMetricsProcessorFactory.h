@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "gen-cpp/MMIAdapter.h"
+#include "Adapter/RpcMetrics.h"
+#include "MMIAdapterSceneProcessor.h"
+#include <thrift/TProcessor.h>
+
+namespace MMIStandard {
+	class RpcMetricsEventHandler : public ::apache::thrift::TProcessorEventHandler
+	{
+		/**
+			Records the size of the serialized requests and responses in RpcMetrics, the handlers only see the deserialized arguments
+		*/
+	public:
+		virtual void postRead(void * ctx, const char * fn_name, uint32_t bytes) override
+		{
+			Rpc_method method;
+			if (RpcMetrics::ParseMethod(method, fn_name))
+				RpcMetrics::RecordBytesIn(method, bytes);
+		}
+
+		virtual void postWrite(void * ctx, const char * fn_name, uint32_t bytes) override
+		{
+			Rpc_method method;
+			if (RpcMetrics::ParseMethod(method, fn_name))
+				RpcMetrics::RecordBytesOut(method, bytes);
+		}
+	};
+
+	class MMIAdapterMetricsProcessorFactory : public MMIAdapterProcessorFactory
+	{
+		/**
+			Creates the processors of the adapter with the RpcMetricsEventHandler, is used by all server engines
+		*/
+	private:
+		std::shared_ptr<RpcMetricsEventHandler> eventHandler;
+
+	public:
+		MMIAdapterMetricsProcessorFactory(const std::shared_ptr<MMIAdapterIfFactory> &handlerFactory) :MMIAdapterProcessorFactory(handlerFactory), eventHandler{ std::make_shared<RpcMetricsEventHandler>() }
+		{
+		}
+
+		virtual std::shared_ptr<::apache::thrift::TProcessor> getProcessor(const ::apache::thrift::TConnectionInfo & connInfo) override
+		{
+			::apache::thrift::ReleaseHandler<MMIAdapterIfFactory> cleanup(this->handlerFactory_);
+			std::shared_ptr<MMIAdapterIf> handler(this->handlerFactory_->getHandler(connInfo), cleanup);
+
+			//	the handlers of the adapter take over the scene updates, other handlers get the generated processor
+			std::shared_ptr<::apache::thrift::TProcessor> processor;
+			std::shared_ptr<ThriftAdapterImplementation> adapter = std::dynamic_pointer_cast<ThriftAdapterImplementation>(handler);
+			if (adapter)
+				processor = std::make_shared<MMIAdapterSceneProcessor>(adapter);
+			else
+				processor = std::make_shared<MMIAdapterProcessor>(handler);
+
+			processor->setEventHandler(this->eventHandler);
+			return processor;
+		}
+	};
+}
@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "MMIAdapterSceneProcessor.h"
+#include <thrift/TApplicationException.h>
+
+using namespace MMIStandard;
+using namespace apache::thrift;
+using namespace apache::thrift::protocol;
+
+MMIAdapterSceneProcessor::MMIAdapterSceneProcessor(const std::shared_ptr<ThriftAdapterImplementation>& adapter) :MMIAdapterProcessor(adapter), adapter{ adapter }
+{
+}
+
+bool MMIAdapterSceneProcessor::dispatchCall(TProtocol * iprot, TProtocol * oprot, const std::string & fname, int32_t seqid, void * callContext)
+{
+	if (fname != "PushScene")
+		return MMIAdapterProcessor::dispatchCall(iprot, oprot, fname, seqid, callContext);
+
+	this->processPushScene(seqid, iprot, oprot, callContext);
+	return true;
+}
+
+void MMIAdapterSceneProcessor::processPushScene(int32_t seqid, TProtocol * iprot, TProtocol * oprot, void * callContext)
+{
+	void* ctx = NULL;
+	if (this->eventHandler_.get() != NULL)
+		ctx = this->eventHandler_->getContext("MMIAdapter.PushScene", callContext);
+	TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "MMIAdapter.PushScene");
+
+	if (this->eventHandler_.get() != NULL)
+		this->eventHandler_->preRead(ctx, "MMIAdapter.PushScene");
+
+	MMIAdapter_PushScene_args args;
+	args.read(iprot);
+	iprot->readMessageEnd();
+	uint32_t bytes = iprot->getTransport()->readEnd();
+
+	if (this->eventHandler_.get() != NULL)
+		this->eventHandler_->postRead(ctx, "MMIAdapter.PushScene", bytes);
+
+	MMIAdapter_PushScene_result result;
+	try
+	{
+		// the arguments are not used after this call, therefore the scene takes over the update
+		this->adapter->PushScene(result.success, std::move(args.sceneUpdates), args.sessionID);
+		result.__isset.success = true;
+	}
+	catch (const std::exception& e)
+	{
+		if (this->eventHandler_.get() != NULL)
+			this->eventHandler_->handlerError(ctx, "MMIAdapter.PushScene");
+
+		TApplicationException x(e.what());
+		oprot->writeMessageBegin("PushScene", T_EXCEPTION, seqid);
+		x.write(oprot);
+		oprot->writeMessageEnd();
+		oprot->getTransport()->writeEnd();
+		oprot->getTransport()->flush();
+		return;
+	}
+
+	if (this->eventHandler_.get() != NULL)
+		this->eventHandler_->preWrite(ctx, "MMIAdapter.PushScene");
+
+	oprot->writeMessageBegin("PushScene", T_REPLY, seqid);
+	result.write(oprot);
+	oprot->writeMessageEnd();
+	bytes = oprot->getTransport()->writeEnd();
+	oprot->getTransport()->flush();
+
+	if (this->eventHandler_.get() != NULL)
+		this->eventHandler_->postWrite(ctx, "MMIAdapter.PushScene", bytes);
+}
@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include "gen-cpp/MMIAdapter.h"
+#include "Adapter/ThriftAdapterImplementation.h"
+
+namespace MMIStandard {
+	class MMIAdapterSceneProcessor : public MMIAdapterProcessor
+	{
+		/**
+			Processor of the ThriftAdapterImplementation which hands the deserialized scene update of PushScene over to the adapter,
+			the generated processor only passes it as const reference so the scene would have to copy it
+			All other calls are processed by the generated processor
+		*/
+	private:
+		std::shared_ptr<ThriftAdapterImplementation> adapter;
+
+		//	Processes a PushScene call like the generated processor, but moves the arguments into the adapter
+		void processPushScene(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+
+	protected:
+		virtual bool dispatchCall(::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, const std::string& fname, int32_t seqid, void* callContext) override;
+
+	public:
+		//	Basic constructor
+		//	<param name="adapter">The handler of the connection</param>
+		MMIAdapterSceneProcessor(const std::shared_ptr<ThriftAdapterImplementation> &adapter);
+	};
+}
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include <string>
+#include "Utils/TransportSettings.h"
+
+using namespace std;
+
+namespace MMIStandard {
+
+	//	The server engines of the adapter
+	enum Server_type
+	{
+		//	One worker thread per connection, the number of connections is limited by the number of worker threads
+		S_THREADPOOL,
+
+		//	The connections are served by a few IO threads, the calls are processed by the worker threads
+		//	Any number of connections can be open, the clients have to use the framed transport
+		S_NONBLOCKING,
+	};
+
+	struct ServerSettings
+	{
+		/*
+			Settings of the adapter server
+		*/
+
+		//	The server engine
+		Server_type type = S_THREADPOOL;
+
+		//	The number of worker threads which process the calls
+		int workerCount = 4;
+
+		//	The number of IO threads of the nonblocking server, 0 uses half of the hardware threads
+		int ioThreadCount = 0;
+
+		//	The number of threads which execute the MMUs of independent avatars within one DoStepBatch call, 0 uses the hardware threads
+		int stepThreadCount = 0;
+
+		//	The number of seconds after which an unused session is removed, 0 keeps the sessions until they are closed
+		int sessionTimeout = 0;
+
+		//	The port at which the local collision detection is served and registered as collision detection service, 0 does not serve it
+		int collisionPort = 0;
+
+		//	The transport and protocol of the server, the nonblocking server always uses the framed transport
+		TransportSettings transport;
+
+		//	Parses the name of a server engine ("threadpool" or "nonblocking"), returns false if the name is unknown
+		static bool ParseType(Server_type &_return, const string &name)
+		{
+			if (name == "threadpool")
+				_return = S_THREADPOOL;
+			else if (name == "nonblocking")
+				_return = S_NONBLOCKING;
+			else
+				return false;
+			return true;
+		}
+	};
+}
@@ -4,12 +4,15 @@
 
 #include "ThriftNonBlockingServer.h"
 #include <thread>
+#include <algorithm>
 #include "thrift/transport/TTransport.h"
 #include "thrift/transport/TNonblockingServerSocket.h"
 #include <thrift/concurrency/ThreadManager.h>
 #include <thrift/concurrency/ThreadFactory.h>
-#include "Adapter/ThriftAdapterImplementation.h"
+#include "MMIAdapterCloneFactory.h"
+#include "MMIAdapterMetricsProcessorFactory.h"
 #include "thrift/protocol/TCompactProtocol.h"
+#include "thrift/protocol/TBinaryProtocol.h"
 
 using namespace std;
 using namespace apache::thrift::protocol;
@@ -17,13 +20,11 @@ using namespace apache::thrift::transport;
 using namespace apache::thrift::server;
 using namespace apache::thrift::concurrency;
 
-ThriftNonBlockingServer::ThriftNonBlockingServer()
-{
-}
-
-
 ThriftNonBlockingServer::~ThriftNonBlockingServer()
 {
+	if (this->server == nullptr)
+		return;
+
 	try
 	{
 		this->server->stop();
@@ -34,27 +35,29 @@ ThriftNonBlockingServer::~ThriftNonBlockingServer()
 	}
 }
 
-void ThriftNonBlockingServer::Start(int port)
+void ThriftNonBlockingServer::Start(int port, int ioThreadCount, int workerCount, Protocol_type protocol)
 {
-	int hw_threads = thread::hardware_concurrency();
-	int io_threads = hw_threads / 2;
-	int worker_threads = hw_threads * 1.5 + 1;
+	if (ioThreadCount <= 0)
+		ioThreadCount = max(1, static_cast<int>(thread::hardware_concurrency()) / 2);
+
 	auto transport = make_shared<TNonblockingServerSocket>(port);
 
-	shared_ptr<MMIAdapterProcessorFactory> processor = make_shared<MMIAdapterProcessorFactory>(make_shared<MMIAdapterIfSingletonFactory>(make_shared<ThriftAdapterImplementation>()));
-	auto protoc_fac = make_shared<TCompactProtocolFactoryT<TMemoryBuffer>>();
+	//a handler is created for each connection, the calls of a connection are processed one after another
+	auto processor = make_shared<MMIAdapterMetricsProcessorFactory>(make_shared<MMIAdapterCloneFactory>());
+	//the requests are read into memory buffers, so the protocols are specialized for them
+	shared_ptr<TProtocolFactory> protocolFactory;
+	if (protocol == P_BINARY)
+		protocolFactory = make_shared<TBinaryProtocolFactoryT<TMemoryBuffer>>();
+	else
+		protocolFactory = make_shared<TCompactProtocolFactoryT<TMemoryBuffer>>();
 
 	//threadmanager for reusing threads
-	std::shared_ptr<ThreadManager> threadManager = ThreadManager::newSimpleThreadManager(worker_threads);
+	std::shared_ptr<ThreadManager> threadManager = ThreadManager::newSimpleThreadManager(workerCount);
 	threadManager->threadFactory(std::make_shared<ThreadFactory>());
 	threadManager->start();
-	
-
 
-	this->server = new TNonblockingServer(processor,protoc_fac,transport,threadManager);
-	this->server->setNumIOThreads(io_threads);
+	//This server allows any number of connections, "workerCount" calls are processed at a time
+	this->server = new TNonblockingServer(processor, protocolFactory, transport, threadManager);
+	this->server->setNumIOThreads(ioThreadCount);
 	this->server->serve();
-
-	
-
 }
@@ -4,16 +4,33 @@
 
 #pragma once
 #include "thrift/server/TNonblockingServer.h"
+#include "Utils/TransportSettings.h"
 
 using namespace apache::thrift::server;
-class ThriftNonBlockingServer
-{
-private: 
-	TNonblockingServer* server;
-public:
-	ThriftNonBlockingServer();
-	~ThriftNonBlockingServer();
 
-	void Start(int port);
-};
+namespace MMIStandard {
+	class ThriftNonBlockingServer
+	{
+		/**
+			Adapter server which serves all connections with a few IO threads (based on libevent)
+			The calls are processed by a pool of worker threads, an idle connection does not occupy a worker thread.
+			Every connection gets its own ThriftAdapterImplementation like in ThriftServer.
+			The server only supports the framed transport.
+		*/
 
+	private:
+		//the server itself
+		TNonblockingServer *server = nullptr;
+
+	public:
+		//Destructor which stops the server
+		~ThriftNonBlockingServer();
+
+		//Starts the server, blocks until the server is stopped
+		// <param name="port">The port at which the server schould listen</param>
+		// <param name="ioThreadCount">The number of threads which handle the connections, 0 uses half of the hardware threads</param>
+		// <param name="workerCount">The number of threads which process the calls</param>
+		// <param name="protocol">The protocol which is used by the clients</param>
+		void Start(int port, int ioThreadCount, int workerCount, Protocol_type protocol = P_COMPACT);
+	};
+}
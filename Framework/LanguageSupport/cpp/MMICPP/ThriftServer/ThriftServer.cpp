@@ -6,7 +6,8 @@
 #include <thrift/protocol/TCompactProtocol.h>
 #include <thrift/transport/TTransportUtils.h>
 #include <iostream>
-#include "Adapter/ThriftAdapterImplementation.h"
+#include "MMIAdapterCloneFactory.h"
+#include "MMIAdapterMetricsProcessorFactory.h"
 #include <thrift/transport/TSocket.h>
 //#include <thrift/server/TSimpleServer.h> //needed for simpleServer
 #include <thrift/server/TThreadPoolServer.h>
@@ -21,29 +22,11 @@ using namespace apache::thrift::server;
 using namespace apache::thrift::concurrency;
 
 
-class MMIAdapterCloneFactory : virtual public MMIAdapterIfFactory
-{
-	// Inherited via MMIAdapterIfFactory
-	virtual MMIAdapterIf * getHandler(const::apache::thrift::TConnectionInfo & connInfo) override
-	{
-		std::shared_ptr<TSocket> sock = std::dynamic_pointer_cast<TSocket>(connInfo.transport);
-		//TODO for debugging maybe include in debugging
-		/*cout << "Incoming connection\n";
-		cout << "\tSocketInfo: " << sock->getSocketInfo() << "\n";
-		cout << "\tPeerHost: " << sock->getPeerHost() << "\n";
-		cout << "\tPeerAddress: " << sock->getPeerAddress() << "\n";
-		cout << "\tPeerPort: " << sock->getPeerPort() << "\n";*/
-		return new ThriftAdapterImplementation{};
-	}
-
-	virtual void releaseHandler(MMIAdapterIf * handler) override
-	{
-		delete handler;
-	}
-};
-
 ThriftServer::~ThriftServer()
 {
+	if (this->server == nullptr)
+		return;
+
 	try
 	{
 		this->server->stop();
@@ -55,7 +38,7 @@ ThriftServer::~ThriftServer()
 
 }
 
-void ThriftServer::Start(int port,int workerCount)
+void ThriftServer::Start(int port,int workerCount, const TransportSettings &transport)
 {
 	//Simple server only uses one thread maybe usefull for debugging
 	/*TSimpleServer server(
@@ -75,10 +58,10 @@ void ThriftServer::Start(int port,int workerCount)
 
 	//This server allows "workerCount" connection at a time, and reuses threads
 
-	this->server = new TThreadPoolServer(std::make_shared<MMIAdapterProcessorFactory>(std::make_shared<MMIAdapterCloneFactory>()),
+	this->server = new TThreadPoolServer(std::make_shared<MMIAdapterMetricsProcessorFactory>(std::make_shared<MMIAdapterCloneFactory>()),
 		std::make_shared<TServerSocket>(port),
-		std::make_shared<TBufferedTransportFactory>(),
-		std::make_shared<TCompactProtocolFactory>(),
+		transport.CreateTransportFactory(),
+		transport.CreateProtocolFactory(),
 		threadManager);
 
 	this->server->serve();
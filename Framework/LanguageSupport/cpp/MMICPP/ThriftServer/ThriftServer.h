@@ -4,6 +4,7 @@
 
 #pragma once
 #include<thrift/server/TThreadPoolServer.h>
+#include "Utils/TransportSettings.h"
 
 using namespace apache::thrift::server;
 using namespace std;
@@ -17,7 +18,7 @@ namespace MMIStandard {
 
 	private:
 		//the server itself
-		TThreadPoolServer *server;
+		TThreadPoolServer *server = nullptr;
 
 	public:
 		//Destructor which stops the server
@@ -26,7 +27,8 @@ namespace MMIStandard {
 		//Starts the server 
 		// <param name="port">The port at which the server schould listen</param>
 		// <param name="entries">The number of working server threads</param>
-		void Start(int port, int workerCount);
+		// <param name="transport">The transport and protocol which are used by the clients</param>
+		void Start(int port, int workerCount, const TransportSettings &transport = TransportSettings());
 	};
 }
 
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "LatencyHistogram.h"
+#include <cmath>
+
+using namespace MMIStandard;
+
+LatencyHistogram::LatencyHistogram() :count{ 0 }, sum{ 0 }, max{ 0 }
+{
+	for (atomic<uint64_t> &bucket : this->buckets)
+		bucket.store(0, memory_order_relaxed);
+}
+
+size_t LatencyHistogram::GetBucket(uint64_t value)
+{
+	if (value < SubBucketCount)
+		return static_cast<size_t>(value);
+
+	int highestBit = 63;
+	while ((value >> highestBit) == 0)
+		highestBit--;
+
+	// the value is shifted so its highest bit is at SubBucketBits, the remaining bits select the sub bucket within the power of two
+	int shift = highestBit - SubBucketBits;
+	if (shift >= MagnitudeCount)
+		return BucketCount - 1;
+	return static_cast<size_t>((shift + 1) * SubBucketCount + ((value >> shift) - SubBucketCount));
+}
+
+uint64_t LatencyHistogram::GetUpperBound(size_t bucket)
+{
+	if (bucket < SubBucketCount)
+		return bucket;
+
+	int shift = static_cast<int>(bucket / SubBucketCount) - 1;
+	uint64_t subBucket = bucket % SubBucketCount + SubBucketCount;
+	return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t micros)
+{
+	this->buckets[GetBucket(micros)].fetch_add(1, memory_order_relaxed);
+	this->count.fetch_add(1, memory_order_relaxed);
+	this->sum.fetch_add(micros, memory_order_relaxed);
+
+	uint64_t currentMax = this->max.load(memory_order_relaxed);
+	while (micros > currentMax && !this->max.compare_exchange_weak(currentMax, micros, memory_order_relaxed));
+}
+
+uint64_t LatencyHistogram::Count() const
+{
+	return this->count.load(memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Mean() const
+{
+	uint64_t recorded = this->Count();
+	return recorded == 0 ? 0 : this->sum.load(memory_order_relaxed) / recorded;
+}
+
+uint64_t LatencyHistogram::Max() const
+{
+	return this->max.load(memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Percentile(double percentage) const
+{
+	// the buckets are read one after another, so the total is taken from them instead of the concurrently updated count
+	array<uint64_t, BucketCount> snapshot;
+	uint64_t total = 0;
+	for (size_t i = 0; i < BucketCount; i++)
+	{
+		snapshot[i] = this->buckets[i].load(memory_order_relaxed);
+		total += snapshot[i];
+	}
+	if (total == 0)
+		return 0;
+
+	uint64_t rank = static_cast<uint64_t>(ceil(percentage / 100.0 * total));
+	if (rank == 0)
+		rank = 1;
+
+	uint64_t seen = 0;
+	for (size_t i = 0; i < BucketCount; i++)
+	{
+		seen += snapshot[i];
+		if (seen >= rank)
+			return std::min(GetUpperBound(i), this->Max());
+	}
+	return this->Max();
+}
+
+string LatencyHistogram::ToString() const
+{
+	return "p50=" + std::to_string(this->Percentile(50)) + "us"
+		+ " p90=" + std::to_string(this->Percentile(90)) + "us"
+		+ " p99=" + std::to_string(this->Percentile(99)) + "us"
+		+ " p99.9=" + std::to_string(this->Percentile(99.9)) + "us"
+		+ " max=" + std::to_string(this->Max()) + "us"
+		+ " mean=" + std::to_string(this->Mean()) + "us";
+}
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+namespace MMIStandard {
+	class LatencyHistogram
+	{
+		/*
+			Histogram of latencies in microseconds with a bounded relative error (HDR histogram).
+			Values below SubBucketCount are counted exactly, above each power of two is divided into SubBucketCount buckets,
+			so a percentile is at most 1 / SubBucketCount above the recorded value. Values up to about 19 hours are distinguished.
+			Recording is lock free and can be done from any thread, the readers see a consistent value per bucket only.
+		*/
+	public:
+		static const int SubBucketBits = 4;
+		static const uint64_t SubBucketCount = 1 << SubBucketBits;
+		static const int MagnitudeCount = 33;
+		static const size_t BucketCount = (MagnitudeCount + 1) * SubBucketCount;
+
+	private:
+		array<atomic<uint64_t>, BucketCount> buckets;
+		atomic<uint64_t> count;
+		atomic<uint64_t> sum;
+		atomic<uint64_t> max;
+
+	private:
+		//	Returns the bucket of the value
+		static size_t GetBucket(uint64_t value);
+
+		//	Returns the largest value which is counted in the bucket
+		static uint64_t GetUpperBound(size_t bucket);
+
+	public:
+		//	Basic constructor, the histogram is empty
+		LatencyHistogram();
+
+		LatencyHistogram(const LatencyHistogram&) = delete;
+		LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+		//	Records a latency in microseconds
+		void Record(uint64_t micros);
+
+		//	Returns the number of recorded values
+		uint64_t Count() const;
+
+		//	Returns the mean / maximum of the recorded values, 0 if there are none
+		uint64_t Mean() const;
+		uint64_t Max() const;
+
+		//	Returns the value below which the given percentage (0-100) of the recorded values are, 0 if there are none
+		uint64_t Percentile(double percentage) const;
+
+		//	Returns a short summary of the distribution, e.g. "p50=12us p90=20us p99=41us p99.9=90us max=130us mean=14us"
+		string ToString() const;
+	};
+}
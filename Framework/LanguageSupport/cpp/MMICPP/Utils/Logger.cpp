@@ -1,62 +1,267 @@
-#include <windows.h>
 #include "Logger.h"
 
 #include <vector>
 #include <chrono>
-#include <ctime> 
-#include <iostream>
-#include <time.h>
-
-#define BLACK			0
-#define BLUE			1
-#define GREEN			2
-#define CYAN			3
-#define RED				4
-#define MAGENTA			5
-#define BROWN			6
-#define LIGHTGRAY		7
-#define DARKGRAY		8
-#define LIGHTBLUE		9
-#define LIGHTGREEN		10
-#define LIGHTCYAN		11
-#define LIGHTRED		12
-#define LIGHTMAGENTA	13
-#define YELLOW			14
-#define WHITE			15
+#include <ctime>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#include <unistd.h>
+#endif
+
+#define ANSI_LIGHTRED		"\033[91m"
+#define ANSI_LIGHTGREEN		"\033[92m"
+#define ANSI_LIGHTCYAN		"\033[96m"
+#define ANSI_RESET			"\033[0m"
 
 
 using namespace std;
-Log_level Logger::logLevel=L_INFO;
+atomic<Log_level> Logger::logLevel{ L_INFO };
 
-void Logger::printLog(const Log_level level, const std::string & message)
+namespace
 {
-	std::FILE* output = (level == L_ERROR ? stderr : stdout);
-	if (level <= logLevel)
+	//	A message in the queue, it is formatted by the writer thread
+	struct LogEntry
+	{
+		atomic<size_t> sequence;
+		Log_level level;
+		chrono::system_clock::time_point time;
+		string message;
+	};
+
+	class LogBackend
 	{
-		
-		auto now = std::chrono::system_clock::now();
-		auto in_time_t = std::chrono::system_clock::to_time_t(now);
-		char str[26];
-			
-		ctime_s(str, sizeof str, &in_time_t);
-			str[strlen(str) - 1] = '\0';
-
-
-			HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-	
-			switch (level)
+		/*
+			Bounded multi producer queue (Vyukov) with a single consumer thread which writes the messages.
+			The sequence of an entry tells whether it is free for the producer of a position or ready for the writer.
+		*/
+	private:
+		static const size_t Capacity = 8192;
+
+		unique_ptr<LogEntry[]> entries;
+		atomic<size_t> enqueuePosition;
+		//	Only advanced by the writer, read by flush
+		atomic<size_t> dequeuePosition;
+
+		//	Messages which did not fit into the queue
+		atomic<size_t> dropped;
+
+		thread writer;
+		mutex lock;
+		condition_variable wake;
+		condition_variable flushed;
+		atomic<bool> writerSleeping;
+		bool stopping;
+
+		bool colored[2];
+
+	public:
+		LogBackend() :entries{ new LogEntry[Capacity] }, enqueuePosition{ 0 }, dequeuePosition{ 0 }, dropped{ 0 }, writerSleeping{ false }, stopping{ false }
+		{
+			for (size_t i = 0; i < Capacity; i++)
+				this->entries[i].sequence.store(i, memory_order_relaxed);
+
+#ifdef _WIN32
+			// the console interprets the ANSI colors once the virtual terminal processing is enabled
+			for (DWORD handle : { STD_OUTPUT_HANDLE, STD_ERROR_HANDLE })
 			{
-				case (1): SetConsoleTextAttribute(hConsole, LIGHTRED);
+				HANDLE console = GetStdHandle(handle);
+				DWORD mode = 0;
+				if (GetConsoleMode(console, &mode))
+					SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+			}
+#endif
+			// redirected output is not colored
+			this->colored[0] = isatty(fileno(stdout)) != 0;
+			this->colored[1] = isatty(fileno(stderr)) != 0;
+
+			this->writer = thread(&LogBackend::Write, this);
+		}
+
+		~LogBackend()
+		{
+			{
+				lock_guard<mutex> guard(this->lock);
+				this->stopping = true;
+			}
+			this->wake.notify_all();
+			this->writer.join();
+		}
+
+		void Enqueue(Log_level level, string &&message)
+		{
+			size_t position = this->enqueuePosition.load(memory_order_relaxed);
+			LogEntry *entry;
+			while (true)
+			{
+				entry = &this->entries[position % Capacity];
+				size_t sequence = entry->sequence.load(memory_order_acquire);
+				intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+				if (difference == 0)
+				{
+					if (this->enqueuePosition.compare_exchange_weak(position, position + 1, memory_order_relaxed))
+						break;
+				}
+				else if (difference < 0)
+				{
+					// the writer did not free the entry yet, the caller is never blocked
+					this->dropped.fetch_add(1, memory_order_relaxed);
+					return;
+				}
+				else
+					position = this->enqueuePosition.load(memory_order_relaxed);
+			}
+
+			entry->level = level;
+			entry->time = chrono::system_clock::now();
+			entry->message = move(message);
+			// sequentially consistent like the flag of the writer, either the writer sees the entry or the producer sees the writer sleeping
+			entry->sequence.store(position + 1, memory_order_seq_cst);
+			if (this->writerSleeping.load(memory_order_seq_cst))
+			{
+				// the writer holds the lock from its check until it waits, so the notification can not get lost
+				{
+					lock_guard<mutex> guard(this->lock);
+				}
+				this->wake.notify_one();
+			}
+		}
+
+		void Flush()
+		{
+			size_t position = this->enqueuePosition.load(memory_order_acquire);
+			unique_lock<mutex> guard(this->lock);
+			this->wake.notify_one();
+			this->flushed.wait(guard, [this, position] { return this->dequeuePosition.load(memory_order_acquire) >= position || this->stopping; });
+		}
+
+	private:
+		//	Returns true if the next entry is ready for the writer
+		bool IsReady() const
+		{
+			size_t position = this->dequeuePosition.load(memory_order_relaxed);
+			return this->entries[position % Capacity].sequence.load(memory_order_seq_cst) == position + 1;
+		}
+
+		//	Takes the next ready entry, returns false if there is none
+		bool Dequeue(Log_level &level, chrono::system_clock::time_point &time, string &message)
+		{
+			size_t position = this->dequeuePosition.load(memory_order_relaxed);
+			LogEntry &entry = this->entries[position % Capacity];
+			if (entry.sequence.load(memory_order_acquire) != position + 1)
+				return false;
+
+			level = entry.level;
+			time = entry.time;
+			message.swap(entry.message);
+			entry.message.clear();
+			entry.sequence.store(position + Capacity, memory_order_release);
+			this->dequeuePosition.store(position + 1, memory_order_release);
+			return true;
+		}
+
+		void Print(Log_level level, const chrono::system_clock::time_point &time, const string &message)
+		{
+			bool error = level == L_ERROR;
+			FILE *output = error ? stderr : stdout;
+
+			// same format as ctime
+			time_t timeT = chrono::system_clock::to_time_t(time);
+			tm local;
+#ifdef _WIN32
+			localtime_s(&local, &timeT);
+#else
+			localtime_r(&timeT, &local);
+#endif
+			char timeString[32];
+			strftime(timeString, sizeof timeString, "%a %b %d %H:%M:%S %Y", &local);
+
+			const char *color = "";
+			if (this->colored[error ? 1 : 0])
+			{
+				switch (level)
+				{
+				case L_ERROR: color = ANSI_LIGHTRED;
+					break;
+				case L_INFO: color = ANSI_LIGHTGREEN;
 					break;
-				case (2): SetConsoleTextAttribute(hConsole, LIGHTGREEN);
+				case L_DEBUG: color = ANSI_LIGHTCYAN;
 					break;
-				case (3): SetConsoleTextAttribute(hConsole, LIGHTCYAN);
+				default:
 					break;
+				}
+			}
+
+			fprintf(output, "%s%s ----> %s%s\n", color, timeString, message.c_str(), *color != '\0' ? ANSI_RESET : "");
+		}
+
+		void Write()
+		{
+			Log_level level;
+			chrono::system_clock::time_point time;
+			string message;
+
+			while (true)
+			{
+				bool written = false;
+				while (this->Dequeue(level, time, message))
+				{
+					this->Print(level, time, message);
+					written = true;
+				}
+
+				size_t droppedMessages = this->dropped.exchange(0, memory_order_relaxed);
+				if (droppedMessages > 0)
+					this->Print(L_ERROR, chrono::system_clock::now(), "Logger: " + std::to_string(droppedMessages) + " messages dropped, the queue was full");
+
+				if (written)
+				{
+					fflush(stdout);
+					fflush(stderr);
+				}
+
+				unique_lock<mutex> guard(this->lock);
+				this->flushed.notify_all();
+				if (this->stopping && !this->IsReady())
+					return;
+
+				// the producers only notify a sleeping writer, the queue is checked again after the flag is set
+				this->writerSleeping.store(true, memory_order_seq_cst);
+				this->wake.wait(guard, [this] { return this->stopping || this->IsReady() || this->dropped.load(memory_order_relaxed) > 0; });
+				this->writerSleeping.store(false, memory_order_relaxed);
 			}
-	
-		fprintf(output, "%s ----> %s", str, std::data(message +"\n" ));
-		SetConsoleTextAttribute(hConsole, WHITE);
-	
+		}
+	};
+
+	LogBackend &GetBackend()
+	{
+		static LogBackend backend;
+		return backend;
 	}
 }
 
+void Logger::printLog(const Log_level level, const std::string & message)
+{
+	if (isEnabled(level))
+		GetBackend().Enqueue(level, string(message));
+}
+
+void Logger::printLog(const Log_level level, std::string && message)
+{
+	if (isEnabled(level))
+		GetBackend().Enqueue(level, move(message));
+}
+
+void Logger::flush()
+{
+	GetBackend().Flush();
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <string>
+#include <atomic>
 
 enum Log_level
 {
@@ -12,11 +13,34 @@ enum Log_level
 	L_DEBUG,
 };
 
+//	The most verbose level which is compiled in, the MMI_LOG calls of more verbose levels are removed by the compiler
+#ifndef MMI_LOG_LEVEL
+#define MMI_LOG_LEVEL L_DEBUG
+#endif
+
+//	Logs the message if the level is enabled, the message is not evaluated otherwise
+#define MMI_LOG(level, message) do { if (Logger::isEnabled(level)) Logger::printLog(level, message); } while (false)
+
 
 class Logger
 {
+	/*
+		The messages are written asynchronously: printLog only puts the message into a lock free queue,
+		a background thread formats the messages (time stamp, ANSI colors) and writes them to stdout / stderr.
+		If the queue is full the message is dropped, the number of dropped messages is logged afterwards.
+	*/
 public:
-	static Log_level logLevel;
+	static std::atomic<Log_level> logLevel;
+
+	//	Returns whether messages of the level are logged
+	static inline bool isEnabled(const Log_level level)
+	{
+		return level <= MMI_LOG_LEVEL && level <= logLevel.load(std::memory_order_relaxed);
+	}
+
 	static void printLog(const Log_level level, const std::string & message);
-};
+	static void printLog(const Log_level level, std::string && message);
 
+	//	Blocks until the queued messages are written
+	static void flush();
+};
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include <thrift/transport/TBufferTransports.h>
+#include <thrift/protocol/TJSONProtocol.h>
+#include <cstdint>
+#include <string>
+#include <memory>
+
+using namespace apache::thrift::transport;
+using namespace apache::thrift::protocol;
+using namespace std;
+
+namespace MMIStandard {
+	class ThriftSerialization
+	{
+		/*
+			Serialization of thrift types into strings, e.g. to pass them through the string parameters of ExecuteFunction.
+			The thrift JSON protocol is used, it is text safe and available in the thrift libraries of all languages.
+		*/
+	public:
+		ThriftSerialization() = delete;
+
+		//	Returns the value serialized with the thrift JSON protocol
+		template<typename T>
+		static string ToJson(const T &value)
+		{
+			shared_ptr<TMemoryBuffer> buffer = make_shared<TMemoryBuffer>();
+			TJSONProtocol protocol(buffer);
+			value.write(&protocol);
+			return buffer->getBufferAsString();
+		}
+
+		//	Reads a value serialized with the thrift JSON protocol, throws a thrift exception if the data is invalid
+		template<typename T>
+		static void FromJson(T &_return, const string &data)
+		{
+			// the buffer only observes the data, it is not modified while reading
+			shared_ptr<TMemoryBuffer> buffer = make_shared<TMemoryBuffer>(reinterpret_cast<uint8_t*>(const_cast<char*>(data.data())), static_cast<uint32_t>(data.size()));
+			TJSONProtocol protocol(buffer);
+			_return.read(&protocol);
+		}
+	};
+}
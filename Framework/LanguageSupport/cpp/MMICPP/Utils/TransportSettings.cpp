@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#include "TransportSettings.h"
+#include <thrift/transport/TBufferTransports.h>
+#include <thrift/protocol/TCompactProtocol.h>
+#include <thrift/protocol/TBinaryProtocol.h>
+#include <thrift/protocol/THeaderProtocol.h>
+#include <thrift/protocol/TProtocolTypes.h>
+
+using namespace MMIStandard;
+
+const string TransportSettings::TransportProperty = "Transport";
+const string TransportSettings::ProtocolProperty = "Protocol";
+
+bool TransportSettings::ParseTransport(Transport_type & _return, const string & name)
+{
+	if (name == "buffered")
+		_return = T_BUFFERED;
+	else if (name == "framed")
+		_return = T_FRAMED;
+	else if (name == "header")
+		_return = T_HEADER;
+	else
+		return false;
+	return true;
+}
+
+bool TransportSettings::ParseProtocol(Protocol_type & _return, const string & name)
+{
+	if (name == "compact")
+		_return = P_COMPACT;
+	else if (name == "binary")
+		_return = P_BINARY;
+	else
+		return false;
+	return true;
+}
+
+string TransportSettings::ToString(Transport_type transport)
+{
+	switch (transport)
+	{
+	case T_FRAMED: return "framed";
+	case T_HEADER: return "header";
+	default: return "buffered";
+	}
+}
+
+string TransportSettings::ToString(Protocol_type protocol)
+{
+	return protocol == P_BINARY ? "binary" : "compact";
+}
+
+void TransportSettings::WriteProperties(map<string, string>& properties) const
+{
+	properties[TransportProperty] = ToString(this->transport);
+	properties[ProtocolProperty] = ToString(this->protocol);
+}
+
+TransportSettings TransportSettings::ReadProperties(const map<string, string>& properties)
+{
+	TransportSettings settings;
+	auto it = properties.find(TransportProperty);
+	if (it != properties.end())
+		ParseTransport(settings.transport, it->second);
+
+	it = properties.find(ProtocolProperty);
+	if (it != properties.end())
+		ParseProtocol(settings.protocol, it->second);
+	return settings;
+}
+
+shared_ptr<TTransport> TransportSettings::CreateTransport(const shared_ptr<TTransport>& socket) const
+{
+	switch (this->transport)
+	{
+	case T_FRAMED:
+		return make_shared<TFramedTransport>(socket);
+	case T_HEADER:
+		// the header protocol adds the header transport itself
+		return socket;
+	default:
+		return make_shared<TBufferedTransport>(socket);
+	}
+}
+
+shared_ptr<TProtocol> TransportSettings::CreateProtocol(const shared_ptr<TTransport>& transport) const
+{
+	if (this->transport == T_HEADER)
+		return make_shared<THeaderProtocol>(transport, this->protocol == P_BINARY ? T_BINARY_PROTOCOL : T_COMPACT_PROTOCOL);
+
+	if (this->protocol == P_BINARY)
+		return make_shared<TBinaryProtocol>(transport);
+	return make_shared<TCompactProtocol>(transport);
+}
+
+shared_ptr<TTransportFactory> TransportSettings::CreateTransportFactory() const
+{
+	switch (this->transport)
+	{
+	case T_FRAMED:
+		return make_shared<TFramedTransportFactory>();
+	case T_HEADER:
+		// the header protocol adds the header transport itself
+		return make_shared<TTransportFactory>();
+	default:
+		return make_shared<TBufferedTransportFactory>();
+	}
+}
+
+shared_ptr<TProtocolFactory> TransportSettings::CreateProtocolFactory() const
+{
+	// the header protocol answers with the protocol the client has used
+	if (this->transport == T_HEADER)
+		return make_shared<THeaderProtocolFactory>();
+
+	if (this->protocol == P_BINARY)
+		return make_shared<TBinaryProtocolFactory>();
+	return make_shared<TCompactProtocolFactory>();
+}
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: MIT
+// The content of this file has been developed in the context of the MOSIM research project.
+// Original author(s): Andreas Kaiser, Niclas Delfs, Stephan Adam
+
+#pragma once
+#include <thrift/transport/TTransport.h>
+#include <thrift/protocol/TProtocol.h>
+#include <string>
+#include <map>
+#include <memory>
+
+using namespace apache::thrift::transport;
+using namespace apache::thrift::protocol;
+using namespace std;
+
+namespace MMIStandard {
+
+	//	The thrift transports which can be used by the servers and clients
+	enum Transport_type
+	{
+		T_BUFFERED,
+		T_FRAMED,
+		T_HEADER,
+	};
+
+	//	The thrift protocols which can be used by the servers and clients
+	enum Protocol_type
+	{
+		P_COMPACT,
+		P_BINARY,
+	};
+
+	struct TransportSettings
+	{
+		/*
+			Transport and protocol of a thrift connection, server and client have to use the same settings.
+			A server advertises its settings in the properties of its description (see WriteProperties),
+			a client reads them from the description of the server it connects to (see ReadProperties).
+			The defaults (buffered, compact) are used by all MOSIM components which do not advertise their settings.
+		*/
+
+		//	The keys of the settings in the properties of MAdapterDescription / MServiceDescription
+		static const string TransportProperty;
+		static const string ProtocolProperty;
+
+		//	The transport which wraps the socket
+		Transport_type transport = T_BUFFERED;
+
+		//	The protocol which serializes the calls
+		Protocol_type protocol = P_COMPACT;
+
+		//	Parses the names "buffered", "framed", "header" / "compact", "binary", returns false if the name is unknown
+		static bool ParseTransport(Transport_type &_return, const string &name);
+		static bool ParseProtocol(Protocol_type &_return, const string &name);
+
+		//	Returns the names of the transport / protocol
+		static string ToString(Transport_type transport);
+		static string ToString(Protocol_type protocol);
+
+		//	Writes the settings into the properties of a description
+		void WriteProperties(map<string, string> &properties) const;
+
+		//	Returns the settings advertised in the properties, unknown or missing values keep the defaults
+		static TransportSettings ReadProperties(const map<string, string> &properties);
+
+		//	Wraps the socket into the transport of the settings, the returned transport is opened and closed by the client
+		shared_ptr<TTransport> CreateTransport(const shared_ptr<TTransport> &socket) const;
+
+		//	Creates the protocol on top of a transport returned by CreateTransport
+		shared_ptr<TProtocol> CreateProtocol(const shared_ptr<TTransport> &transport) const;
+
+		//	Returns the factories which are used by a server
+		shared_ptr<TTransportFactory> CreateTransportFactory() const;
+		shared_ptr<TProtocolFactory> CreateProtocolFactory() const;
+	};
+}